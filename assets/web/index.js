@@ -14,41 +14,38 @@ $('body').on('contextmenu', rightClick)
 // 注册内容改变事件
 $('#summernote').on('summernote.change', changeContent);
 
-// 初始化渲染模板
-var h5Tpl = `
-    <div class="li voiceBox" contenteditable="false" jsonKey="{{jsonValue}}">
-        <div class='voiceInfoBox'>
-            <div class="demo" >              
-                <div class="voicebtn play"></div>
-                <div class="lf">
-                    <div class="title">{{title}}</div>
-                    <div class="minute padtop">{{createTime}}</div>
-                </div>
-                <div class="lr">
-                    <div class="icon">
-                        <div class="wifi-symbol">
-                            <div class="wifi-circle"></div>
-                        </div>
-                    </div>
-                    <div class="time padtop">{{transSize}}</div>
-                </div>
-            </div>
-            <div class="translate">
-            </div>
-        </div>
-    </div>
-    {{#if text}}
-    <p>{{text}}</p>
-    {{/if}}
-    `;
+// 语音块模板，预编译为函数，不在运行时编译模板
+var htmlEscapes = {
+    '&': '&amp;',
+    '<': '&lt;',
+    '>': '&gt;',
+    '"': '&quot;',
+    "'": '&#x27;',
+    '`': '&#x60;',
+    '=': '&#x3D;'
+};
+
+/**
+ * 转义html特殊字符
+ * @param {any} value 内容
+ * @returns {string} 转义后的内容
+ */
+function escapeHtml(value) {
+    if (value === undefined || value === null) {
+        return '';
+    }
+    return String(value).replace(/[&<>"'`=]/g, c => htmlEscapes[c]);
+}
+
 // 语音插入模板
-var nodeTpl = `
+function nodeTpl(json) {
+    return `
         <div class='voiceInfoBox'>
             <div class="demo"  >
                 <div class="voicebtn play"></div>
                 <div class="lf">
-                    <div class="title">{{title}}</div>
-                    <div class="minute padtop">{{createTime}}</div>
+                    <div class="title">${escapeHtml(json.title)}</div>
+                    <div class="minute padtop">${escapeHtml(json.createTime)}</div>
                 </div>
                 <div class="lr">
                     <div class="icon">
@@ -56,12 +53,26 @@ var nodeTpl = `
                             <div class="wifi-circle"></div>
                         </div>
                     </div>
-                    <div class="time padtop">{{transSize}}</div>
+                    <div class="time padtop">${escapeHtml(json.transSize)}</div>
                 </div>
             </div>
             <div class="translate">
             </div>
         </div>`;
+}
+
+// 初始化渲染模板
+function h5Tpl(json) {
+    var html = `
+    <div class="li voiceBox" contenteditable="false" jsonKey="${escapeHtml(json.jsonValue)}">${nodeTpl(json)}
+    </div>
+    `;
+    if (json.text) {
+        html += `<p>${escapeHtml(json.text)}</p>
+    `;
+    }
+    return html;
+}
 
 var formatHtml = ''
 var webobj;    //js与qt通信对象
@@ -133,16 +144,25 @@ new QWebChannel(qt.webChannelTransport,
         //例如 webobj.c++fun.connect(jsfun)
         webobj.callJsInitData.connect(initData);
         webobj.callJsInsertVoice.connect(insertVoiceItem);
+        webobj.callJsAppendVoice.connect(appendVoiceItem);
         webobj.callJsSetPlayStatus.connect(toggleState);
+        webobj.callJsSetActiveVoice.connect(setActiveVoice);
+        webobj.callJsSetVoiceTextByPath.connect(setVoiceTextByPath);
         webobj.callJsSetHtml.connect(setHtml);
         webobj.callJsSetVoiceText.connect(setVoiceText);
-        webobj.callJsInsertImages.connect(insertImg);
+        webobj.callJsInsertImagePlaceholders.connect(insertImagePlaceholders);
+        webobj.callJsReplaceImage.connect(replacePendingImage);
         webobj.callJsSetTheme.connect(changeColor);
         webobj.calllJsShowEditToolbar.connect(showRightMenu);
         webobj.callJsHideEditToolbar.connect(hideRightMenu);
         webobj.callJsClipboardDataChanged.connect(shearPlateChange);
         webobj.callJsSetVoicePlayBtnEnable.connect(playButColor);
         webobj.callJsSetFontList.connect(setFontList);
+        webobj.callJsSearchText.connect(searchText);
+        webobj.callJsSearchNext.connect(searchNext);
+        webobj.callJsClearSearch.connect(clearSearch);
+        webobj.callJsSwitchNote.connect(switchNote);
+        webobj.callJsPreloadNote.connect(preloadNote);
         //通知QT层完成通信绑定
         webobj.jsCallChannleFinish();
         // setFontList(global_fontList, "Unifont")
@@ -154,6 +174,7 @@ function setFontList(fontList, initFont) {
     global_fontList = fontList;
     setInitFont(initFont)
     initSummernote()
+    reportImageWidth()
     // 通知QT，summernote初始化完成
     webobj.jsCallSummernoteInitFinish()
     // 获取翻译和字体列表后，再初始化summernote
@@ -232,6 +253,7 @@ function changeContent(we, contents, $editable) {
  */
 window.onresize = function(){
     updateAirPopoverPos()
+    reportImageWidth()
 }
 
 /**
@@ -469,7 +491,7 @@ function isRangeVoice() {
         && childrenLength == 1
         && $(testDiv).find('img').parent()[0].childNodes.length == 1) {
         selectedRange.flag = 0
-        selectedRange.info = $(testDiv).find('img').attr('src')
+        selectedRange.info = imageSource($(testDiv).find('img')[0])
     } else {
         selectedRange.flag = 2
     }
@@ -492,17 +514,446 @@ $('body').on('click', '.voicebtn', function (e) {
     });
 })
 
-//获取整个处理后Html串,去除所有标签中临时状态
-function getHtml() {
-    var $cloneCode = $('.note-editable').clone();
+//图片懒加载，只加载视口附近的图片，按显示宽度从缩略图协议获取，远离视口的图片释放
+//原图路径保存在data-src中，获取内容时还原
+const imagePlaceholder = 'data:image/gif;base64,R0lGODlhAQABAIAAAAAAAP///yH5BAEAAAAALAAAAAABAAEAAAIBRAA7';
+const imageWidthStep = 256;  //缩略图宽度取整步长，提高缩略图缓存命中率
+var loadedImages = new WeakSet();  //已加载的图片
+var imageLoader = null;  //进入视口附近时加载
+var imageReleaser = null;  //远离视口时释放
+var lazyImageTimer = null;  //新增节点后延后处理懒加载
+var pendingImageIds = new Set();  //后台处理中的图片占位id
+
+/**
+ * html中的图片改为占位图，避免设置内容时解码所有原图
+ * @param {string} html 笔记内容
+ * @returns {string} 处理后的内容
+ */
+function lazyImageHtml(html) {
+    return html.replace(/(<img\b[^>]*?\s)src="([^"]*)"/gi, function (match, head, src) {
+        if (src.indexOf('data:') == 0) {
+            return match;
+        }
+        return head + 'src="' + imagePlaceholder + '" data-src="' + src + '"';
+    });
+}
+
+/**
+ * 获取图片原图路径
+ * @param {Element} img 图片节点
+ * @returns {string} 原图路径
+ */
+function imageSource(img) {
+    return $(img).attr('data-src') || $(img).attr('src');
+}
+
+/**
+ * 还原图片原图路径，去除懒加载的临时状态
+ * @param {jQuery} $code 节点容器
+ */
+function restoreLazyImages($code) {
+    $code.find('img[data-src]').each(function () {
+        $(this).attr('src', $(this).attr('data-src')).removeAttr('data-src').css('min-height', '');
+        if (!$(this).attr('style')) {
+            $(this).removeAttr('style');
+        }
+    })
+}
+
+/**
+ * 按显示宽度计算缩略图宽度
+ * @param {number} displayWidth 显示宽度
+ * @returns {number} 缩略图宽度
+ */
+function imageThumbnailWidth(displayWidth) {
+    return Math.ceil(Math.max(displayWidth, 1) * window.devicePixelRatio / imageWidthStep) * imageWidthStep;
+}
+
+/**
+ * 通知后端编辑区图片的缩略图宽度，插入图片时后台预先生成缩略图
+ */
+function reportImageWidth() {
+    if (webobj && $('.note-editable').length) {
+        webobj.jsCallSetImageWidth(imageThumbnailWidth($('.note-editable').width()));
+    }
+}
+
+/**
+ * 插入图片占位，图片在后台处理完成后由replacePendingImage替换
+ * @param {Array} ids 占位id
+ */
+function insertImagePlaceholders(ids) {
+    ids.forEach(id => {
+        pendingImageIds.add(id);
+        $("#summernote").summernote('insertImage', imagePlaceholder, function ($image) {
+            $image.attr('data-pending', id);
+        });
+    })
+}
+
+/**
+ * 后台处理完成，占位替换为图片
+ * @param {string} id 占位id
+ * @param {string} path 图片路径，处理失败时为空
+ * @param {string} originalPath 重新编码前的原图路径，未保存原图时为空
+ */
+function replacePendingImage(id, path, originalPath) {
+    pendingImageIds.delete(id);
+    var $img = $('.note-editable img[data-pending="' + id + '"]');
+    if (!$img.length) {
+        replacePoolPendingImage(id, path, originalPath);
+        return;
+    }
+    if (!path) {
+        $img.remove();
+        changeContent();
+        return;
+    }
+    $img.one('load', function () {
+        //与直接插入图片一致，宽度不超过编辑区
+        if (!this.style.width) {
+            $(this).css('width', Math.min($('.note-editable').width(), this.naturalWidth));
+            changeContent();
+        }
+    });
+    $img.removeAttr('data-pending').attr('data-src', path);
+    if (originalPath) {
+        $img.attr('data-original', originalPath);
+    }
+    loadedImages.delete($img[0]);
+    initLazyImages();
+    changeContent();
+}
+
+/**
+ * 插入图片后已切换笔记，替换缓存池中的占位，并通知后端保存该笔记
+ * @param {string} id 占位id
+ * @param {string} path 图片路径，处理失败时为空
+ * @param {string} originalPath 重新编码前的原图路径，未保存原图时为空
+ */
+function replacePoolPendingImage(id, path, originalPath) {
+    var $img = $('#pagePool img[data-pending="' + id + '"]');
+    var container = $img.closest('.pagePoolItem')[0];
+    if (!container) {
+        return;
+    }
+    if (path) {
+        $img.removeAttr('data-pending').attr('data-src', path);
+        if (originalPath) {
+            $img.attr('data-original', originalPath);
+        }
+    } else {
+        $img.remove();
+    }
+    pagePool.forEach((entry, noteId) => {
+        if (entry.container == container) {
+            webobj.jsCallPoolPageChanged(noteId, cleanHtml(container));
+        }
+    })
+}
+
+/**
+ * 移除已失效的图片占位，上次退出时未处理完成的占位不再替换
+ * @param {jQuery} $code 节点容器
+ */
+function removeStalePlaceholders($code) {
+    $code.find('img[data-pending]').filter(function () {
+        return !pendingImageIds.has(this.getAttribute('data-pending'));
+    }).remove();
+}
+
+/**
+ * 加载图片缩略图
+ * @param {Element} img 图片节点
+ */
+function loadImage(img) {
+    var src = img.getAttribute('data-src');
+    if (!src || loadedImages.has(img)) {
+        return;
+    }
+    var displayWidth = img.style.width ? img.clientWidth : $('.note-editable').width();
+    var width = imageThumbnailWidth(displayWidth);
+    img.onload = function () {
+        img.style.minHeight = '';
+    };
+    img.onerror = function () {
+        //缩略图获取失败时使用原图
+        img.onerror = null;
+        img.src = src;
+    };
+    img.src = 'vnthumb:' + encodeURI(src) + '?w=' + width;
+    loadedImages.add(img);
+}
+
+/**
+ * 释放图片，保留当前高度避免页面跳动
+ * @param {Element} img 图片节点
+ */
+function releaseImage(img) {
+    if (!loadedImages.has(img)) {
+        return;
+    }
+    if (img.offsetHeight > 0) {
+        img.style.minHeight = img.offsetHeight + 'px';
+    }
+    img.onload = null;
+    img.onerror = null;
+    img.src = imagePlaceholder;
+    loadedImages.delete(img);
+}
+
+/**
+ * 编辑区中的图片开始懒加载，设置内容、插入图片后调用
+ */
+function initLazyImages() {
+    initBlockObserver();
+    if (!imageLoader) {
+        imageLoader = new IntersectionObserver(entries => {
+            entries.forEach(entry => {
+                if (entry.isIntersecting) {
+                    loadImage(entry.target);
+                }
+            })
+        }, { rootMargin: '1000px 0px' });
+        imageReleaser = new IntersectionObserver(entries => {
+            entries.forEach(entry => {
+                if (!entry.isIntersecting) {
+                    releaseImage(entry.target);
+                }
+            })
+        }, { rootMargin: '4000px 0px' });
+    }
+    $('.note-editable img').each(function () {
+        //新插入的图片
+        if (!this.getAttribute('data-src')) {
+            var src = this.getAttribute('src');
+            if (!src || src.indexOf('data:') == 0) {
+                return;
+            }
+            this.setAttribute('data-src', src);
+            loadedImages.delete(this);
+            loadImage(this);
+        }
+        imageLoader.observe(this);
+        imageReleaser.observe(this);
+    })
+}
+
+/**
+ * 去除播放、选中、转写、搜索等界面状态，图片懒加载状态保留
+ * @param {jQuery} $cloneCode 节点容器
+ */
+function cleanUiState($cloneCode) {
     $cloneCode.find('.li').removeClass('active');
     $cloneCode.find('.voicebtn').removeClass('pause').addClass('play');
     $cloneCode.find('.voicebtn').removeClass('now');
     $cloneCode.find('.wifi-circle').removeClass('first').removeClass('second').removeClass('third').removeClass('four').removeClass('fifth').removeClass('sixth').removeClass('seventh');
     $cloneCode.find('.translate').html("")
+    $cloneCode.find('.searchHit').contents().unwrap();
+}
+
+/**
+ * 去除克隆节点中所有标签的临时状态，用于生成保存的html
+ * @param {jQuery} $cloneCode 克隆的节点容器
+ */
+function cleanTempState($cloneCode) {
+    cleanUiState($cloneCode);
+    //后台处理中的图片保留占位，处理完成后替换，切换笔记、退出时不会丢失
+    removeStalePlaceholders($cloneCode);
+    restoreLazyImages($cloneCode);
+}
+
+/**
+ * 获取节点内容去除临时状态后的html
+ * @param {Element} node 节点容器
+ * @returns {string} html
+ */
+function cleanHtml(node) {
+    var $cloneCode = $(node).clone();
+    cleanTempState($cloneCode);
     return $cloneCode[0].innerHTML;
 }
 
+//获取整个处理后Html串,去除所有标签中临时状态
+function getHtml() {
+    return cleanHtml($('.note-editable')[0]);
+}
+
+//增量保存，按编辑区顶层块比较，只返回变化的块
+var syncedBlocks = null;  //已同步给后端的顶层块，为null时下次返回全量
+var syncVersion = 0;  //已同步的版本号
+var blockCache = new WeakMap();  //顶层节点 -> 去除临时状态后的html
+var blockObserver = null;  //编辑区变化监听，节点变化时清除其所在顶层块的缓存
+
+/**
+ * 监听编辑区变化，使顶层块缓存失效
+ */
+function initBlockObserver() {
+    var editable = $('.note-editable')[0];
+    if (blockObserver || !editable) {
+        return;
+    }
+    blockObserver = new MutationObserver(mutations => {
+        var hasNewNodes = false;
+        mutations.forEach(mutation => {
+            if (mutation.addedNodes.length) {
+                hasNewNodes = true;
+            }
+            var node = mutation.target;
+            while (node && node.parentNode != editable) {
+                node = node.parentNode;
+            }
+            if (node) {
+                blockCache.delete(node);
+            }
+        })
+        //插入、粘贴的图片延后加入懒加载
+        if (hasNewNodes && !lazyImageTimer) {
+            lazyImageTimer = setTimeout(() => {
+                lazyImageTimer = null;
+                initLazyImages();
+            }, 0);
+        }
+    });
+    blockObserver.observe(editable, { childList: true, subtree: true, characterData: true, attributes: true });
+}
+
+/**
+ * 获取顶层块去除临时状态后的html
+ * @param {Node} node 顶层节点
+ * @returns {string} html
+ */
+function getBlockHtml(node) {
+    var html = blockCache.get(node);
+    if (html === undefined) {
+        var $wrap = $('<div></div>').append($(node).clone());
+        cleanTempState($wrap);
+        html = $wrap[0].innerHTML;
+        blockCache.set(node, html);
+    }
+    return html;
+}
+
+/**
+ * 获取编辑区相对上次同步的增量，所有块拼接后与getHtml()结果一致
+ * @param {number} version 后端当前的版本号，与前端不一致时返回全量
+ * @returns {string} json: {version, reset, start, remove, blocks}
+ */
+function getDelta(version) {
+    initBlockObserver();
+    var blocks = [];
+    $('.note-editable')[0].childNodes.forEach(node => {
+        blocks.push(getBlockHtml(node));
+    })
+
+    var delta = { version: syncVersion + 1, reset: false, start: 0, remove: 0, blocks: [] };
+    if (syncedBlocks == null || version != syncVersion) {
+        delta.reset = true;
+        delta.blocks = blocks;
+    } else {
+        //去掉首尾相同的块，剩余部分即为变化范围
+        var start = 0;
+        var oldEnd = syncedBlocks.length;
+        var newEnd = blocks.length;
+        while (start < oldEnd && start < newEnd && syncedBlocks[start] == blocks[start]) {
+            start++;
+        }
+        while (oldEnd > start && newEnd > start && syncedBlocks[oldEnd - 1] == blocks[newEnd - 1]) {
+            oldEnd--;
+            newEnd--;
+        }
+        delta.start = start;
+        delta.remove = oldEnd - start;
+        delta.blocks = blocks.slice(start, newEnd);
+    }
+    syncedBlocks = blocks;
+    syncVersion = delta.version;
+    return JSON.stringify(delta);
+}
+
+//搜索高亮，只包裹命中的文本节点，不重新设置内容，getHtml时去除
+var searchHits = [];  //当前高亮的节点
+var searchIndex = -1;  //当前定位的高亮序号
+
+/**
+ * 高亮所有匹配关键字的文本，并定位到第一个
+ * @param {string} keyword 搜索关键字，不区分大小写
+ * @returns {number} 匹配数量，同时通过jsCallSearchFinish通知后端
+ */
+function searchText(keyword) {
+    clearSearch();
+    if (keyword) {
+        var lowerKey = keyword.toLowerCase();
+        var textNodes = [];
+        var walker = document.createTreeWalker($('.note-editable')[0], NodeFilter.SHOW_TEXT, null, false);
+        while (walker.nextNode()) {
+            if (walker.currentNode.nodeValue.toLowerCase().indexOf(lowerKey) != -1) {
+                textNodes.push(walker.currentNode);
+            }
+        }
+        textNodes.forEach(node => {
+            //从后往前拆分，保证前面的偏移不变
+            var offsets = [];
+            var lowerText = node.nodeValue.toLowerCase();
+            var pos = lowerText.indexOf(lowerKey);
+            while (pos != -1) {
+                offsets.push(pos);
+                pos = lowerText.indexOf(lowerKey, pos + lowerKey.length);
+            }
+            var hits = [];
+            for (var i = offsets.length - 1; i >= 0; i--) {
+                var hitNode = node.splitText(offsets[i]);
+                hitNode.splitText(keyword.length);
+                var span = document.createElement('span');
+                span.className = 'searchHit';
+                hitNode.parentNode.replaceChild(span, hitNode);
+                span.appendChild(hitNode);
+                hits.unshift(span);
+            }
+            searchHits = searchHits.concat(hits);
+        })
+        searchNext(true);
+    }
+    webobj.jsCallSearchFinish(searchHits.length);
+    return searchHits.length;
+}
+
+/**
+ * 定位到下一个或上一个高亮
+ * @param {boolean} forward true下一个 false上一个
+ * @returns {number} 当前定位的序号
+ */
+function searchNext(forward) {
+    if (searchHits.length == 0) {
+        return -1;
+    }
+    $(searchHits[searchIndex]).removeClass('current');
+    if (forward) {
+        searchIndex = (searchIndex + 1) % searchHits.length;
+    } else {
+        searchIndex = (searchIndex - 1 + searchHits.length) % searchHits.length;
+    }
+    $(searchHits[searchIndex]).addClass('current');
+    searchHits[searchIndex].scrollIntoView({ block: 'center' });
+    return searchIndex;
+}
+
+//清除搜索高亮
+function clearSearch() {
+    searchHits.forEach(span => {
+        var parent = span.parentNode;
+        if (parent) {
+            while (span.firstChild) {
+                parent.insertBefore(span.firstChild, span);
+            }
+            parent.removeChild(span);
+            parent.normalize();
+        }
+    })
+    searchHits = [];
+    searchIndex = -1;
+}
+
 //获取当前所有的语音列表
 function getAllNote() {
     var jsonObj = {};
@@ -599,6 +1050,8 @@ function initData(text) {
         }
     })
 
+    clearSearch();
+    syncedBlocks = null;
     $('#summernote').summernote('code', html);
     // 搜索功能
     webobj.jsCallSetDataFinsh();
@@ -647,6 +1100,24 @@ function insertVoiceItem(text) {
     setFocusScroll()
 }
 
+/**
+ * 在笔记末尾插入语音，用于恢复异常退出时的录音
+ * @date 2026-10-19
+ * @param {string} text 语音json
+ * @returns {any}
+ */
+function appendVoiceItem(text) {
+    $('#summernote').summernote('editor.focus')
+    // 光标移到编辑区末尾后按正常插入处理，保留撤销记录
+    var range = document.createRange();
+    range.selectNodeContents($('.note-editable')[0]);
+    range.collapse(false);
+    var selection = window.getSelection();
+    selection.removeAllRanges();
+    selection.addRange(range);
+    insertVoiceItem(text)
+}
+
 /**
  * 移除无内容p标签
  * @date 2021-08-19
@@ -693,6 +1164,68 @@ function toggleState(state) {
     }
 }
 
+/**
+ * 按语音文件路径查找语音块
+ * @date 2026-10-19
+ * @param {string} voicePath 语音文件路径
+ * @returns {any} 语音块，未找到时为null
+ */
+function findVoiceBox(voicePath) {
+    var voiceBox = null;
+    $('.li[jsonKey]').each(function () {
+        var jsonObj = null;
+        try {
+            jsonObj = JSON.parse($(this).attr('jsonKey'));
+        } catch (e) {
+            return true;
+        }
+        if (jsonObj.voicePath == voicePath) {
+            voiceBox = $(this);
+            return false;
+        }
+    });
+    return voiceBox;
+}
+
+/**
+ * 设置当前播放的语音，连续播放切换语音时调用
+ * @date 2026-10-19
+ * @param {string} voicePath 语音文件路径
+ * @returns {any}
+ */
+function setActiveVoice(voicePath) {
+    var voiceBox = findVoiceBox(voicePath);
+    if (voiceBox) {
+        $('.voicebtn').removeClass('now');
+        activeVoice = voiceBox.find('.voicebtn');
+        activeVoice.addClass('now');
+    }
+}
+
+/**
+ * 批量转写完成后设置语音的转写文本，与单个语音转写完成的处理一致
+ * @date 2026-10-19
+ * @param {string} voicePath 语音文件路径
+ * @param {string} text 转写文本
+ * @returns {any}
+ */
+function setVoiceTextByPath(voicePath, text) {
+    var voiceBox = findVoiceBox(voicePath);
+    if (!voiceBox || !text || !text.trim()) {
+        return;
+    }
+    var jsonObj = JSON.parse(voiceBox.attr('jsonKey'));
+    // 已有转写文本时不重复插入
+    if (jsonObj.text) {
+        return;
+    }
+    text = text.trim();
+    voiceBox.after($('<p></p>').text(text));
+    jsonObj.text = text;
+    voiceBox.attr('jsonKey', JSON.stringify(jsonObj));
+    webobj.jsCallTxtChange();
+}
+
 /**
  * 设置整个html内容
  * @date 2021-08-19
@@ -704,7 +1237,11 @@ function setHtml(html) {
         html = '<p><br></p>'
     }
     initFinish = false;
-    $('#summernote').summernote('code', html);
+    clearSearch();
+    syncedBlocks = null;
+    $('#summernote').summernote('code', lazyImageHtml(html));
+    removeStalePlaceholders($('.note-editable'));
+    initLazyImages();
     initFinish = true;
     // 搜索功能
     webobj.jsCallSetDataFinsh();
@@ -712,6 +1249,99 @@ function setHtml(html) {
     $('#summernote').summernote('editor.resetRecord')
 }
 
+//笔记页面缓存池，最近及相邻笔记的内容预先在隐藏容器中生成，切换笔记时直接移动节点，不重新解析html
+const pagePoolSize = 6;  //缓存的笔记数量
+var pagePool = new Map();  //笔记id -> {rev, container}，按使用顺序排列，第一个为最久未使用
+
+/**
+ * 加入缓存池，超出数量时移除最久未使用的笔记
+ * @param {number} noteId 笔记id
+ * @param {string} rev 内容版本，与后端笔记内容对应
+ * @param {Element} container 笔记内容容器
+ */
+function putPoolPage(noteId, rev, container) {
+    var entry = pagePool.get(noteId);
+    if (entry && entry.container != container) {
+        $(entry.container).remove();
+    }
+    pagePool.delete(noteId);
+    pagePool.set(noteId, { rev: rev, container: container });
+    while (pagePool.size > pagePoolSize) {
+        var oldestId = pagePool.keys().next().value;
+        $(pagePool.get(oldestId).container).remove();
+        pagePool.delete(oldestId);
+    }
+}
+
+/**
+ * 空闲时在隐藏容器中预加载笔记内容，已缓存相同版本时忽略
+ * @param {number} noteId 笔记id
+ * @param {string} rev 内容版本
+ * @param {string} html 笔记内容
+ */
+function preloadNote(noteId, rev, html) {
+    var runIdle = window.requestIdleCallback || function (fn) { return setTimeout(fn, 0) };
+    runIdle(() => {
+        var entry = pagePool.get(noteId);
+        if (entry && entry.rev == rev) {
+            return;
+        }
+        var container = $('<div class="pagePoolItem"></div>').appendTo('#pagePool')[0];
+        container.innerHTML = lazyImageHtml(html);
+        removeStalePlaceholders($(container));
+        putPoolPage(noteId, rev, container);
+    })
+}
+
+/**
+ * 切换笔记，当前笔记内容移入缓存池，目标笔记已缓存时直接换入，否则重新设置html
+ * @param {number} oldId 当前笔记id，小于0时不缓存当前内容
+ * @param {string} oldRev 当前笔记内容版本
+ * @param {number} noteId 目标笔记id
+ * @param {string} rev 目标笔记内容版本
+ * @param {string} html 目标笔记内容，未命中缓存时使用
+ */
+function switchNote(oldId, oldRev, noteId, rev, html) {
+    var editable = $('.note-editable')[0];
+    initFinish = false;
+    clearSearch();
+    if (oldId >= 0) {
+        //缓存的页面保留懒加载状态，只释放已加载的图片，换回时重新按需加载
+        $(editable).find('img').each(function () {
+            releaseImage(this);
+            if (imageLoader) {
+                imageLoader.unobserve(this);
+                imageReleaser.unobserve(this);
+            }
+        })
+        var container = $('<div class="pagePoolItem"></div>').appendTo('#pagePool')[0];
+        while (editable.firstChild) {
+            container.appendChild(editable.firstChild);
+        }
+        cleanUiState($(container));
+        putPoolPage(oldId, oldRev, container);
+    }
+
+    var entry = pagePool.get(noteId);
+    if (!entry || entry.rev != rev) {
+        setHtml(html);
+        return;
+    }
+
+    pagePool.delete(noteId);
+    syncedBlocks = null;
+    $(editable).empty();
+    while (entry.container.firstChild) {
+        editable.appendChild(entry.container.firstChild);
+    }
+    $(entry.container).remove();
+    initLazyImages();
+    initFinish = true;
+    webobj.jsCallSetDataFinsh();
+    resetScroll()
+    $('#summernote').summernote('editor.resetRecord')
+}
+
 //设置录音转文字内容 flag: 0: 转换过程中 提示性文本（＂正在转文字中＂)１:结果 文本,空代表转失败了
 function setVoiceText(text, flag) {
     if (activeTransVoice) {
@@ -753,13 +1383,7 @@ function transHtml(json, flag) {
     //将json内容当其属性与标签绑定
     var strJson = JSON.stringify(json);
     json.jsonValue = strJson;
-    var template;
-    if (flag) {
-        template = Handlebars.compile(nodeTpl);
-    }
-    else {
-        template = Handlebars.compile(h5Tpl);
-    }
+    var template = flag ? nodeTpl : h5Tpl;
     var retHtml = template(json);
     return retHtml;
 }
@@ -939,12 +1563,6 @@ function changeColor(flag, activeColor, disableColor, backgroundColor) {
  * @param {any} urlStr 图片地址list
  * @returns {any}
  */
-async function insertImg(urlStr) {
-    urlStr.forEach((item, index) => {
-        $("#summernote").summernote('insertImage', item, 'img');
-    })
-}
-
 //  
 document.onkeydown = function (event) {
     if (window.event.keyCode == 13) {
@@ -1122,7 +1740,7 @@ document.onkeyup = function (event) {
 $('body').on('dblclick', 'img', function (e) {
     e.stopPropagation()
     e.preventDefault()
-    let imgUrl = $(e.target).attr('src')
+    let imgUrl = imageSource(e.target)
     webobj.jsCallViewPicture(imgUrl)
 })
 
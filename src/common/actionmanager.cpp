@@ -204,7 +204,8 @@ void ActionManager::initMenu()
     QStringList notebookMenuTexts;
     notebookMenuTexts << DApplication::translate("NotebookContextMenu", "Rename")
                       << DApplication::translate("NotebookContextMenu", "Delete")
-                      << DApplication::translate("NotebookContextMenu", "New note");
+                      << DApplication::translate("NotebookContextMenu", "New note")
+                      << DApplication::translate("NotebookContextMenu", "Convert all voices to text");
     //初始化记事本右键菜单
     m_notebookContextMenu.reset(new VNoteRightMenu());
 
@@ -228,7 +229,8 @@ void ActionManager::initMenu()
                   << DApplication::translate("NotesContextMenu", "Delete")
                   << DApplication::translate("NotesContextMenu", "")
                   << DApplication::translate("NotesContextMenu", "Save voice recording")
-                  << DApplication::translate("NotesContextMenu", "New note");
+                  << DApplication::translate("NotesContextMenu", "New note")
+                  << DApplication::translate("NotesContextMenu", "Convert voices to text");
 
     //初始化笔记右键菜单
     m_noteContextMenu.reset(new VNoteRightMenu());
@@ -264,7 +266,8 @@ void ActionManager::initMenu()
                    << DApplication::translate("NoteDetailContextMenu", "Select all")
                    << DApplication::translate("NoteDetailContextMenu", "Copy")
                    << DApplication::translate("NoteDetailContextMenu", "Cut")
-                   << DApplication::translate("NoteDetailContextMenu", "Paste");
+                   << DApplication::translate("NoteDetailContextMenu", "Paste")
+                   << DApplication::translate("NoteDetailContextMenu", "Play all from here");
 
     //初始化语音文本右键菜单
     m_voiceContextMenu.reset(new VNoteRightMenu());
@@ -29,6 +29,7 @@ public:
         NotebookDelete,
         NotebookAddNew,
         //Add notebook menu item begin {
+        NotebookVoiceToText,
 
         //Add notebook menu item end }
         NotebookMenuMax,
@@ -43,6 +44,7 @@ public:
         NoteSaveVoice,
         NoteAddNew,
         //Add note menu item begin {
+        NoteVoiceToText,
 
         //Add note menu item end }
         NoteMenuMax,
@@ -57,6 +59,7 @@ public:
         VoiceCut,
         VoicePaste,
         //Add voice menu item begin {
+        VoicePlayAll,
 
         //Add voice menu item end }
         VoiceMenuMax,
@@ -9,6 +9,7 @@
 #include "common/opsstateinterface.h"
 
 #include <QMap>
+#include <QPair>
 #include <QVector>
 #include <QReadWriteLock>
 #include <QDateTime>
@@ -22,6 +23,7 @@ typedef QMap<qint64, VNoteFolder *> VNOTE_FOLDERS_DATA_MAP;
 typedef QMap<qint64, VNoteItem *> VNOTE_ITEMS_DATA_MAP;
 typedef QMap<qint64, VNOTE_ITEMS_MAP *> VNOTE_ALL_NOTES_DATA_MAP;
 typedef QVector<VNoteBlock *> VNOTE_DATA_VECTOR;
+typedef QVector<QPair<qint64, qint64>> VNOTE_SPEECH_SEGMENTS; //语音段的起止时间，单位毫秒
 
 //记事本数据
 struct VNOTE_FOLDERS_MAP {
@@ -124,6 +126,15 @@ struct VDataSafer {
 
 typedef QVector<VDataSafer> SafetyDatas;
 
+//语音转文字任务，程序退出后仍保留在数据库中，下次启动继续转写
+struct VNoteAsrJob {
+    QString voicePath; //语音文件路径，唯一标识任务
+    qint32 noteId {-1}; //语音所属笔记
+    qint64 duration {0}; //语音时长，单位毫秒
+};
+
+typedef QVector<VNoteAsrJob> VNoteAsrJobs;
+
 enum IconsType {
     DefaultIcon = 0x0,
     DefaultGrayIcon,
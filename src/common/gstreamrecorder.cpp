@@ -4,9 +4,12 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "gstreamrecorder.h"
-#include <DLog>
+#include "vnoterecordsession.h"
+#include "performancemonitor.h"
+#include "task/filesyncworker.h"
 
-static const QString mp3Encoder = "capsfilter caps=audio/x-raw,rate=44100,channels=2 ! lamemp3enc name=enc target=1 cbr=true bitrate=192";
+#include <QThreadPool>
+#include <DLog>
 
 /**
  * @brief bufferProbe
@@ -19,8 +22,55 @@ GstPadProbeReturn bufferProbe(GstPad *pad, GstPadProbeInfo *info, gpointer user_
 {
     Q_UNUSED(pad);
     GstreamRecorder *recorder = static_cast<GstreamRecorder *>(user_data);
-    if (GstBuffer *buffer = gst_pad_probe_info_get_buffer(info))
-        return recorder->doBufferProbe(buffer) ? GST_PAD_PROBE_OK : GST_PAD_PROBE_DROP;
+    GstBuffer *buffer = gst_pad_probe_info_get_buffer(info);
+    if (nullptr == buffer)
+        return GST_PAD_PROBE_OK;
+    if (!recorder->doBufferProbe(buffer))
+        return GST_PAD_PROBE_DROP;
+
+    //录音从0开始计时，去除静音后时间戳前移，编码器和分段按连续的数据处理
+    qint64 offset = recorder->timeOffset();
+    if (offset > 0 && GST_BUFFER_PTS_IS_VALID(buffer)) {
+        buffer = gst_buffer_make_writable(buffer);
+        GST_BUFFER_PTS(buffer) -= qMin(static_cast<GstClockTime>(offset), GST_BUFFER_PTS(buffer));
+        GST_PAD_PROBE_INFO_DATA(info) = buffer;
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief captureProbe
+ * 记录进入预录队列的数据时间
+ * @param pad
+ * @param info
+ * @param user_data 用户数据
+ * @return 处理结果
+ */
+GstPadProbeReturn captureProbe(GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+    Q_UNUSED(pad);
+    GstreamRecorder *recorder = static_cast<GstreamRecorder *>(user_data);
+    GstBuffer *buffer = gst_pad_probe_info_get_buffer(info);
+    if (buffer && GST_BUFFER_PTS_IS_VALID(buffer)) {
+        GstClockTime end = GST_BUFFER_PTS(buffer);
+        if (GST_BUFFER_DURATION_IS_VALID(buffer)) {
+            end += GST_BUFFER_DURATION(buffer);
+        }
+        recorder->setCaptureTime(static_cast<qint64>(end));
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief preRollProbe
+ * 阻塞探针，移除探针前数据停在队列中
+ * @return 处理结果
+ */
+GstPadProbeReturn preRollProbe(GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+    Q_UNUSED(pad);
+    Q_UNUSED(info);
+    Q_UNUSED(user_data);
     return GST_PAD_PROBE_OK;
 }
 
@@ -46,6 +96,17 @@ GstreamRecorder::GstreamRecorder(QObject *parent)
     : QObject(parent)
 {
     gst_init(nullptr, nullptr);
+    m_syncTimer.setInterval(VNoteRecordSession::SegmentDuration * 1000);
+    connect(&m_syncTimer, &QTimer::timeout, this, &GstreamRecorder::syncOutputFile);
+    m_armTimer.setSingleShot(true);
+    m_armTimer.setInterval(ArmTimeout);
+    connect(&m_armTimer, &QTimer::timeout, this, &GstreamRecorder::releaseDevice);
+    m_eosTimer.setSingleShot(true);
+    m_eosTimer.setInterval(EosTimeout);
+    connect(&m_eosTimer, &QTimer::timeout, this, [this] {
+        qWarning() << "wait for eos timeout";
+        onStreamFinished();
+    });
 }
 
 /**
@@ -57,13 +118,14 @@ bool GstreamRecorder::createPipe()
     GstElement *audioSrc = nullptr; //声音采集设备
     GstElement *audioResample = nullptr; //重采样
     GstElement *audioConvert = nullptr; //格式转换
-    GstElement *audioQueue = nullptr; //数据缓存
+    GstElement *audioQueue = nullptr; //数据缓存，预录时只保留最近的数据
     GstElement *audioEncoder = nullptr; //编码器
-    GstElement *audioOutput = nullptr; //输出文件
+    GstElement *audioOutput = nullptr; //按时长分段的输出文件
     //   回音消除与噪声抑制
     //   GstElement *audiowebrtcdsp = nullptr;
     //   GstElement *audiowebrtcechoprobe = nullptr;
 
+    GstPad *pad = nullptr;
     bool success = false;
     do {
         audioSrc = gst_element_factory_make("pulsesrc", "audioSrc");
@@ -102,13 +164,24 @@ bool GstreamRecorder::createPipe()
             qCritical() << "audioQueue make error";
             break;
         }
-        audioEncoder = gst_parse_bin_from_description(mp3Encoder.toLatin1().constData(),
+        //预录时队列出口阻塞，队列满后丢弃最早的数据，队列长度需大于预录时长
+        gst_util_set_object_arg(G_OBJECT(audioQueue), "leaky", "downstream");
+        g_object_set(reinterpret_cast<gpointer *>(audioQueue),
+                     "max-size-time", static_cast<guint64>(PreRollMs * 2) * GST_MSECOND,
+                     "max-size-buffers", 0,
+                     "max-size-bytes", 0, nullptr);
+        pad = gst_element_get_static_pad(audioQueue, "sink");
+        if (pad) {
+            gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, captureProbe, this, nullptr);
+            gst_object_unref(pad);
+        }
+        audioEncoder = gst_parse_bin_from_description(m_profile.pipeline().toLatin1().constData(),
                                                       true, nullptr);
         if (audioEncoder == nullptr) {
             qCritical() << "audioEncoder make error";
             break;
         }
-        GstPad *pad = gst_element_get_static_pad(audioEncoder, "sink");
+        pad = gst_element_get_static_pad(audioEncoder, "sink");
         if (pad) {
             gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, bufferProbe, this, nullptr);
             gst_object_unref(pad);
@@ -116,11 +189,20 @@ bool GstreamRecorder::createPipe()
             qCritical() << "sink pad make error";
             break;
         }
-        audioOutput = gst_element_factory_make("filesink", "filesink");
+        audioOutput = gst_element_factory_make("multifilesink", "filesink");
         if (audioOutput == nullptr) {
             qCritical() << "audioOutput make error";
             break;
         }
+        //分段写满时长后切换到下一个文件，并在总线上通知已完成的分段。
+        //带文件头的封装格式不能拼接，只写一个文件，由定时器同步
+        guint64 maxDuration = m_profile.streamable
+                                  ? static_cast<guint64>(VNoteRecordSession::SegmentDuration) * GST_SECOND
+                                  : GST_CLOCK_TIME_NONE;
+        gst_util_set_object_arg(G_OBJECT(audioOutput), "next-file", "max-duration");
+        g_object_set(reinterpret_cast<gpointer *>(audioOutput),
+                     "max-file-duration", maxDuration,
+                     "post-messages", TRUE, nullptr);
         if (!m_outputFile.isEmpty()) {
             g_object_set(reinterpret_cast<gpointer *>(audioOutput), "location", m_outputFile.toLatin1().constData(), nullptr);
         }
@@ -163,7 +245,15 @@ bool GstreamRecorder::createPipe()
  */
 void GstreamRecorder::deinit()
 {
-    stopRecord();
+    //析构时不再等待数据写完
+    m_syncTimer.stop();
+    m_armTimer.stop();
+    m_eosTimer.stop();
+    m_recording = false;
+    m_eosPending = false;
+    if (m_pipeline) {
+        setStateToNull();
+    }
     objectUnref(m_pipeline);
     gst_deinit();
 }
@@ -192,11 +282,18 @@ void GstreamRecorder::GetGstState(int *state, int *pending)
 }
 
 /**
- * @brief GstreamRecorder::startRecord
- * @return  true成功
+ * @brief GstreamRecorder::warmUp
+ * 只进入READY状态，录音设备不开始采集
+ * @return true成功
  */
-bool GstreamRecorder::startRecord()
+bool GstreamRecorder::warmUp()
 {
+    if (m_recording) {
+        return true;
+    }
+    if (m_eosPending) {
+        return false;
+    }
     if (m_pipeline == nullptr && !createPipe())
         return false;
 
@@ -207,26 +304,210 @@ bool GstreamRecorder::startRecord()
     int state = -1;
     int pending = -1;
     GetGstState(&state, &pending);
-    if (state == GST_STATE_PLAYING) {
+    if (state == GST_STATE_NULL && pending != GST_STATE_READY) {
+        if (gst_element_set_state(m_pipeline, GST_STATE_READY) == GST_STATE_CHANGE_FAILURE) {
+            qCritical() << "warm up error";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief GstreamRecorder::prepare
+ * 设备打开和元素初始化较慢，提前进入预录状态，数据停在队列中不写入文件。
+ * 超时未开始录音时关闭设备
+ * @return true成功
+ */
+bool GstreamRecorder::prepare()
+{
+    if (m_recording) {
         return true;
-    } else if (state == GST_STATE_PAUSED) {
-        gst_element_set_state(m_pipeline, GST_STATE_PLAYING);
+    }
+    //上次录音的数据还未写完
+    if (m_eosPending) {
+        return false;
+    }
+    if (m_pipeline == nullptr && !createPipe())
+        return false;
+
+    if (!m_format.isValid()) {
+        initFormat();
+    }
+
+    blockPreRoll();
+    int state = -1;
+    int pending = -1;
+    GetGstState(&state, &pending);
+    if (state != GST_STATE_PLAYING && pending != GST_STATE_PLAYING) {
+        if (gst_element_set_state(m_pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+            qCritical() << "prepare error";
+            setStateToReady();
+            return false;
+        }
+    }
+    m_armTimer.start();
+    return true;
+}
+
+/**
+ * @brief GstreamRecorder::startRecord
+ * 预录状态下直接放开队列，队列中的预录数据补在录音开头
+ * @return  true成功
+ */
+bool GstreamRecorder::startRecord()
+{
+    if (m_recording) {
+        //暂停后继续录音
+        int state = -1;
+        int pending = -1;
+        GetGstState(&state, &pending);
+        if (state == GST_STATE_PAUSED) {
+            gst_element_set_state(m_pipeline, GST_STATE_PLAYING);
+        }
         return true;
     }
-    if (gst_element_set_state(m_pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
-        qCritical() << "start error";
+
+    //未预录时在这里打开设备，没有预录数据
+    if (!prepare()) {
         return false;
     }
+    m_armTimer.stop();
+
+    //新的录音，重新统计波形峰值和语音段
+    m_peakFile.reset(m_format.sampleRate());
+    m_voiceActivity.reset(m_silenceMode);
+    //丢弃上次录音未读取的电平，预录数据阻塞在队列中，此时流线程不会写入
+    m_levelRing.clear();
+    m_levelNotify.storeRelease(0);
+    GstElement *audioSink = gst_bin_get_by_name(reinterpret_cast<GstBin *>(m_pipeline), "filesink");
+    if (audioSink) {
+        //分段序号从0开始
+        g_object_set(reinterpret_cast<gpointer *>(audioSink), "index", 0, nullptr);
+        gst_object_unref(audioSink);
+    }
+    qint64 captureTime = m_captureTime.loadAcquire();
+    m_preRollStart = captureTime >= 0 ? captureTime - static_cast<qint64>(PreRollMs) * GST_MSECOND : -1;
+    m_baseTime = -1;
+    m_recording = true;
+    releasePreRoll();
+
+    if (!m_profile.streamable) {
+        m_syncTimer.start();
+    }
     return true;
 }
 
 /**
  * @brief GstreamRecorder::stopRecord
+ * 停止后保留流水线和元素，下次录音不需要重新创建
  */
 void GstreamRecorder::stopRecord()
 {
+    if (m_eosPending) {
+        return;
+    }
+    m_syncTimer.stop();
+    m_armTimer.stop();
+    bool recording = m_recording;
+    m_recording = false;
     if (m_pipeline) {
-        setStateToNull();
+        //预录状态下数据阻塞在队列，不需要结束数据流
+        if (recording && finishStream()) {
+            return;
+        }
+        setStateToReady();
+    }
+    emit recordStopped();
+}
+
+/**
+ * @brief GstreamRecorder::finishStream
+ * 直接停止时封装器缓存的数据和文件尾不会写入，ogg等格式会丢失末尾的录音。
+ * 暂停状态下实时采集的数据流不再流动，结束事件无法传递，直接停止
+ * @return 已发送结束事件返回true
+ */
+bool GstreamRecorder::finishStream()
+{
+    int state = -1;
+    int pending = -1;
+    GetGstState(&state, &pending);
+    if (state != GST_STATE_PLAYING) {
+        return false;
+    }
+
+    //结束事件和错误在总线回调中处理，不阻塞界面线程
+    m_eosPending = true;
+    m_eosTimer.start();
+    gst_element_send_event(m_pipeline, gst_event_new_eos());
+    return true;
+}
+
+/**
+ * @brief GstreamRecorder::onStreamFinished
+ * 最后一个分段的同步在总线回调中与其他分段一样处理
+ */
+void GstreamRecorder::onStreamFinished()
+{
+    if (!m_eosPending) {
+        return;
+    }
+    m_eosPending = false;
+    m_eosTimer.stop();
+    if (m_pipeline) {
+        setStateToReady();
+    }
+    emit recordStopped();
+}
+
+/**
+ * @brief GstreamRecorder::blockPreRoll
+ */
+void GstreamRecorder::blockPreRoll()
+{
+    if (m_preRollProbe != 0) {
+        return;
+    }
+    GstElement *audioQueue = gst_bin_get_by_name(reinterpret_cast<GstBin *>(m_pipeline), "audioqueue");
+    if (audioQueue == nullptr) {
+        return;
+    }
+    GstPad *pad = gst_element_get_static_pad(audioQueue, "src");
+    if (pad) {
+        m_preRollProbe = gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BLOCK_DOWNSTREAM, preRollProbe, nullptr, nullptr);
+        gst_object_unref(pad);
+    }
+    gst_object_unref(audioQueue);
+}
+
+/**
+ * @brief GstreamRecorder::releasePreRoll
+ */
+void GstreamRecorder::releasePreRoll()
+{
+    if (m_preRollProbe == 0) {
+        return;
+    }
+    GstElement *audioQueue = gst_bin_get_by_name(reinterpret_cast<GstBin *>(m_pipeline), "audioqueue");
+    if (audioQueue == nullptr) {
+        return;
+    }
+    GstPad *pad = gst_element_get_static_pad(audioQueue, "src");
+    if (pad) {
+        gst_pad_remove_probe(pad, m_preRollProbe);
+        gst_object_unref(pad);
+    }
+    gst_object_unref(audioQueue);
+    m_preRollProbe = 0;
+}
+
+/**
+ * @brief GstreamRecorder::releaseDevice
+ */
+void GstreamRecorder::releaseDevice()
+{
+    if (!m_recording && m_pipeline) {
+        setStateToReady();
     }
 }
 
@@ -255,6 +536,8 @@ void GstreamRecorder::setDevice(const QString &device)
     if (device != m_currentDevice) {
         m_currentDevice = device;
         if (m_pipeline != nullptr) {
+            //预录时设备已打开，关闭后下次预录使用新设备
+            releaseDevice();
             GstElement *audioSrc = gst_bin_get_by_name(reinterpret_cast<GstBin *>(m_pipeline), "audioSrc");
             g_object_set(reinterpret_cast<gpointer *>(audioSrc), "device", device.toLatin1().data(), nullptr);
         }
@@ -264,7 +547,7 @@ void GstreamRecorder::setDevice(const QString &device)
 
 /**
  * @brief GstreamRecorder::setOutputFile
- * @param path 录音文件路径
+ * @param path 分段文件名模板，包含%d格式的分段序号
  */
 void GstreamRecorder::setOutputFile(const QString &path)
 {
@@ -275,6 +558,47 @@ void GstreamRecorder::setOutputFile(const QString &path)
     }
 }
 
+/**
+ * @brief GstreamRecorder::setProfile
+ * 编码改变时重新创建流水线，需在录音停止时调用
+ * @param profile 录音编码配置
+ * @return 实际使用的配置
+ */
+VNoteRecordProfile GstreamRecorder::setProfile(const VNoteRecordProfile &profile)
+{
+    VNoteRecordProfile newProfile = profile;
+    if (!isProfileAvailable(newProfile)) {
+        qWarning() << "encoder not installed:" << newProfile.element;
+        newProfile = VNoteRecordProfile::fromCodec(VNoteRecordProfile::Mp3);
+    }
+
+    if (newProfile.codec != m_profile.codec && m_pipeline != nullptr) {
+        setStateToNull();
+        objectUnref(m_pipeline);
+        m_pipeline = nullptr;
+        m_preRollProbe = 0;
+    }
+    m_profile = newProfile;
+    //输入格式随编码改变
+    initFormat();
+    return m_profile;
+}
+
+/**
+ * @brief GstreamRecorder::isProfileAvailable
+ * @param profile 录音编码配置
+ * @return 已安装编码器插件时返回true
+ */
+bool GstreamRecorder::isProfileAvailable(const VNoteRecordProfile &profile)
+{
+    GstElementFactory *factory = gst_element_factory_find(profile.element.toLatin1().constData());
+    if (factory == nullptr) {
+        return false;
+    }
+    gst_object_unref(factory);
+    return true;
+}
+
 /**
  * @brief GstreamRecorder::doBusMessage
  * @param message 消息
@@ -301,6 +625,25 @@ bool GstreamRecorder::doBusMessage(GstMessage *message)
             qCritical() << "Got pipeline error:" << errMsg;
             g_error_free(error);
         }
+        //等待结束事件时出错，数据流不会再结束
+        onStreamFinished();
+        break;
+    }
+    case GST_MESSAGE_EOS:
+        onStreamFinished();
+        break;
+    case GST_MESSAGE_ELEMENT: {
+        //分段写完后在后台同步到磁盘，异常退出时最多丢失正在写入的分段
+        const GstStructure *structure = gst_message_get_structure(message);
+        if (structure && gst_structure_has_name(structure, "GstMultiFileSink")) {
+            const gchar *fileName = gst_structure_get_string(structure, "filename");
+            if (fileName) {
+                FileSyncWorker *worker = new FileSyncWorker(QString::fromLocal8Bit(fileName));
+                worker->setAutoDelete(true);
+                worker->setObjectName("FileSyncWorker");
+                QThreadPool::globalInstance()->start(worker);
+            }
+        }
         break;
     }
     default:
@@ -311,32 +654,103 @@ bool GstreamRecorder::doBusMessage(GstMessage *message)
 
 /**
  * @brief GstreamRecorder::doBufferProbe
+ * 在流线程中直接读取映射的数据计算电平和语音段，只把电平放入队列
  * @param buffer 录音数据
- * @return true 成功
+ * @return 去除静音时丢弃本段返回false
  */
 bool GstreamRecorder::doBufferProbe(GstBuffer *buffer)
 {
-    if (buffer) {
-        qint64 position = static_cast<qint64>(buffer->pts);
-        position = position >= 0
-                       ? position / (1000 * 1000) // 毫秒
-                       : -1;
-        QByteArray data;
-        GstMapInfo info;
-        if (gst_buffer_map(buffer, &info, GST_MAP_READ)) {
-            data = QByteArray(reinterpret_cast<const char *>(info.data),
-                              static_cast<int>(info.size));
+    if (nullptr == buffer) {
+        return true;
+    }
+
+    GstMapInfo info;
+    if (!gst_buffer_map(buffer, &info, GST_MAP_READ)) {
+        return true;
+    }
+
+    //预录数据只保留开始录音前的PreRollMs
+    qint64 pts = GST_BUFFER_PTS_IS_VALID(buffer) ? static_cast<qint64>(GST_BUFFER_PTS(buffer)) : -1;
+    if (m_baseTime < 0) {
+        if (pts >= 0 && pts < m_preRollStart) {
             gst_buffer_unmap(buffer, &info);
-        } else {
-            return true;
+            return false;
         }
+        m_baseTime = qMax(pts, Q_INT64_C(0));
+        //开始录音时已采集的数据即为补在开头的预录数据
+        qint64 preRoll = m_preRollStart >= 0
+                             ? (m_preRollStart + static_cast<qint64>(PreRollMs) * GST_MSECOND - m_baseTime) / GST_MSECOND
+                             : 0;
+        PerformanceMonitor::recordStartFinish(qMax(preRoll, Q_INT64_C(0)));
+    }
+
+    //编码器输入统一为S16LE
+    int channels = m_format.channelCount();
+    int frames = channels > 0 ? static_cast<int>(info.size / sizeof(qint16)) / channels : 0;
+    VNoteAudioLevels measured;
+    VNoteAudioLevel::measure(m_format, info.data, static_cast<int>(info.size), measured);
+
+    qint64 removedBefore = m_voiceActivity.removedDuration();
+    bool keep = m_voiceActivity.process(measured, frames, m_format.sampleRate());
+    if (keep && frames > 0) {
+        m_peakFile.appendS16(reinterpret_cast<const qint16 *>(info.data), frames, channels);
+    }
+    gst_buffer_unmap(buffer, &info);
+
+    //去除的静音不计入录音时长，电平位置使用录音文件时间
+    measured.position = pts >= 0
+                            ? (pts - m_baseTime - removedBefore) / (1000 * 1000) // 毫秒
+                            : -1;
 
-        QMutexLocker locker(&m_bufferMutex);
-        if (!m_pendingBuffer.isValid())
+    //界面线程来不及处理时丢弃本段电平，不影响录音
+    VNoteAudioLevels *levels = m_levelRing.beginWrite();
+    if (nullptr != levels) {
+        *levels = measured;
+        m_levelRing.endWrite();
+        if (m_levelNotify.testAndSetOrdered(0, 1)) {
             QMetaObject::invokeMethod(this, "bufferProbed", Qt::QueuedConnection);
-        m_pendingBuffer = QAudioBuffer(data, m_format, position);
+        }
     }
-    return true;
+    return keep;
+}
+
+/**
+ * @brief GstreamRecorder::setSilenceMode
+ * 下一次开始新的录音时生效
+ * @param mode 静音处理方式
+ */
+void GstreamRecorder::setSilenceMode(VNoteVoiceActivity::SilenceMode mode)
+{
+    m_silenceMode = mode;
+}
+
+/**
+ * @brief GstreamRecorder::timeOffset
+ * 只在流线程调用
+ * @return 时间戳偏移
+ */
+qint64 GstreamRecorder::timeOffset() const
+{
+    return qMax(m_baseTime, Q_INT64_C(0)) + m_voiceActivity.removedDuration();
+}
+
+/**
+ * @brief GstreamRecorder::setCaptureTime
+ * @param time 数据结束时间
+ */
+void GstreamRecorder::setCaptureTime(qint64 time)
+{
+    m_captureTime.storeRelease(time);
+}
+
+/**
+ * @brief GstreamRecorder::speechSegments
+ * 流水线停止后流线程不再更新，可以在界面线程读取
+ * @return 录音文件中的语音段
+ */
+VNOTE_SPEECH_SEGMENTS GstreamRecorder::speechSegments() const
+{
+    return m_voiceActivity.speechSegments();
 }
 
 /**
@@ -344,15 +758,37 @@ bool GstreamRecorder::doBufferProbe(GstBuffer *buffer)
  */
 void GstreamRecorder::bufferProbed()
 {
-    QAudioBuffer audioBuffer;
-    {
-        QMutexLocker locker(&m_bufferMutex);
-        if (!m_pendingBuffer.isValid())
-            return;
-        audioBuffer = m_pendingBuffer;
-        m_pendingBuffer = QAudioBuffer();
+    //先清除标记再读取，读取期间写入的数据会再次投递
+    m_levelNotify.storeRelease(0);
+    while (const VNoteAudioLevels *levels = m_levelRing.front()) {
+        emit audioLevelsProbed(*levels);
+        m_levelRing.pop();
     }
-    emit audioBufferProbed(audioBuffer);
+}
+
+/**
+ * @brief GstreamRecorder::syncOutputFile
+ */
+void GstreamRecorder::syncOutputFile()
+{
+    //不分段时只有第一个文件
+    FileSyncWorker *worker = new FileSyncWorker(QString::asprintf(m_outputFile.toLatin1().constData(), 0));
+    worker->setAutoDelete(true);
+    worker->setObjectName("FileSyncWorker");
+    QThreadPool::globalInstance()->start(worker);
+}
+
+/**
+ * @brief GstreamRecorder::setStateToReady
+ * 关闭录音设备，释放队列中的数据，元素保留
+ */
+void GstreamRecorder::setStateToReady()
+{
+    m_armTimer.stop();
+    gst_element_set_state(m_pipeline, GST_STATE_READY);
+    gst_element_get_state(m_pipeline, nullptr, nullptr, static_cast<GstClockTime>(-1));
+    //重新开始时时间戳从0开始
+    m_captureTime.storeRelease(-1);
 }
 
 /**
@@ -371,6 +807,18 @@ void GstreamRecorder::setStateToNull()
     gst_element_set_state(m_pipeline, GST_STATE_READY);
     gst_element_get_state(m_pipeline, nullptr, nullptr, static_cast<GstClockTime>(-1));
     gst_element_set_state(m_pipeline, GST_STATE_NULL);
+    m_captureTime.storeRelease(-1);
+}
+
+/**
+ * @brief GstreamRecorder::savePeakFile
+ * 流水线停止后流线程不再写入峰值，可以在界面线程保存
+ * @param path 峰值文件路径
+ * @return 成功返回true
+ */
+bool GstreamRecorder::savePeakFile(const QString &path)
+{
+    return m_peakFile.save(path);
 }
 
 /**
@@ -381,9 +829,9 @@ void GstreamRecorder::initFormat()
     //未压缩数据
     m_format.setCodec("audio/pcm");
     //通道，采样率
-    m_format.setChannelCount(2);
-    m_format.setSampleRate(44100);
-    //lamemp3enc 编码器插件格式为S16LE
+    m_format.setChannelCount(m_profile.channels);
+    m_format.setSampleRate(m_profile.sampleRate);
+    //编码器输入格式为S16LE
     m_format.setByteOrder(QAudioFormat::LittleEndian);
     m_format.setSampleType(QAudioFormat::SignedInt);
     m_format.setSampleSize(16);
@@ -6,10 +6,18 @@
 #ifndef GSTREAMRECORDER_H
 #define GSTREAMRECORDER_H
 
+#include "vnoteaudiolevel.h"
+#include "vnotespscring.h"
+#include "vnotepeakfile.h"
+#include "vnoterecordprofile.h"
+#include "vnotevoiceactivity.h"
+
 #include <QObject>
-#include <QMutex>
-#include <QAudioBuffer>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QAudioFormat>
 #include <QAudioDeviceInfo>
+#include <QTimer>
 
 #include <gst/gst.h>
 
@@ -17,37 +25,79 @@ class GstreamRecorder : public QObject
 {
     Q_OBJECT
 public:
+    //电平队列长度，界面线程繁忙时最多缓存的数据段数
+    enum {
+        LevelRingSize = 16,
+        EosTimeout = 2000, //停止录音时等待数据写完的时间，单位毫秒
+        PreRollMs = 500, //预录时长，开始录音时补在录音开头，单位毫秒
+        ArmTimeout = 30000, //预录状态下未开始录音时关闭设备的时间，单位毫秒
+    };
+
     explicit GstreamRecorder(QObject *parent = nullptr);
     ~GstreamRecorder();
+    //创建流水线并初始化元素，不采集数据
+    bool warmUp();
+    //打开录音设备进入预录状态，开始录音时只需切换文件
+    bool prepare();
     //开始录音
     bool startRecord();
     //暂停录音
     void pauseRecord();
-    //停止录音
+    //停止录音，数据写完后发送recordStopped
     void stopRecord();
     //设置录音设备名称
     void setDevice(const QString &device);
-    //设置录音文件
+    //设置录音分段文件名模板
     void setOutputFile(const QString &path);
+    //设置录音编码，编码器未安装时使用mp3，返回实际使用的配置
+    VNoteRecordProfile setProfile(const VNoteRecordProfile &profile);
+    //编码器插件是否已安装
+    static bool isProfileAvailable(const VNoteRecordProfile &profile);
     //处理gstreamer总线消息
     bool doBusMessage(GstMessage *message);
-    //获取编码器的输入数据
+    //在编码器的输入数据上计算电平
     bool doBufferProbe(GstBuffer *buffer);
     //设置录音状态为NULL
     void setStateToNull();
+    //保存录音的波形峰值文件，需在停止录音后调用
+    bool savePeakFile(const QString &path);
+    //设置静音处理方式，开始新的录音时生效
+    void setSilenceMode(VNoteVoiceActivity::SilenceMode mode);
+    //录音数据时间戳的偏移，包括录音开始时间和已去除的静音，单位纳秒
+    qint64 timeOffset() const;
+    //记录采集到的数据时间，单位纳秒
+    void setCaptureTime(qint64 time);
+    //录音文件中的语音段，需在停止录音后调用
+    VNOTE_SPEECH_SEGMENTS speechSegments() const;
 
 private slots:
-    //处理编码器的输入数据
+    //在界面线程发送队列中的电平
     void bufferProbed();
+    //定时将正在写入的录音同步到磁盘
+    void syncOutputFile();
+    //预录超时未开始录音，关闭录音设备
+    void releaseDevice();
+    //结束事件到达或超时，停止流水线
+    void onStreamFinished();
 Q_SIGNALS:
     //录音过程中发生错误，发送错误信息
     void errorMsg(QString msg);
-    //语音数据发生变化
-    void audioBufferProbed(const QAudioBuffer &buffer);
+    //录音电平更新
+    void audioLevelsProbed(const VNoteAudioLevels &levels);
+    //录音已停止，数据已写入文件，可以保存峰值和合并分段
+    void recordStopped();
 
 private:
     //创建录音流水线通道
     bool createPipe();
+    //结束数据流，编码器和封装写完缓存的数据后在总线消息中停止，需要等待时返回true
+    bool finishStream();
+    //阻塞编码器之前的数据，队列中只保留最近的预录数据
+    void blockPreRoll();
+    //放开预录数据，开始写入录音
+    void releasePreRoll();
+    //设置录音状态为READY，关闭设备但保留流水线
+    void setStateToReady();
     //对象使用计数减1
     void objectUnref(gpointer object);
     //初始化数据格式
@@ -60,9 +110,22 @@ private:
     GstElement *m_pipeline {nullptr};
     QString m_outputFile {""};
     QString m_currentDevice;
-    QAudioBuffer m_pendingBuffer;
-    QMutex m_bufferMutex;
     QAudioFormat m_format;
+    VNoteSpscRing<VNoteAudioLevels, LevelRingSize> m_levelRing; //流线程写入，界面线程读取
+    QAtomicInt m_levelNotify {0}; //已投递界面线程处理时为1，避免重复投递
+    VNotePeakFile m_peakFile; //录音过程中在流线程统计的波形峰值
+    VNoteRecordProfile m_profile; //录音编码配置
+    QTimer m_syncTimer; //不能分段的编码定时同步录音文件
+    VNoteVoiceActivity m_voiceActivity; //录音过程中在流线程检测语音段
+    VNoteVoiceActivity::SilenceMode m_silenceMode {VNoteVoiceActivity::KeepSilence};
+    QTimer m_armTimer; //预录超时定时器
+    QTimer m_eosTimer; //等待结束事件超时定时器
+    bool m_eosPending {false}; //已发送结束事件，等待数据写完
+    bool m_recording {false}; //正在录音（包括暂停），否则为预录或停止状态
+    gulong m_preRollProbe {0}; //阻塞预录数据的探针
+    QAtomicInteger<qint64> m_captureTime {-1}; //采集到的最新数据的结束时间，流线程写入
+    qint64 m_preRollStart {-1}; //早于该时间的预录数据丢弃，只在开始录音前写入
+    qint64 m_baseTime {-1}; //录音第一段数据的时间戳，流线程写入
 };
 
 #endif // GSTREAMRECORDER_H
@@ -4,10 +4,14 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "jscontent.h"
+#include "vnoteimagepolicy.h"
+#include "task/imageinsertworker.h"
 
 #include <QFile>
 #include <QVariant>
 #include <QEventLoop>
+#include <QTimer>
+#include <QDebug>
 #include <QFileInfo>
 #include <QStandardPaths>
 #include <QDir>
@@ -15,6 +19,8 @@
 #include <QJsonObject>
 #include <QClipboard>
 #include <QMimeData>
+#include <QThread>
+#include <QDateTime>
 
 #include <DApplication>
 
@@ -22,6 +28,9 @@ DWIDGET_USE_NAMESPACE
 
 JsContent::JsContent()
 {
+    //图片解码、编码占用内存较多，限制并发数
+    m_imagePool.setMaxThreadCount(qBound(2, QThread::idealThreadCount() / 2, 4));
+    m_imageInsertId = QDateTime::currentMSecsSinceEpoch();
     connect(QApplication::clipboard(), &QClipboard::changed, this, &JsContent::onClipChange);
 }
 
@@ -33,66 +42,108 @@ JsContent *JsContent::instance()
 
 /**
  * @brief JsContent::insertImages
- * 判断图片路径是否有效，存在有效路径则创建副本传到web端中
+ * 判断图片路径是否有效，存在有效路径则先插入占位，图片在后台存入附件目录后替换
  * @param filePaths 图片路径
  * @return 此次操作是否有效
  */
 bool JsContent::insertImages(QStringList filePaths)
 {
-    int count = 0;
-    QStringList paths;
-    //获取文件夹路径
-    QString dirPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/images";
-    //创建文件夹
-    QDir().mkdir(dirPath);
-    //获取时间戳
-    QDateTime currentDateTime = QDateTime::currentDateTime();
-    QString date = currentDateTime.toString("yyyyMMddhhmmss");
-
+    QStringList pendingIds;
     for (auto path : filePaths) {
         QFileInfo fileInfo(path);
         QString suffix = fileInfo.suffix();
-        if (!(suffix == "jpg" || suffix == "png" || suffix == "bmp")) {
+        if (!(suffix == "jpg" || suffix == "png" || suffix == "bmp") || !fileInfo.isFile()) {
             continue;
         }
-        //创建文件路径
-        QString newPath = QString("%1/%2_%3.%4").arg(dirPath).arg(date).arg(++count).arg(suffix);
-        if (QFile::copy(path, newPath)) {
-            paths.push_back(newPath);
-        }
+        //多个文件并行处理
+        QString pendingId = QString::number(++m_imageInsertId);
+        startImageWorker(new ImageInsertWorker(pendingId, path));
+        pendingIds.push_back(pendingId);
     }
-    if (paths.size() == 0) {
+    if (pendingIds.size() == 0) {
         return false;
     }
-    emit callJsInsertImages(paths);
+    emit callJsInsertImagePlaceholders(pendingIds);
     return true;
 }
 
 /**
  * @brief JsContent::insertImages
- * 向web端传入图片
+ * 向web端传入图片，编码在后台进行
  * @param image
  * @return 操作是否成功 true:成功
  */
 bool JsContent::insertImages(const QImage &image)
 {
-    //获取文件夹路径
-    QString dirPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/images";
-    //创建文件夹
-    QDir().mkdir(dirPath);
-    //保存文件，文件名为当前年月日时分秒
-    QDateTime currentDateTime = QDateTime::currentDateTime();
-    QString fileName = currentDateTime.toString("yyyyMMddhhmmss.png");
-    QString imgPath = dirPath + "/" + fileName;
-
-    //保存文件
-    if (!image.save(imgPath)) {
+    if (image.isNull()) {
+        return false;
+    }
+
+    QString pendingId = QString::number(++m_imageInsertId);
+    startImageWorker(new ImageInsertWorker(pendingId, image));
+    emit callJsInsertImagePlaceholders(QStringList(pendingId));
+    return true;
+}
+
+/**
+ * @brief JsContent::startImageWorker
+ * @param worker 插入图片任务
+ */
+void JsContent::startImageWorker(ImageInsertWorker *worker)
+{
+    worker->setPolicy(VNoteImagePolicy::fromSettings());
+    worker->setThumbnailWidth(m_imageWidth);
+    worker->setAutoDelete(true);
+    worker->setObjectName("ImageInsertWorker");
+    connect(worker, &ImageInsertWorker::imageInserted, this, [this](const QString &pendingId, const QString &path, const QString &originalPath) {
+        m_pendingImages--;
+        emit callJsReplaceImage(pendingId, path, originalPath);
+    }, Qt::QueuedConnection);
+    m_pendingImages++;
+    m_imagePool.start(worker);
+}
+
+/**
+ * @brief JsContent::waitForImages
+ * 局部事件循环等待，图片处理结果在循环中发送给web端
+ * @param timeout 最长等待时间
+ * @return 有处理中的图片时返回true
+ */
+bool JsContent::waitForImages(int timeout)
+{
+    if (m_pendingImages <= 0) {
         return false;
     }
-    emit callJsInsertImages(QStringList(imgPath));
+    QEventLoop loop;
+    QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
+    connect(this, &JsContent::callJsReplaceImage, &loop, [this, &loop] {
+        if (m_pendingImages <= 0) {
+            loop.quit();
+        }
+    });
+    loop.exec(QEventLoop::ExcludeUserInputEvents);
     return true;
 }
 
+/**
+ * @brief JsContent::jsCallSetImageWidth
+ * @param width 编辑区缩略图宽度
+ */
+void JsContent::jsCallSetImageWidth(int width)
+{
+    m_imageWidth = width;
+}
+
+/**
+ * @brief JsContent::jsCallPoolPageChanged
+ * @param noteId 笔记id
+ * @param html 笔记内容
+ */
+void JsContent::jsCallPoolPageChanged(int noteId, const QString &html)
+{
+    emit poolPageChanged(noteId, html);
+}
+
 void JsContent::jsCallTxtChange()
 {
     emit textChange();
@@ -140,16 +191,70 @@ QString JsContent::jsCallGetTranslation()
     return doc.toJson(QJsonDocument::Compact);
 }
 
-QVariant JsContent::callJsSynchronous(QWebEnginePage *page, const QString &funtion)
+/**
+ * @brief JsContent::callJsAsync
+ * 通过请求id管理回调，页面返回结果或超时后回调，二者以先到者为准
+ * @param page 页面
+ * @param funtion 接口调用语句
+ * @param callback 结果回调
+ * @param timeout 超时时间
+ * @return 请求id
+ */
+int JsContent::callJsAsync(QWebEnginePage *page, const QString &funtion, const JsCallback &callback, int timeout)
+{
+    if (nullptr == page) {
+        if (callback) {
+            callback(QVariant());
+        }
+        return -1;
+    }
+
+    int requestId = ++m_jsRequestId;
+    m_jsCallbacks.insert(requestId, callback);
+    page->runJavaScript(funtion, [ = ](const QVariant &result) {
+        finishJsCall(requestId, result);
+    });
+    QTimer::singleShot(timeout, this, [ = ] {
+        if (m_jsCallbacks.contains(requestId))
+        {
+            qWarning() << "call js timeout:" << funtion.left(64);
+            finishJsCall(requestId, QVariant());
+        }
+    });
+    return requestId;
+}
+
+/**
+ * @brief JsContent::finishJsCall
+ * @param requestId 请求id
+ * @param result 调用结果
+ */
+void JsContent::finishJsCall(int requestId, const QVariant &result)
+{
+    JsCallback callback = m_jsCallbacks.take(requestId);
+    if (callback) {
+        callback(result);
+    }
+}
+
+/**
+ * @brief JsContent::callJsSynchronous
+ * 局部事件循环等待结果，最长等待timeout毫秒
+ * @param page 页面
+ * @param funtion 接口调用语句
+ * @param timeout 最长等待时间
+ * @return 调用结果
+ */
+QVariant JsContent::callJsSynchronous(QWebEnginePage *page, const QString &funtion, int timeout)
 {
     QVariant synResult;
-    QEventLoop synLoop;
     if (page) {
-        page->runJavaScript(funtion, [&](const QVariant &result) {
+        QEventLoop synLoop;
+        callJsAsync(page, funtion, [&](const QVariant &result) {
             synResult = result;
             synLoop.quit();
-        });
-        synLoop.exec();
+        }, timeout);
+        synLoop.exec(QEventLoop::ExcludeUserInputEvents);
     }
     return synResult;
 }
@@ -159,6 +264,11 @@ void JsContent::jsCallSetDataFinsh()
     emit setDataFinsh();
 }
 
+void JsContent::jsCallSearchFinish(int count)
+{
+    emit searchFinish(count);
+}
+
 void JsContent::jsCallPaste(bool isVoicePaste)
 {
     emit textPaste(isVoicePaste);
@@ -8,9 +8,15 @@
 
 #include <QObject>
 #include <QClipboard>
+#include <QHash>
+#include <QThreadPool>
+
+#include <functional>
 
 #include <QtWebEngineWidgets/qwebenginepage.h>
 
+class ImageInsertWorker;
+
 class JsContent : public QObject
 {
     Q_OBJECT
@@ -27,30 +33,73 @@ public:
     };
     Q_ENUM(AsrFlag)
 
-    QVariant callJsSynchronous(QWebEnginePage *page, const QString &funtion);
+    //web前端接口调用结果回调，超时或页面无效时结果为无效值
+    typedef std::function<void(const QVariant &result)> JsCallback;
+    //web前端接口默认超时时间，单位毫秒
+    enum {
+        DefaultJsTimeout = 5000
+    };
+
+    /**
+     * @brief 异步调用web前端接口，不阻塞界面事件循环
+     * @param page 页面
+     * @param funtion 接口调用语句
+     * @param callback 结果回调，保证只回调一次
+     * @param timeout 超时时间，超时后以无效值回调
+     * @return 请求id，页面无效时返回-1
+     */
+    int callJsAsync(QWebEnginePage *page, const QString &funtion, const JsCallback &callback, int timeout = DefaultJsTimeout);
+    /**
+     * @brief 同步调用web前端接口，仅用于程序退出等必须等待结果的场景
+     * @param page 页面
+     * @param funtion 接口调用语句
+     * @param timeout 最长等待时间
+     * @return 调用结果，超时返回无效值
+     */
+    QVariant callJsSynchronous(QWebEnginePage *page, const QString &funtion, int timeout = DefaultJsTimeout);
     /**
-     * @brief 插入图片
+     * @brief 插入图片，先插入占位，后台处理完成后替换
      * @param filePaths 图片路径
-     * @return
+     * @return 存在有效图片时返回true
      */
     bool insertImages(QStringList filePaths);
     /**
-     * @brief 插入图片
+     * @brief 插入剪贴板图片，先插入占位，后台编码完成后替换
      */
     bool insertImages(const QImage &image);
+    /**
+     * @brief 等待后台处理中的图片完成并通知web端替换占位，用于程序退出、系统休眠
+     * @param timeout 最长等待时间，单位毫秒
+     * @return 有处理中的图片时返回true
+     */
+    bool waitForImages(int timeout = DefaultJsTimeout);
 
 signals:
     void callJsInitData(const QString &jsonData); //调用web前端，设置json格式数据
     void callJsSetHtml(const QString &html); //调用web前端，设置html格式数据
     void callJsInsertVoice(const QString &jsonData); //调用web前端，插入语音
+    void callJsAppendVoice(const QString &jsonData); //调用web前端，在笔记末尾插入语音
     /**
      * @brief 调用web前端，设置语音转文字结果
      * @param text 文本
      * @param flag 转写标志 参数说明依据AsrFlag枚举
      */
     void callJsSetVoiceText(const QString &text, int asrflag);
-    void callJsInsertImages(const QStringList &images); //调用web前端，插入图片
+    /**
+     * @brief 调用web前端，在光标处插入图片占位
+     * @param pendingIds 占位id
+     */
+    void callJsInsertImagePlaceholders(const QStringList &pendingIds);
+    /**
+     * @brief 调用web前端，图片处理完成后替换占位
+     * @param pendingId 占位id
+     * @param path 图片路径，处理失败时为空，删除占位
+     * @param originalPath 重新编码前的原图路径，未保存原图时为空
+     */
+    void callJsReplaceImage(const QString &pendingId, const QString &path, const QString &originalPath);
     void callJsSetPlayStatus(int status); //调用web前端, 设置播放状态，0播放中，1暂停中 2.结束播放
+    void callJsSetActiveVoice(const QString &voicePath); //调用web前端, 连续播放时设置当前播放的语音
+    void callJsSetVoiceTextByPath(const QString &voicePath, const QString &text); //调用web前端, 批量转写完成后设置语音的转写文本
     /**
      * @brief 调用web前端，设置系统主题
      * @param theme : 主题类型，0 未知，1浅色主题，2深色主题，参考DGuiApplicationHelper::ColorType
@@ -86,6 +135,41 @@ signals:
     void callJsSetFontList(const QStringList &list, const QString &font);
     void getfontinfo();  //获取字体列表信息信号
 
+    /**
+     * @brief 调用web前端，高亮所有匹配的关键字并定位到第一个，完成后回调jsCallSearchFinish
+     * @param keyword 搜索关键字
+     */
+    void callJsSearchText(const QString &keyword);
+    void callJsSearchNext(bool forward); //调用web前端，定位到下一个/上一个高亮
+    void callJsClearSearch(); //调用web前端，清除搜索高亮
+    /**
+     * @brief 调用web前端，切换笔记，当前内容移入页面缓存池，目标笔记已缓存时直接换入
+     * @param oldId 当前笔记id，小于0时不缓存
+     * @param oldRev 当前笔记内容版本
+     * @param noteId 目标笔记id
+     * @param rev 目标笔记内容版本
+     * @param html 目标笔记内容，未命中缓存时使用
+     */
+    void callJsSwitchNote(int oldId, const QString &oldRev, int noteId, const QString &rev, const QString &html);
+    /**
+     * @brief 调用web前端，空闲时预加载笔记内容到页面缓存池
+     * @param noteId 笔记id
+     * @param rev 笔记内容版本
+     * @param html 笔记内容
+     */
+    void callJsPreloadNote(int noteId, const QString &rev, const QString &html);
+    /**
+     * @brief 编辑区搜索高亮完成信号
+     * @param count 匹配数量
+     */
+    void searchFinish(int count);
+    /**
+     * @brief 页面缓存池中的笔记内容变化（插入的图片处理完成时已切换笔记），需保存
+     * @param noteId 笔记id
+     * @param html 笔记内容
+     */
+    void poolPageChanged(int noteId, const QString &html);
+
 protected:
     JsContent();
 
@@ -104,10 +188,31 @@ public slots:
     void jsCallCreateNote(); //web前端调用后端，新建笔记
     void jsCallSetClipData(const QString &text, const QString &html); //web前端调用后端，设置剪切板内容
     QString jsCallGetTranslation(); //web前端调用后端，获取翻译
+    void jsCallSearchFinish(int count); //web前端调用后端，通知搜索高亮完成
+    void jsCallSetImageWidth(int width); //web前端调用后端，设置编辑区缩略图宽度
+    void jsCallPoolPageChanged(int noteId, const QString &html); //web前端调用后端，缓存池中的笔记内容变化
     void onClipChange(QClipboard::Mode mode);
 
 private:
+    /**
+     * @brief 结束异步调用，回调结果并移除请求
+     * @param requestId 请求id
+     * @param result 调用结果
+     */
+    void finishJsCall(int requestId, const QVariant &result);
+    /**
+     * @brief 后台处理插入的图片
+     * @param worker 插入图片任务
+     */
+    void startImageWorker(ImageInsertWorker *worker);
+
     const QMimeData *m_clipData {nullptr};
+    int m_jsRequestId {0}; //异步调用请求id
+    QHash<int, JsCallback> m_jsCallbacks; //未完成的异步调用
+    qint64 m_imageInsertId {0}; //插入图片占位id，以启动时间为起点，与上次运行遗留的占位不重复
+    int m_pendingImages {0}; //后台处理中的图片数量
+    int m_imageWidth {0}; //编辑区缩略图宽度
+    QThreadPool m_imagePool; //插入图片处理线程池
 };
 
 #endif // JSCONTENT_H
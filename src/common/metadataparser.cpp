@@ -67,6 +67,12 @@ bool MetaDataParser::parse(const QVariant &metaData, VNoteBlock *blockData)
         blockData->ptrVoice->voiceSize = note.value(m_jsonNodeNameMap[NVoiceSize]).toInt(0);
         blockData->ptrVoice->createTime = QDateTime::fromString(
             note.value(m_jsonNodeNameMap[NCreateTime]).toString(), VNOTE_TIME_FMT);
+        blockData->ptrVoice->speechSegments.clear();
+        for (const QJsonValue &value : note.value(m_jsonNodeNameMap[NSpeech]).toArray()) {
+            QJsonArray segment = value.toArray();
+            blockData->ptrVoice->speechSegments.append(
+                qMakePair(static_cast<qint64>(segment.at(0).toDouble()), static_cast<qint64>(segment.at(1).toDouble())));
+        }
     } else {
         //其他类型
         return false;
@@ -105,6 +111,13 @@ void MetaDataParser::makeMetaData(const VNoteBlock *blockData, QVariant &metaDat
             note.insert(m_jsonNodeNameMap[NCreateTime],
                         blockData->ptrVoice->createTime.toString(VNOTE_TIME_FMT));
             note.insert(m_jsonNodeNameMap[NFormatSize], Utils::formatMillisecond(blockData->ptrVoice->voiceSize));
+            if (!blockData->ptrVoice->speechSegments.isEmpty()) {
+                QJsonArray segments;
+                for (const QPair<qint64, qint64> &segment : blockData->ptrVoice->speechSegments) {
+                    segments.append(QJsonArray {segment.first, segment.second});
+                }
+                note.insert(m_jsonNodeNameMap[NSpeech], segments);
+            }
         }
     }
     noteDoc.setObject(note);
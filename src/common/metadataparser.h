@@ -92,6 +92,7 @@ public:
         NCreateTime,
         NHtmlCode,
         NFormatSize,
+        NSpeech,
     };
 #endif
     //源数据解析
@@ -142,6 +143,7 @@ protected:
         {NCreateTime, "createTime"},
         {NHtmlCode, "htmlCode"},
         {NFormatSize, "transSize"},
+        {NSpeech, "speech"}, // Speech segments: [[start, end], ...] in milliseconds
     };
     //json串解析
     void jsonParse(const QVariant &metaData, VNoteItem *noteData /*out*/);
@@ -4,11 +4,14 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "performancemonitor.h"
+#include <QAtomicInteger>
 #include <QDateTime>
 #include <QDebug>
 
 static qint64 initializeAppStartMs = 0;
 static qint64 initializeAppFinishMs = 0;
+static qint64 webPageLoadStartMs = 0;
+static QAtomicInteger<qint64> recordStartMs {0};
 
 /**
  * @brief PerformanceMonitor::initializeAppStart
@@ -31,3 +34,63 @@ void PerformanceMonitor::initializeAppFinish()
     qint64 time = initializeAppFinishMs - initializeAppStartMs;
     qInfo() << QString("[GRABPOINT] POINT-01 startduration=%1ms").arg(time);
 }
+
+/**
+ * @brief PerformanceMonitor::webPageLoadStart
+ * 记录web编辑器页面开始加载时间
+ */
+void PerformanceMonitor::webPageLoadStart()
+{
+    webPageLoadStartMs = QDateTime::currentMSecsSinceEpoch();
+}
+
+/**
+ * @brief PerformanceMonitor::webPageLoadFinish
+ * 页面及脚本加载完成，只记录冷启动的第一次
+ */
+void PerformanceMonitor::webPageLoadFinish()
+{
+    if (0 == webPageLoadStartMs) {
+        return;
+    }
+    qint64 time = QDateTime::currentMSecsSinceEpoch() - webPageLoadStartMs;
+    qInfo() << QString("[GRABPOINT] POINT-02 webloadduration=%1ms").arg(time);
+}
+
+/**
+ * @brief PerformanceMonitor::webEditorReady
+ * 编辑器初始化完成，可以设置笔记内容
+ */
+void PerformanceMonitor::webEditorReady()
+{
+    if (0 == webPageLoadStartMs) {
+        return;
+    }
+    qint64 time = QDateTime::currentMSecsSinceEpoch() - webPageLoadStartMs;
+    webPageLoadStartMs = 0;
+    qInfo() << QString("[GRABPOINT] POINT-03 editorreadyduration=%1ms").arg(time);
+}
+
+/**
+ * @brief PerformanceMonitor::recordStart
+ * 记录点击录音的时间
+ */
+void PerformanceMonitor::recordStart()
+{
+    recordStartMs.storeRelease(QDateTime::currentMSecsSinceEpoch());
+}
+
+/**
+ * @brief PerformanceMonitor::recordStartFinish
+ * 第一段录音数据到达编码器，在录音流线程调用
+ * @param preRollMs 预录时长
+ */
+void PerformanceMonitor::recordStartFinish(qint64 preRollMs)
+{
+    qint64 startMs = recordStartMs.fetchAndStoreAcquire(0);
+    if (0 == startMs) {
+        return;
+    }
+    qint64 time = QDateTime::currentMSecsSinceEpoch() - startMs;
+    qInfo() << QString("[GRABPOINT] POINT-04 recordstartduration=%1ms preroll=%2ms").arg(time).arg(preRollMs);
+}
@@ -11,6 +11,13 @@ class PerformanceMonitor
 public:
     static void initializeAppStart();
     static void initializeAppFinish();
+    //web编辑器冷启动耗时
+    static void webPageLoadStart();
+    static void webPageLoadFinish();
+    static void webEditorReady();
+    //点击录音到第一段录音数据写入的耗时，preRollMs为补在开头的预录时长
+    static void recordStart();
+    static void recordStartFinish(qint64 preRollMs);
 };
 
 #endif // PERFORMANCEMONITOR_H
@@ -25,6 +25,16 @@ void GenerateSettingTranslate()
     auto audio_source = DApplication::translate("Setting", "Audio Source");
     auto audio_internal = DApplication::translate("Setting", "Internal");
     auto audio_micphone = DApplication::translate("Setting", "Microphone");
+    auto record = DApplication::translate("Setting", "Recording");
+    auto record_format = DApplication::translate("Setting", "Format");
+    auto record_mp3 = DApplication::translate("Setting", "MP3 (compatible)");
+    auto record_opus = DApplication::translate("Setting", "Opus (speech, smallest)");
+    auto record_aac = DApplication::translate("Setting", "AAC");
+    auto record_flac = DApplication::translate("Setting", "FLAC (lossless)");
+    auto record_silence = DApplication::translate("Setting", "Silence");
+    auto silence_keep = DApplication::translate("Setting", "Keep");
+    auto silence_skip = DApplication::translate("Setting", "Skip during playback");
+    auto silence_remove = DApplication::translate("Setting", "Remove while recording");
 }
 
 /**
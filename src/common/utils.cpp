@@ -7,6 +7,7 @@
 #include "globaldef.h"
 #include "vnoteitem.h"
 #include "vnoteapplication.h"
+#include "vnoteimagecache.h"
 
 #include <DGuiApplicationHelper>
 
@@ -18,6 +19,8 @@
 #include <QFileInfo>
 #include <QProcess>
 
+#include <climits>
+
 Utils::Utils()
 {
 }
@@ -281,8 +284,8 @@ void Utils::setTitleBarTabFocus(QKeyEvent *event)
  */
 bool Utils::pictureToBase64(QString imgPath, QString &base64)
 {
-    //加载图片，目前的参考格式为（bmp, jpg, png, jpeg, gif, ico）
-    QImage img(imgPath, "bmp, jpg, png, jpeg, gif, ico");
+    //按最大宽度712解码图片，缩小后的图片使用磁盘缓存
+    QImage img = VNoteImageCache::loadScaled(imgPath, QSize(712, INT_MAX));
     //非本地文件返回空字符串
     if (img.isNull()) {
         return false;
@@ -291,13 +294,7 @@ bool Utils::pictureToBase64(QString imgPath, QString &base64)
     QByteArray ba;
     QBuffer buf(&ba);
     QFileInfo fileInfo(imgPath);
-
-    //设置图片最大宽度
-    int width = qMin(img.width(), 712);
-    int height = img.height();
-
-    //等比例缩放图片
-    img.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation).save(&buf, qPrintable(fileInfo.suffix()));
+    img.save(&buf, qPrintable(fileInfo.suffix()));
     //图片转base64
     base64 = QString("data:image/%1;base64," + ba.toBase64()).arg(fileInfo.suffix());
     return true;
@@ -10,7 +10,14 @@
 
 #include <DApplication>
 
+#include <QFile>
+#include <QGuiApplication>
+#include <QScreen>
+
 DWIDGET_USE_NAMESPACE
+
+VlcPalyer *VlcPalyer::_instance = nullptr;
+
 /**
  * @brief VlcPalyer::VlcPalyer
  * @param parent
@@ -18,9 +25,38 @@ DWIDGET_USE_NAMESPACE
 VlcPalyer::VlcPalyer(QObject *parent)
     : QObject(parent)
 {
-#ifdef MPV_PLAYENGINE
+    //播放位置的刷新不超过屏幕刷新率
+    QScreen *screen = QGuiApplication::primaryScreen();
+    if (screen && screen->refreshRate() > 0) {
+        m_positionInterval = qMax(1, static_cast<int>(1000 / screen->refreshRate()));
+    }
+    m_positionTimer.setSingleShot(true);
+    connect(&m_positionTimer, &QTimer::timeout, this, &VlcPalyer::emitPosition);
     init();
-#endif
+}
+
+/**
+ * @brief VlcPalyer::instance
+ * @return 单例对象
+ */
+VlcPalyer *VlcPalyer::instance()
+{
+    if (nullptr == _instance) {
+        _instance = new VlcPalyer();
+    }
+
+    return _instance;
+}
+
+/**
+ * @brief VlcPalyer::releaseInstance
+ */
+void VlcPalyer::releaseInstance()
+{
+    if (nullptr != _instance) {
+        delete _instance;
+        _instance = nullptr;
+    }
 }
 
 /**
@@ -39,7 +75,9 @@ void VlcPalyer::init()
 #ifndef MPV_PLAYENGINE
     qInfo() << "The current play engine is vlc";
     if (m_vlcInst == nullptr) {
-        m_vlcInst = libvlc_new(0, nullptr);
+        //倍速播放时通过scaletempo保持音调
+        const char *args[] = {"--audio-time-stretch"};
+        m_vlcInst = libvlc_new(1, args);
         libvlc_set_user_agent(m_vlcInst, DApplication::translate("AppMain", "Voice Notes").toUtf8().constData(), "");
         libvlc_set_app_id(m_vlcInst, "", "", "deepin-voice-note");
     }
@@ -68,13 +106,15 @@ void VlcPalyer::deinit()
 #ifndef MPV_PLAYENGINE
     if (m_vlcPlayer) {
         detachEvent();
-        libvlc_media_t *media = libvlc_media_player_get_media(m_vlcPlayer);
-        if (media) {
-            libvlc_media_release(media);
-        }
+        //播放器持有当前媒体的引用，释放播放器时一起释放
         libvlc_media_player_release(m_vlcPlayer);
         m_vlcPlayer = nullptr;
     }
+    for (libvlc_media_t *media : m_medias) {
+        libvlc_media_release(media);
+    }
+    m_medias.clear();
+    m_mediaOrder.clear();
     if (m_vlcInst) {
         libvlc_release(m_vlcInst);
         m_vlcInst = nullptr;
@@ -85,8 +125,11 @@ void VlcPalyer::deinit()
         disconnect(player, &dmr::PlayerEngine::elapsedChanged, this, &VlcPalyer::onGetCurrentPosition);
         disconnect(player, &dmr::PlayerEngine::stateChanged, this, &VlcPalyer::onGetState);
         disconnect(player, &dmr::PlayerEngine::fileLoaded, this, &VlcPalyer::onGetduration);
-        player->deleteLater();
+        //程序退出时事件循环已结束，直接释放
+        delete player;
+        player = nullptr;
     }
+    m_playlistUrls.clear();
 #endif
 }
 
@@ -116,7 +159,165 @@ void VlcPalyer::detachEvent()
         libvlc_event_detach(vlc_evt_man, libvlc_MediaPlayerLengthChanged, handleEvent, this);
     }
 }
+
+/**
+ * @brief VlcPalyer::cachedMedia
+ * 本地文件只解析时长等信息，解析在后台进行
+ * @param path 文件路径
+ * @return 媒体，由缓存持有
+ */
+libvlc_media_t *VlcPalyer::cachedMedia(const QString &path)
+{
+    libvlc_media_t *media = m_medias.value(path, nullptr);
+    if (media) {
+        m_mediaOrder.removeOne(path);
+        m_mediaOrder.append(path);
+        return media;
+    }
+
+    media = libvlc_media_new_path(m_vlcInst, path.toLocal8Bit().constData());
+    if (nullptr == media) {
+        return nullptr;
+    }
+    libvlc_event_manager_t *vlc_evt_man = libvlc_media_event_manager(media);
+    if (vlc_evt_man) {
+        libvlc_event_attach(vlc_evt_man, libvlc_MediaParsedChanged, handleEvent, this);
+    }
+    libvlc_media_parse_with_options(media, libvlc_media_parse_local, -1);
+    m_medias.insert(path, media);
+    m_mediaOrder.append(path);
+
+    //正在播放的媒体由播放器持有引用，释放缓存不影响播放
+    while (m_mediaOrder.size() > MaxCachedMedia) {
+        libvlc_media_t *oldMedia = m_medias.take(m_mediaOrder.takeFirst());
+        libvlc_event_manager_t *old_evt_man = libvlc_media_event_manager(oldMedia);
+        if (old_evt_man) {
+            libvlc_event_detach(old_evt_man, libvlc_MediaParsedChanged, handleEvent, this);
+        }
+        libvlc_media_release(oldMedia);
+    }
+    return media;
+}
+
+/**
+ * @brief VlcPalyer::onMediaParsed
+ */
+void VlcPalyer::onMediaParsed()
+{
+    for (auto it = m_medias.begin(); it != m_medias.end(); ++it) {
+        if (!m_durations.contains(it.key())
+            && libvlc_media_get_parsed_status(it.value()) == libvlc_media_parsed_status_done) {
+            qint64 duration = libvlc_media_get_duration(it.value());
+            if (duration > 0) {
+                m_durations.insert(it.key(), duration);
+            }
+        }
+    }
+}
+#else
+/**
+ * @brief VlcPalyer::usePlaylistUrl
+ * @param url 文件
+ */
+void VlcPalyer::usePlaylistUrl(const QUrl &url)
+{
+    if (m_playlistUrls.removeOne(url)) {
+        m_playlistUrls.append(url);
+        return;
+    }
+    player->addPlayFile(url);
+    m_playlistUrls.append(url);
+}
+
+/**
+ * @brief VlcPalyer::trimPlaylist
+ * 与vlc的媒体缓存一致，只保留最近使用的MaxCachedMedia个文件
+ */
+void VlcPalyer::trimPlaylist()
+{
+    int i = 0;
+    while (m_playlistUrls.size() > MaxCachedMedia && i < m_playlistUrls.size()) {
+        //正在播放的文件不移除
+        if (m_playlistUrls.at(i) == videoUrl) {
+            i++;
+            continue;
+        }
+        int index = player->getplaylist()->indexOf(m_playlistUrls.takeAt(i));
+        if (index >= 0) {
+            player->getplaylist()->remove(index);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief VlcPalyer::prefetch
+ * @param paths 语音文件路径，只解析前MaxPrefetch个
+ */
+void VlcPalyer::prefetch(const QStringList &paths)
+{
+#ifndef MPV_PLAYENGINE
+    for (int i = 0; i < paths.size() && i < MaxPrefetch; i++) {
+        cachedMedia(paths.at(i));
+    }
+#else
+    //播放列表在后台加载文件信息，播放时直接按名称播放
+    QList<QUrl> urls;
+    for (int i = 0; i < paths.size() && i < MaxPrefetch; i++) {
+        QUrl url = QUrl::fromLocalFile(paths.at(i));
+        if (m_playlistUrls.removeOne(url)) {
+            m_playlistUrls.append(url);
+        } else if (QFile::exists(paths.at(i))) {
+            urls.append(url);
+            m_playlistUrls.append(url);
+        }
+    }
+    if (!urls.isEmpty()) {
+        player->addPlayFiles(urls);
+    }
+    trimPlaylist();
 #endif
+}
+
+/**
+ * @brief VlcPalyer::cachedDuration
+ * @param path 文件路径
+ * @return 语音时长
+ */
+qint64 VlcPalyer::cachedDuration(const QString &path) const
+{
+    return m_durations.value(path, 0);
+}
+
+/**
+ * @brief VlcPalyer::updatePosition
+ * 播放引擎频繁上报播放位置，只保留最新的位置，由界面线程按刷新频率发送
+ * @param position 播放位置
+ */
+void VlcPalyer::updatePosition(qint64 position)
+{
+    m_position.storeRelease(position);
+    if (m_positionNotify.testAndSetOrdered(0, 1)) {
+        QMetaObject::invokeMethod(this, "emitPosition", Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief VlcPalyer::emitPosition
+ */
+void VlcPalyer::emitPosition()
+{
+    if (m_positionClock.isValid() && m_positionClock.elapsed() < m_positionInterval) {
+        if (!m_positionTimer.isActive()) {
+            m_positionTimer.start(m_positionInterval - static_cast<int>(m_positionClock.elapsed()));
+        }
+        return;
+    }
+    //先清除标记再读取，读取后的位置会再次投递
+    m_positionNotify.storeRelease(0);
+    m_positionClock.start();
+    emit positionChanged(m_position.loadAcquire());
+}
 
 /**
  * @brief VlcPalyer::setFilePath
@@ -125,16 +326,18 @@ void VlcPalyer::detachEvent()
 void VlcPalyer::setFilePath(QString path)
 {
     qDebug() << "Current playback file: " << path;
+    m_filePath = path;
 #ifndef MPV_PLAYENGINE
-    init();
-    libvlc_media_t *media = libvlc_media_new_path(m_vlcInst, path.toLatin1().constData());
+    libvlc_media_t *media = cachedMedia(path);
     if (media) {
         libvlc_media_player_set_media(m_vlcPlayer, media);
-        libvlc_media_release(media);
+        libvlc_media_player_set_rate(m_vlcPlayer, static_cast<float>(m_rate));
     }
 #else
-    if (player->isPlayableFile(path)){
-       videoUrl = QUrl::fromLocalFile(path);
+    //已加入播放列表的文件不再检查
+    QUrl url = QUrl::fromLocalFile(path);
+    if (m_playlistUrls.contains(url) || player->isPlayableFile(path)) {
+        videoUrl = url;
     }
 #endif
 }
@@ -156,7 +359,9 @@ void VlcPalyer::play()
         player->pauseResume();
     }else{
         qInfo() << "Play new audio: " << videoUrl;
-        player->addPlayFile(videoUrl);
+        //播放列表中已有的文件直接播放，不重复加载
+        usePlaylistUrl(videoUrl);
+        trimPlaylist();
         player->playByName(videoUrl);
     }
 #endif
@@ -198,8 +403,7 @@ void VlcPalyer::stop()
  */
 void VlcPalyer::onGetCurrentPosition()
 {
-//    qInfo() << "The current play position has changed!" << player->engine().elapsed();
-     emit positionChanged(player->elapsed());
+    updatePosition(player->elapsed());
 }
 
 /**
@@ -219,6 +423,9 @@ void VlcPalyer::onGetState()
 void VlcPalyer::onGetduration()
 {
     qInfo() << "Total audio duration changed! (duration: " << player->duration() << ")";
+    if (!m_filePath.isEmpty() && player->duration() > 0) {
+        m_durations.insert(m_filePath, player->duration());
+    }
     emit durationChanged(player->duration());
 }
 #endif
@@ -239,12 +446,15 @@ void VlcPalyer::handleEvent(const libvlc_event_t *event, void *data)
         emit userData->playEnd();
         break;
     case libvlc_MediaPlayerTimeChanged:
-        qInfo() << "The current play position has changed!";
-        emit userData->positionChanged(event->u.media_player_time_changed.new_time);
+        //播放线程中频繁触发，不输出日志
+        userData->updatePosition(event->u.media_player_time_changed.new_time);
         break;
     case libvlc_MediaPlayerLengthChanged:
         qInfo() << "Total audio duration changed!";
-        emit userData->durationChanged(event->u.media_duration_changed.new_duration);
+        emit userData->durationChanged(event->u.media_player_length_changed.new_length);
+        break;
+    case libvlc_MediaParsedChanged:
+        QMetaObject::invokeMethod(userData, "onMediaParsed", Qt::QueuedConnection);
         break;
     default:
         break;
@@ -268,6 +478,37 @@ void VlcPalyer::setPosition(qint64 pos)
 #endif
 }
 
+/**
+ * @brief VlcPalyer::setRate
+ * 播放位置和时长仍为媒体时间，进度条不需要换算
+ * @param rate 倍速
+ */
+void VlcPalyer::setRate(double rate)
+{
+    if (rate <= 0) {
+        return;
+    }
+    qInfo() << "Set the audio playback rate.(rate: " << rate << ")";
+    m_rate = rate;
+#ifndef MPV_PLAYENGINE
+    if (m_vlcPlayer) {
+        libvlc_media_player_set_rate(m_vlcPlayer, static_cast<float>(rate));
+    }
+#else
+    //mpv默认开启音调校正，设置的倍速对之后播放的文件同样有效
+    player->setPlaySpeed(rate);
+#endif
+}
+
+/**
+ * @brief VlcPalyer::rate
+ * @return 倍速
+ */
+double VlcPalyer::rate() const
+{
+    return m_rate;
+}
+
 /**
  * @brief VlcPalyer::getState
  * @return 状态
@@ -8,6 +8,13 @@
 #define MPV_PLAYENGINE  ///MPV播放引擎 通过是否定义该宏，来切换采用vlc或者libdmr来播放音频
 
 #include <QObject>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QTimer>
 #ifdef MPV_PLAYENGINE
 #include <player_widget.h>
 #include <player_engine.h>
@@ -17,8 +24,14 @@ using namespace dmr;
 
 struct libvlc_instance_t;
 struct libvlc_media_player_t;
+struct libvlc_media_t;
 struct libvlc_event_t;
 
+/**
+ * @brief The VlcPalyer class
+ * 语音播放，播放引擎在程序运行期间只创建一次，切换语音只更换媒体。
+ * 打开笔记时预先解析笔记中的语音，开始播放时不需要再打开和解析文件
+ */
 class VlcPalyer : public QObject
 {
     Q_OBJECT
@@ -34,12 +47,27 @@ public:
         Error
     };
     Q_ENUM(VlcState)
+    enum {
+        MaxPrefetch = 8, //打开笔记时预先解析的语音数
+        MaxCachedMedia = 16, //缓存的已解析媒体数
+    };
     explicit VlcPalyer(QObject *parent = nullptr);
     ~VlcPalyer();
+    static VlcPalyer *instance();
+    //释放单例，程序退出时调用
+    static void releaseInstance();
+    //预先解析语音文件，已缓存的文件不重复解析
+    void prefetch(const QStringList &paths);
+    //已缓存的语音时长，与durationChanged单位一致，未缓存时返回0
+    qint64 cachedDuration(const QString &path) const;
     //设置播放文件
     void setFilePath(QString path);
     //跳转指定位置，单位:毫秒
     void setPosition(qint64 pos);
+    //设置播放倍速，变速时保持音调不变，切换语音后仍然有效
+    void setRate(double rate);
+    //当前播放倍速
+    double rate() const;
     //播放
     void play ();
     //暂停
@@ -56,6 +84,13 @@ signals:
     void positionChanged(qint64 position);
     //播放完成
     void playEnd();
+private slots:
+    //按界面刷新频率发送播放位置
+    void emitPosition();
+#ifndef MPV_PLAYENGINE
+    //记录已解析媒体的时长
+    void onMediaParsed();
+#endif
 public slots:
 #ifdef MPV_PLAYENGINE
     void onGetCurrentPosition();
@@ -71,19 +106,43 @@ private:
     void detachEvent();
     //事件处理
     static void handleEvent(const libvlc_event_t *event, void *data);
+    //获取缓存的媒体，没有时创建并开始解析
+    libvlc_media_t *cachedMedia(const QString &path);
+#else
+    //记录使用的播放列表文件，未加入时加入播放列表
+    void usePlaylistUrl(const QUrl &url);
+    //播放列表超出数量时移除最早使用的文件
+    void trimPlaylist();
 #endif
+    //记录播放位置，可在播放引擎线程调用
+    void updatePosition(qint64 position);
     //初始化
     void init();
     //释放资源
     void deinit();
+    static VlcPalyer *_instance;
+
     libvlc_instance_t     *m_vlcInst {nullptr};
     libvlc_media_player_t *m_vlcPlayer {nullptr};
+#ifndef MPV_PLAYENGINE
+    QHash<QString, libvlc_media_t *> m_medias; //已解析的媒体
+    QStringList m_mediaOrder; //媒体使用顺序，超出数量时释放最早使用的
+#endif
 #ifdef MPV_PLAYENGINE
     dmr::PlayerEngine* player{nullptr};
     QUrl videoUrl;
+    QList<QUrl> m_playlistUrls; //已加入播放列表的文件，按使用顺序排列
 
     bool m_isChangePlayFile{false};
 #endif
+    QString m_filePath; //当前播放的文件
+    double m_rate {1.0}; //播放倍速
+    QHash<QString, qint64> m_durations; //语音时长缓存
+    QAtomicInteger<qint64> m_position {0}; //最新的播放位置
+    QAtomicInt m_positionNotify {0}; //已投递界面线程处理时为1
+    QElapsedTimer m_positionClock; //上一次发送播放位置的时间
+    QTimer m_positionTimer; //发送间隔未到时延后发送
+    int m_positionInterval {16}; //发送播放位置的最小间隔，单位毫秒
 };
 
 #endif // VLCPALYER_H
@@ -4,10 +4,15 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "vnotea2tmanager.h"
+#include "task/asrchunkworker.h"
 
 #include <DSysInfo>
 
 #include <QDBusError>
+#include <QDir>
+#include <QFile>
+#include <QThreadPool>
+#include <QDebug>
 
 DCORE_USE_NAMESPACE
 
@@ -20,12 +25,22 @@ VNoteA2TManager::VNoteA2TManager(QObject *parent)
 {
 }
 
+VNoteA2TManager::~VNoteA2TManager()
+{
+    stopChunkedAsr();
+}
+
 /**
  * @brief VNoteA2TManager::initSession
  * @return 错误码
  */
 int VNoteA2TManager::initSession()
 {
+    //会话可以复用，连续转写时不再重新创建
+    if (!m_asrInterface.isNull() && m_asrInterface->isValid()) {
+        return 0;
+    }
+
     m_session.reset(new com::iflytek::aiservice::session(
         "com.iflytek.aiservice",
         "/",
@@ -59,12 +74,36 @@ void VNoteA2TManager::startAsr(QString filePath,
                                qint64 fileDuration,
                                QString srcLanguage,
                                QString targetLanguage)
+{
+    //长录音分段转写
+    if (VNoteAsrChunker::needChunk(fileDuration)) {
+        startChunkedAsr(filePath, srcLanguage, targetLanguage);
+        return;
+    }
+
+    ErrorCode error = startSessionAsr(filePath, fileDuration, srcLanguage, targetLanguage);
+    if (Success != error) {
+        emit asrError(error);
+    }
+}
+
+/**
+ * @brief VNoteA2TManager::startSessionAsr
+ * @param filePath 文件路径
+ * @param fileDuration 文件时长
+ * @param srcLanguage 源语言
+ * @param targetLanguage 目标语言
+ * @return 开始转写返回Success
+ */
+VNoteA2TManager::ErrorCode VNoteA2TManager::startSessionAsr(const QString &filePath,
+                                                            qint64 fileDuration,
+                                                            const QString &srcLanguage,
+                                                            const QString &targetLanguage)
 {
     int ret = initSession();
     if (ret != 0) {
-        emit asrError(AudioOther);
         qInfo() << "createSession->errorCode=" << ret;
-        return;
+        return AudioOther;
     }
 
     QVariantMap param;
@@ -85,8 +124,9 @@ void VNoteA2TManager::startAsr(QString filePath,
     if (retStr != CODE_SUCCESS) {
         asrMsg error;
         error.code = retStr;
-        emit asrError(getErrorCode(error));
+        return getErrorCode(error);
     }
+    return Success;
 }
 
 /**
@@ -94,7 +134,24 @@ void VNoteA2TManager::startAsr(QString filePath,
  */
 void VNoteA2TManager::stopAsr()
 {
-    m_asrInterface->stopAsr();
+    if (isChunking()) {
+        stopChunkedAsr();
+        return;
+    }
+
+    if (!m_asrInterface.isNull()) {
+        m_asrInterface->stopAsr();
+    }
+}
+
+/**
+ * @brief VNoteA2TManager::setChunkInOwnSession
+ * 多个转写通道同时分段转写时，避免会话数成倍增加
+ * @param own 是否使用自己的会话
+ */
+void VNoteA2TManager::setChunkInOwnSession(bool own)
+{
+    m_chunkInOwnSession = own;
 }
 
 /**
@@ -109,6 +166,16 @@ void VNoteA2TManager::onNotify(const QString &msg)
 
     qInfo() << "msg:" << msg;
 
+    //自己的会话正在转写分段，结果交给分段处理
+    if (m_runningChunks.contains(this)) {
+        if (CODE_SUCCESS != asrData.code || XF_fail == asrData.status) {
+            onChunkError(this, getErrorCode(asrData));
+        } else if (XF_finish == asrData.status) {
+            onChunkSuccess(this, asrData.text);
+        }
+        return;
+    }
+
     if (CODE_SUCCESS == asrData.code) {
         if (XF_finish == asrData.status) {
             //Finish convertion
@@ -204,3 +271,239 @@ VNoteA2TManager::ErrorCode VNoteA2TManager::getErrorCode(const asrMsg &asrData)
     }
     return error;
 }
+
+/**
+ * @brief VNoteA2TManager::startChunkedAsr
+ * 解码与转写同时进行，先写完的分段先转写
+ * @param filePath 文件路径
+ * @param srcLanguage 源语言
+ * @param targetLanguage 目标语言
+ */
+void VNoteA2TManager::startChunkedAsr(const QString &filePath, const QString &srcLanguage, const QString &targetLanguage)
+{
+    stopChunkedAsr();
+    m_chunkSrcLanguage = srcLanguage;
+    m_chunkTargetLanguage = targetLanguage;
+
+    m_chunkDir.reset(new QTemporaryDir(QDir::tempPath() + "/deepin-voice-note-asr-XXXXXX"));
+    if (!m_chunkDir->isValid()) {
+        qCritical() << __FUNCTION__ << "create chunk dir failed:" << m_chunkDir->errorString();
+        m_chunkDir.reset();
+        emit asrError(AudioDecodeFail);
+        return;
+    }
+
+    m_chunkCanceled.reset(new QAtomicInt(0));
+    m_chunkDecoding = true;
+
+    //线程持有分段目录，取消后线程结束前目录不会删除
+    AsrChunkWorker *worker = new AsrChunkWorker(filePath, m_chunkDir, m_chunkCanceled);
+    worker->setAutoDelete(false);
+    worker->setObjectName("AsrChunkWorker");
+    m_chunkWorker = worker;
+    //停止后旧线程的通知不再处理，线程结束后释放
+    connect(worker, &AsrChunkWorker::chunkReady, this,
+            [this, worker](int index, const QString &path, qint64 start, qint64 end) {
+                if (worker == m_chunkWorker) {
+                    onChunkReady(index, path, start, end);
+                }
+            },
+            Qt::QueuedConnection);
+    connect(worker, &AsrChunkWorker::decodeFinished, this,
+            [this, worker](bool success) {
+                if (worker == m_chunkWorker) {
+                    m_chunkWorker = nullptr;
+                    onChunkDecodeFinished(success);
+                }
+            },
+            Qt::QueuedConnection);
+    connect(worker, &AsrChunkWorker::decodeFinished, worker, &QObject::deleteLater, Qt::QueuedConnection);
+    QThreadPool::globalInstance()->start(worker);
+}
+
+/**
+ * @brief VNoteA2TManager::onChunkReady
+ * @param index 分段序号
+ * @param path 分段文件路径
+ * @param start 开始时间
+ * @param end 结束时间
+ */
+void VNoteA2TManager::onChunkReady(int index, const QString &path, qint64 start, qint64 end)
+{
+    VNoteAsrChunker::Chunk chunk;
+    chunk.start = start;
+    chunk.end = end;
+    chunk.path = path;
+    if (index >= m_chunks.size()) {
+        m_chunks.resize(index + 1);
+    }
+    m_chunks[index] = chunk;
+    m_readyChunks.append(index);
+    dispatchChunks();
+}
+
+/**
+ * @brief VNoteA2TManager::onChunkDecodeFinished
+ * @param success 解码成功
+ */
+void VNoteA2TManager::onChunkDecodeFinished(bool success)
+{
+    m_chunkDecoding = false;
+    if (!success || m_chunks.isEmpty()) {
+        stopChunkedAsr();
+        emit asrError(AudioDecodeFail);
+        return;
+    }
+    checkChunksFinished();
+}
+
+/**
+ * @brief VNoteA2TManager::dispatchChunks
+ * 转写通道按需创建，最多VNoteAsrChunker::MaxChannels个，
+ * 使用自己的会话时分段依次转写
+ */
+void VNoteA2TManager::dispatchChunks()
+{
+    if (m_chunkInOwnSession) {
+        if (!isChunking() || m_readyChunks.isEmpty() || m_runningChunks.contains(this)) {
+            return;
+        }
+        int index = m_readyChunks.takeFirst();
+        const VNoteAsrChunker::Chunk &chunk = m_chunks.at(index);
+        m_runningChunks.insert(this, index);
+        ErrorCode error = startSessionAsr(chunk.path, chunk.end - chunk.start,
+                                          m_chunkSrcLanguage, m_chunkTargetLanguage);
+        if (Success != error) {
+            onChunkError(this, error);
+        }
+        return;
+    }
+
+    while (isChunking() && !m_readyChunks.isEmpty()) {
+        VNoteA2TManager *channel = nullptr;
+        for (VNoteA2TManager *it : m_chunkChannels) {
+            if (!m_runningChunks.contains(it)) {
+                channel = it;
+                break;
+            }
+        }
+        if (nullptr == channel) {
+            if (m_chunkChannels.size() >= VNoteAsrChunker::MaxChannels) {
+                return;
+            }
+            channel = new VNoteA2TManager(this);
+            connect(channel, &VNoteA2TManager::asrSuccess, this, [this, channel](const QString &text) {
+                onChunkSuccess(channel, text);
+            });
+            connect(channel, &VNoteA2TManager::asrError, this, [this, channel](ErrorCode error) {
+                onChunkError(channel, error);
+            });
+            m_chunkChannels.append(channel);
+        }
+
+        int index = m_readyChunks.takeFirst();
+        const VNoteAsrChunker::Chunk &chunk = m_chunks.at(index);
+        m_runningChunks.insert(channel, index);
+        //创建会话失败时同步发出错误，转写在错误处理中结束
+        channel->startAsr(chunk.path, chunk.end - chunk.start, m_chunkSrcLanguage, m_chunkTargetLanguage);
+    }
+}
+
+/**
+ * @brief VNoteA2TManager::onChunkSuccess
+ * @param channel 转写通道
+ * @param text 分段文本
+ */
+void VNoteA2TManager::onChunkSuccess(VNoteA2TManager *channel, const QString &text)
+{
+    if (!m_runningChunks.contains(channel)) {
+        return;
+    }
+
+    VNoteAsrChunker::Chunk &chunk = m_chunks[m_runningChunks.take(channel)];
+    chunk.text = text;
+    chunk.done = true;
+    //已上传的分段不再需要
+    QFile::remove(chunk.path);
+    checkChunksFinished();
+}
+
+/**
+ * @brief VNoteA2TManager::onChunkError
+ * @param channel 转写通道
+ * @param error 错误码
+ */
+void VNoteA2TManager::onChunkError(VNoteA2TManager *channel, ErrorCode error)
+{
+    if (!m_runningChunks.contains(channel)) {
+        return;
+    }
+
+    if (AudioMuteFile == error) {
+        onChunkSuccess(channel, "");
+        return;
+    }
+
+    qWarning() << __FUNCTION__ << "chunk asr failed:" << m_runningChunks.value(channel) << error;
+    stopChunkedAsr();
+    emit asrError(error);
+}
+
+/**
+ * @brief VNoteA2TManager::checkChunksFinished
+ */
+void VNoteA2TManager::checkChunksFinished()
+{
+    if (!isChunking()) {
+        return;
+    }
+
+    bool finished = !m_chunkDecoding && m_readyChunks.isEmpty() && m_runningChunks.isEmpty();
+    for (const VNoteAsrChunker::Chunk &chunk : m_chunks) {
+        finished = finished && chunk.done;
+    }
+    if (!finished) {
+        dispatchChunks();
+        return;
+    }
+
+    QString text = VNoteAsrChunker::stitch(m_chunks);
+    stopChunkedAsr();
+    if (text.isEmpty()) {
+        emit asrError(AudioMuteFile);
+    } else {
+        emit asrSuccess(text);
+    }
+}
+
+/**
+ * @brief VNoteA2TManager::stopChunkedAsr
+ */
+void VNoteA2TManager::stopChunkedAsr()
+{
+    if (!m_chunkCanceled.isNull()) {
+        m_chunkCanceled->storeRelease(1);
+        m_chunkCanceled.reset();
+    }
+    m_chunkWorker = nullptr;
+    m_chunkDecoding = false;
+
+    //先清空任务，通道停止时同步发出的信号不再处理
+    QList<VNoteA2TManager *> channels = m_runningChunks.keys();
+    m_runningChunks.clear();
+    for (VNoteA2TManager *channel : channels) {
+        channel->stopAsr();
+    }
+    m_readyChunks.clear();
+    m_chunks.clear();
+    m_chunkDir.reset();
+}
+
+/**
+ * @brief VNoteA2TManager::isChunking
+ * @return 正在分段转写返回true
+ */
+bool VNoteA2TManager::isChunking() const
+{
+    return !m_chunkCanceled.isNull();
+}
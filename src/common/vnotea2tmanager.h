@@ -6,7 +6,12 @@
 #ifndef VNOTEA2TMANAGER_H
 #define VNOTEA2TMANAGER_H
 
+#include "vnoteasrchunker.h"
+
 #include <QObject>
+#include <QHash>
+#include <QSharedPointer>
+#include <QTemporaryDir>
 
 #include <com_iflytek_aiservice_session.h>
 #include <com_iflytek_aiservice_asr.h>
@@ -18,16 +23,22 @@ struct asrMsg {
     QString text;
 };
 
+class AsrChunkWorker;
+
 class VNoteA2TManager : public QObject
 {
     Q_OBJECT
 public:
     explicit VNoteA2TManager(QObject *parent = nullptr);
+    ~VNoteA2TManager() override;
     /*
      * Reference AIService接口及错误码定义.doc for detail
      *
      *    @filePath     (Needed) Max 5 hours audio file
-     *    @fileDuration (Needed) Audio file length in ms
+     *    @fileDuration (Needed) Audio file length in ms, audio longer than
+     *                  VNoteAsrChunker::ChunkThresholdMs is split at silence
+     *                  and the chunks are converted in parallel, or one by one
+     *                  in the own session, see setChunkInOwnSession
      *    @srcLanguage  (Option) Only support cn, en.Default language=cn
      *    @targetLanguage (Option) Same as srcLanguage
      *
@@ -37,6 +48,8 @@ public:
                   QString srcLanguage = "", QString targetLanguage = "");
 
     void stopAsr();
+    //分段依次使用自己的会话转写，不额外创建会话，批量转写时使用
+    void setChunkInOwnSession(bool own);
 
     //Reference AIService接口及错误码定义.doc for detail
     enum ErrorCode {
@@ -66,8 +79,30 @@ protected:
     void asrJsonParser(const QString &msg, asrMsg &asrData);
     //获取错误类型
     ErrorCode getErrorCode(const asrMsg &asrData);
-    //初始化语音转写模块，初始化相关dbus连接
+    //初始化语音转写模块，初始化相关dbus连接，已有可用会话时直接复用
     int initSession();
+    //使用自己的会话转写文件，失败时返回错误码
+    ErrorCode startSessionAsr(const QString &filePath, qint64 fileDuration,
+                              const QString &srcLanguage, const QString &targetLanguage);
+
+    //分段转写长录音，结果按顺序拼接后发出
+    void startChunkedAsr(const QString &filePath, const QString &srcLanguage, const QString &targetLanguage);
+    //一个分段写入完成，等待转写
+    void onChunkReady(int index, const QString &path, qint64 start, qint64 end);
+    //录音解码结束
+    void onChunkDecodeFinished(bool success);
+    //空闲的转写通道开始转写下一个分段
+    void dispatchChunks();
+    //分段转写成功
+    void onChunkSuccess(VNoteA2TManager *channel, const QString &text);
+    //分段转写失败，静音分段视为没有文本，其他错误结束整个转写
+    void onChunkError(VNoteA2TManager *channel, ErrorCode error);
+    //所有分段都已转写时拼接结果
+    void checkChunksFinished();
+    //停止分段转写，清理分段文件
+    void stopChunkedAsr();
+    //是否正在分段转写
+    bool isChunking() const;
 
 protected:
     //XunFei message code string
@@ -96,6 +131,18 @@ protected:
 
     QScopedPointer<com::iflytek::aiservice::session> m_session;
     QScopedPointer<com::iflytek::aiservice::asr> m_asrInterface;
+
+    QVector<VNoteAsrChunker::Chunk> m_chunks; //分段及转写结果
+    QList<int> m_readyChunks; //等待转写的分段
+    QList<VNoteA2TManager *> m_chunkChannels; //分段转写通道，每个通道复用自己的会话
+    QHash<VNoteA2TManager *, int> m_runningChunks; //正在转写的分段
+    QSharedPointer<QTemporaryDir> m_chunkDir; //分段文件目录，转写结束且分段线程释放后删除
+    QSharedPointer<QAtomicInt> m_chunkCanceled; //通知分段线程停止解码
+    AsrChunkWorker *m_chunkWorker {nullptr}; //正在解码的分段线程，只用于区分结束的线程
+    bool m_chunkDecoding {false}; //分段线程是否还在解码
+    bool m_chunkInOwnSession {false}; //分段是否依次使用自己的会话转写
+    QString m_chunkSrcLanguage {""}; //分段转写的源语言
+    QString m_chunkTargetLanguage {""}; //分段转写的目标语言
 };
 
 #endif // VNOTEA2TMANAGER_H
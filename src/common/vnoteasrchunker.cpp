@@ -0,0 +1,105 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoteasrchunker.h"
+
+#include <QStringList>
+#include <QTime>
+
+/**
+ * @brief VNoteAsrChunker::needChunk
+ * @param duration 录音时长，单位毫秒
+ * @return 需要分段返回true
+ */
+bool VNoteAsrChunker::needChunk(qint64 duration)
+{
+    return duration > ChunkThresholdMs;
+}
+
+/**
+ * @brief VNoteAsrChunker::stitch
+ * 没有转写文本的分段（静音）不输出
+ * @param chunks 分段
+ * @return 拼接后的文本
+ */
+QString VNoteAsrChunker::stitch(const QVector<Chunk> &chunks)
+{
+    if (1 == chunks.size()) {
+        return chunks.first().text.trimmed();
+    }
+
+    QStringList lines;
+    for (const Chunk &chunk : chunks) {
+        QString text = chunk.text.trimmed();
+        if (!text.isEmpty()) {
+            lines.append(QString("[%1] %2").arg(timestamp(chunk.start)).arg(text));
+        }
+    }
+    return lines.join("\n");
+}
+
+/**
+ * @brief VNoteAsrChunker::timestamp
+ * @param ms 时间，单位毫秒
+ * @return 一小时以内为mm:ss，否则为h:mm:ss
+ */
+QString VNoteAsrChunker::timestamp(qint64 ms)
+{
+    qint64 seconds = ms / 1000;
+    QString time = QString("%1:%2")
+                       .arg(seconds / 60 % 60, 2, 10, QChar('0'))
+                       .arg(seconds % 60, 2, 10, QChar('0'));
+    if (seconds >= 3600) {
+        time.prepend(QString("%1:").arg(seconds / 3600));
+    }
+    return time;
+}
+
+/**
+ * @brief VNoteAsrChunker::reset
+ */
+void VNoteAsrChunker::reset()
+{
+    m_activity.reset(VNoteVoiceActivity::KeepSilence);
+    m_frames = 0;
+    m_chunkStart = 0;
+}
+
+/**
+ * @brief VNoteAsrChunker::process
+ * @param data 单声道采样
+ * @param frames 帧数
+ * @return 需要切分返回true
+ */
+bool VNoteAsrChunker::process(const qint16 *data, int frames)
+{
+    if (nullptr == data || frames <= 0) {
+        return false;
+    }
+
+    VNoteAudioLevels levels;
+    VNoteAudioLevel::measure(data, frames, 1, levels);
+    m_activity.process(levels, frames, SampleRate);
+    m_frames += frames;
+
+    qint64 pos = position();
+    qint64 length = pos - m_chunkStart;
+    //语音段包含语音结束后的延时，静音从语音段结束开始计算
+    bool silent = pos - qMax(m_activity.lastSpeechEnd(), m_chunkStart) >= CutSilenceMs;
+    if (length >= MaxChunkMs || (length >= MinChunkMs && silent)) {
+        m_chunkStart = pos;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief VNoteAsrChunker::position
+ * @return 已处理的时长
+ */
+qint64 VNoteAsrChunker::position() const
+{
+    return m_frames * 1000 / SampleRate;
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEASRCHUNKER_H
+#define VNOTEASRCHUNKER_H
+
+#include "vnotevoiceactivity.h"
+#include "globaldef.h"
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The VNoteAsrChunker class
+ * 长录音分段转写的切分与拼接，解码后的采样依次送入，
+ * 分段达到最短时长后在静音处切分，没有静音时在最长时长处切分，
+ * 各分段的转写结果按顺序拼接，并在每段前标注开始时间
+ */
+class VNoteAsrChunker
+{
+public:
+    enum {
+        SampleRate = 16000, //分段音频的采样率，单声道S16
+        MinChunkMs = 3 * 60 * 1000, //分段最短时长，之后遇到静音即切分
+        MaxChunkMs = 5 * 60 * 1000, //分段最长时长，没有静音时强制切分
+        ChunkThresholdMs = 6 * 60 * 1000, //超过该时长的录音分段转写
+        CutSilenceMs = 200, //语音段结束后持续该时长的静音才切分
+        MaxChannels = 2, //同时转写的分段数
+    };
+
+    //一个分段及其转写结果
+    struct Chunk {
+        qint64 start {0}; //开始时间，单位毫秒
+        qint64 end {0}; //结束时间，单位毫秒
+        QString path {""}; //分段音频文件
+        QString text {""}; //转写文本
+        bool done {false}; //是否已转写
+    };
+
+    //录音是否需要分段转写
+    static bool needChunk(qint64 duration);
+    //按顺序拼接各分段的转写文本，多个分段时每段前标注开始时间
+    static QString stitch(const QVector<Chunk> &chunks);
+    //分段开始时间的显示格式
+    static QString timestamp(qint64 ms);
+
+    //开始新的切分
+    void reset();
+    //处理一段单声道采样，返回true时在这段采样之后切分
+    bool process(const qint16 *data, int frames);
+    //已处理的时长，单位毫秒
+    qint64 position() const;
+
+private:
+    VNoteVoiceActivity m_activity; //检测语音段，确定静音位置
+    qint64 m_frames {0}; //已处理的帧数
+    qint64 m_chunkStart {0}; //当前分段开始时间，单位毫秒
+};
+
+//分段不超过服务的单次转写时长，且不会被再次分段
+static_assert(VNoteAsrChunker::MaxChunkMs < VNoteAsrChunker::ChunkThresholdMs
+                  && VNoteAsrChunker::ChunkThresholdMs <= MAX_A2T_AUDIO_LEN_MS,
+              "invalid asr chunk duration");
+
+#endif // VNOTEASRCHUNKER_H
@@ -0,0 +1,338 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoteasrqueue.h"
+#include "vnotea2tmanager.h"
+#include "vnotedatamanager.h"
+#include "vnoteitem.h"
+#include "metadataparser.h"
+#include "db/vnoteasrjoboper.h"
+
+#include <QFile>
+#include <QDebug>
+
+VNoteAsrQueue *VNoteAsrQueue::_instance = nullptr;
+
+/**
+ * @brief VNoteAsrQueue::VNoteAsrQueue
+ * @param parent
+ */
+VNoteAsrQueue::VNoteAsrQueue(QObject *parent)
+    : QObject(parent)
+{
+    m_retryTimer.setSingleShot(true);
+    m_retryTimer.setInterval(RetryDelay);
+    connect(&m_retryTimer, &QTimer::timeout, this, &VNoteAsrQueue::dispatch);
+}
+
+/**
+ * @brief VNoteAsrQueue::instance
+ * @return 单例对象
+ */
+VNoteAsrQueue *VNoteAsrQueue::instance()
+{
+    if (nullptr == _instance) {
+        _instance = new VNoteAsrQueue();
+    }
+
+    return _instance;
+}
+
+/**
+ * @brief VNoteAsrQueue::enqueue
+ * 先写入数据库再开始转写，转写过程中退出程序不会丢失任务
+ * @param jobs 任务列表
+ * @return 新加入的任务数
+ */
+int VNoteAsrQueue::enqueue(const VNoteAsrJobs &jobs)
+{
+    VNoteAsrJobs newJobs;
+    for (const VNoteAsrJob &job : jobs) {
+        if (!m_voicePaths.contains(job.voicePath)) {
+            newJobs.append(job);
+        }
+    }
+
+    if (!VNoteAsrJobOper::addJobs(newJobs)) {
+        qWarning() << __FUNCTION__ << "save asr jobs failed:" << newJobs.size();
+    }
+    return appendJobs(newJobs);
+}
+
+/**
+ * @brief VNoteAsrQueue::restore
+ * @return 恢复的任务数
+ */
+int VNoteAsrQueue::restore()
+{
+    VNoteAsrJobs jobs;
+    if (!VNoteAsrJobOper::loadJobs(jobs)) {
+        return 0;
+    }
+
+    int count = appendJobs(jobs);
+    if (count > 0) {
+        qInfo() << __FUNCTION__ << "restored asr jobs:" << count;
+    }
+    return count;
+}
+
+/**
+ * @brief VNoteAsrQueue::cancel
+ */
+void VNoteAsrQueue::cancel()
+{
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    VNoteAsrJobOper::removeJobs(m_pending);
+    for (const VNoteAsrJob &job : m_pending) {
+        m_voicePaths.remove(job.voicePath);
+    }
+    m_total -= m_pending.size();
+    m_pending.clear();
+    m_retryTimer.stop();
+
+    emit progressChanged(m_succeeded + m_failed + m_deferred, m_total);
+    if (m_running.isEmpty()) {
+        emit queueFinished(m_succeeded, m_failed, m_deferred);
+    }
+}
+
+/**
+ * @brief VNoteAsrQueue::cancel
+ * 单条转写前调用，避免与批量转写重复插入文本
+ * @param voicePath 语音文件路径
+ * @return 语音不在队列中或任务已取消返回true
+ */
+bool VNoteAsrQueue::cancel(const QString &voicePath)
+{
+    if (!m_voicePaths.contains(voicePath)) {
+        return true;
+    }
+
+    for (int i = 0; i < m_pending.size(); i++) {
+        if (m_pending.at(i).voicePath != voicePath) {
+            continue;
+        }
+        VNoteAsrJobOper::removeJobs(VNoteAsrJobs() << m_pending.takeAt(i));
+        m_voicePaths.remove(voicePath);
+        m_total--;
+        emit progressChanged(m_succeeded + m_failed + m_deferred, m_total);
+        if (m_pending.isEmpty() && m_running.isEmpty()) {
+            m_retryTimer.stop();
+            emit queueFinished(m_succeeded, m_failed, m_deferred);
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief VNoteAsrQueue::contains
+ * @param voicePath 语音文件路径
+ * @return 在队列中返回true
+ */
+bool VNoteAsrQueue::contains(const QString &voicePath) const
+{
+    return m_voicePaths.contains(voicePath);
+}
+
+/**
+ * @brief VNoteAsrQueue::pendingCount
+ * @return 等待和正在转写的任务数
+ */
+int VNoteAsrQueue::pendingCount() const
+{
+    return m_pending.size() + m_running.size();
+}
+
+/**
+ * @brief VNoteAsrQueue::jobsFromNote
+ * @param note 笔记
+ * @return 需要转写的语音
+ */
+VNoteAsrJobs VNoteAsrQueue::jobsFromNote(const VNoteItem *note)
+{
+    VNoteAsrJobs jobs;
+    if (nullptr == note) {
+        return jobs;
+    }
+    MetaDataParser dataParser;
+    for (const QString &json : note->getVoiceJsons()) {
+        VNVoiceBlock voice;
+        if (!dataParser.parse(json, &voice)
+            || !voice.blockText.isEmpty()
+            || !QFile::exists(voice.voicePath)) {
+            continue;
+        }
+        VNoteAsrJob job;
+        job.voicePath = voice.voicePath;
+        job.noteId = note->noteId;
+        job.duration = voice.voiceSize;
+        jobs.append(job);
+    }
+    return jobs;
+}
+
+/**
+ * @brief VNoteAsrQueue::appendJobs
+ * @param jobs 任务列表
+ * @return 新加入的任务数
+ */
+int VNoteAsrQueue::appendJobs(const VNoteAsrJobs &jobs)
+{
+    //上一轮任务已全部结束，重新计算进度
+    if (m_pending.isEmpty() && m_running.isEmpty()) {
+        m_total = 0;
+        m_succeeded = 0;
+        m_failed = 0;
+        m_deferred = 0;
+        m_networkFailures = 0;
+    }
+
+    int count = 0;
+    for (const VNoteAsrJob &job : jobs) {
+        if (job.voicePath.isEmpty() || m_voicePaths.contains(job.voicePath)) {
+            continue;
+        }
+        m_voicePaths.insert(job.voicePath);
+        m_pending.append(job);
+        count++;
+    }
+
+    if (count > 0) {
+        m_total += count;
+        emit progressChanged(m_succeeded + m_failed + m_deferred, m_total);
+        QMetaObject::invokeMethod(this, "dispatch", Qt::QueuedConnection);
+    }
+    return count;
+}
+
+/**
+ * @brief VNoteAsrQueue::idleWorker
+ * 转写通道按需创建，最多MaxConcurrent个
+ * @return 空闲的转写通道
+ */
+VNoteA2TManager *VNoteAsrQueue::idleWorker()
+{
+    for (VNoteA2TManager *worker : m_workers) {
+        if (!m_running.contains(worker)) {
+            return worker;
+        }
+    }
+    if (m_workers.size() >= MaxConcurrent) {
+        return nullptr;
+    }
+
+    VNoteA2TManager *worker = new VNoteA2TManager(this);
+    //长录音的分段依次转写，转写通道不再额外创建会话
+    worker->setChunkInOwnSession(true);
+    connect(worker, &VNoteA2TManager::asrSuccess, this, [this, worker](const QString &text) {
+        if (m_running.contains(worker)) {
+            m_networkFailures = 0;
+            emit jobFinished(m_running.value(worker), text);
+            finishJob(worker, true);
+        }
+    });
+    connect(worker, &VNoteA2TManager::asrError, this, [this, worker](VNoteA2TManager::ErrorCode error) {
+        onJobError(worker, error);
+    });
+    m_workers.append(worker);
+    return worker;
+}
+
+/**
+ * @brief VNoteAsrQueue::onJobError
+ * 网络错误时任务放回队首，暂停一段时间后继续；
+ * 连续网络错误达到上限时不再重试，避免离线时队列一直无法结束
+ * @param worker 转写通道
+ * @param error 错误码
+ */
+void VNoteAsrQueue::onJobError(VNoteA2TManager *worker, int error)
+{
+    if (!m_running.contains(worker)) {
+        return;
+    }
+    if (VNoteA2TManager::NetworkError == error) {
+        if (++m_networkFailures < MaxNetworkRetries) {
+            m_pending.prepend(m_running.take(worker));
+            m_retryTimer.start();
+            return;
+        }
+        qWarning() << "asr queue paused after network errors:" << m_networkFailures;
+        deferJobs(worker);
+        return;
+    }
+    m_networkFailures = 0;
+    qWarning() << "asr job failed:" << m_running.value(worker).voicePath << error;
+    finishJob(worker, false);
+}
+
+/**
+ * @brief VNoteAsrQueue::deferJobs
+ * 只从内存队列中移除，数据库中的任务在下次启动时由restore恢复
+ * @param worker 出错的转写通道，其他通道正在转写的任务继续完成
+ */
+void VNoteAsrQueue::deferJobs(VNoteA2TManager *worker)
+{
+    m_pending.prepend(m_running.take(worker));
+    for (const VNoteAsrJob &job : m_pending) {
+        m_voicePaths.remove(job.voicePath);
+    }
+    m_deferred += m_pending.size();
+    m_pending.clear();
+    m_retryTimer.stop();
+
+    emit progressChanged(m_succeeded + m_failed + m_deferred, m_total);
+    if (m_running.isEmpty()) {
+        emit queueFinished(m_succeeded, m_failed, m_deferred);
+    }
+}
+
+/**
+ * @brief VNoteAsrQueue::dispatch
+ */
+void VNoteAsrQueue::dispatch()
+{
+    VNoteA2TManager *worker = nullptr;
+    while (!m_retryTimer.isActive() && !m_pending.isEmpty() && nullptr != (worker = idleWorker())) {
+        VNoteAsrJob job = m_pending.takeFirst();
+        m_running.insert(worker, job);
+        //笔记已删除或语音文件已不存在时不再转写
+        if (nullptr == VNoteDataManager::instance()->findNote(job.noteId) || !QFile::exists(job.voicePath)) {
+            finishJob(worker, false);
+            continue;
+        }
+        //创建会话失败时同步发出错误，任务在错误处理中结束
+        worker->startAsr(job.voicePath, job.duration);
+    }
+}
+
+/**
+ * @brief VNoteAsrQueue::finishJob
+ * @param worker 转写通道
+ * @param success 是否转写成功
+ */
+void VNoteAsrQueue::finishJob(VNoteA2TManager *worker, bool success)
+{
+    VNoteAsrJob job = m_running.take(worker);
+    m_voicePaths.remove(job.voicePath);
+    VNoteAsrJobOper::removeJobs(VNoteAsrJobs() << job);
+
+    if (success) {
+        m_succeeded++;
+    } else {
+        m_failed++;
+    }
+    emit progressChanged(m_succeeded + m_failed + m_deferred, m_total);
+
+    if (m_pending.isEmpty() && m_running.isEmpty()) {
+        emit queueFinished(m_succeeded, m_failed, m_deferred);
+        return;
+    }
+    QMetaObject::invokeMethod(this, "dispatch", Qt::QueuedConnection);
+}
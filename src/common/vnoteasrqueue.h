@@ -0,0 +1,91 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEASRQUEUE_H
+#define VNOTEASRQUEUE_H
+
+#include "common/datatypedef.h"
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+
+class VNoteA2TManager;
+class VNoteItem;
+
+/**
+ * @brief The VNoteAsrQueue class
+ * 批量语音转文字队列，任务保存在数据库中，程序重启后继续转写。
+ * 同时转写的任务数受限，每个转写通道复用自己的会话，转写结果由调用方写入笔记
+ */
+class VNoteAsrQueue : public QObject
+{
+    Q_OBJECT
+public:
+    explicit VNoteAsrQueue(QObject *parent = nullptr);
+
+    enum {
+        MaxConcurrent = 2, //同时转写的任务数
+        RetryDelay = 30000, //网络错误后暂停转写的时长，单位毫秒
+        MaxNetworkRetries = 3, //连续网络错误的次数上限，达到后暂停队列，任务留到下次启动
+    };
+
+    static VNoteAsrQueue *instance();
+
+    //加入任务，已在队列中的语音忽略，返回新加入的任务数
+    int enqueue(const VNoteAsrJobs &jobs);
+    //恢复上次退出时未完成的任务，在笔记数据加载完成后调用
+    int restore();
+    //取消所有未开始的任务，正在转写的任务完成后结束
+    void cancel();
+    //取消语音未开始的任务，任务正在转写时返回false
+    bool cancel(const QString &voicePath);
+    //语音是否在队列中
+    bool contains(const QString &voicePath) const;
+    //未完成的任务数
+    int pendingCount() const;
+    //笔记中需要转写的语音，已有转写文本或文件不存在的语音不转写，长录音由转写通道分段转写
+    static VNoteAsrJobs jobsFromNote(const VNoteItem *note);
+
+signals:
+    //任务转写成功
+    void jobFinished(const VNoteAsrJob &job, const QString &text);
+    //进度改变，total为队列空闲后加入的任务总数
+    void progressChanged(int finished, int total);
+    //队列中的任务全部结束，deferred为网络不可用时留到下次启动的任务数
+    void queueFinished(int succeeded, int failed, int deferred);
+
+private slots:
+    //空闲的转写通道开始下一个任务
+    void dispatch();
+
+private:
+    //转写通道的任务结束，从数据库中删除任务
+    void finishJob(VNoteA2TManager *worker, bool success);
+    //转写通道出错，网络错误时重试，连续出错达到上限后暂停队列
+    void onJobError(VNoteA2TManager *worker, int error);
+    //暂停队列，未完成的任务保留在数据库中，下次启动时恢复
+    void deferJobs(VNoteA2TManager *worker);
+    //加入内存队列，不写数据库
+    int appendJobs(const VNoteAsrJobs &jobs);
+    //获取空闲的转写通道，没有时返回nullptr
+    VNoteA2TManager *idleWorker();
+
+    static VNoteAsrQueue *_instance;
+
+    VNoteAsrJobs m_pending; //等待转写的任务
+    QHash<VNoteA2TManager *, VNoteAsrJob> m_running; //正在转写的任务
+    QList<VNoteA2TManager *> m_workers; //转写通道
+    QSet<QString> m_voicePaths; //队列中所有任务的语音
+    QTimer m_retryTimer; //网络错误后延时继续
+    int m_total {0};
+    int m_succeeded {0};
+    int m_failed {0};
+    int m_deferred {0}; //留到下次启动的任务数
+    int m_networkFailures {0}; //连续网络错误次数
+};
+
+#endif // VNOTEASRQUEUE_H
@@ -0,0 +1,181 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoteattachmentstore.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QTemporaryFile>
+#include <QDebug>
+
+/**
+ * @brief VNoteAttachmentStore::imageDir
+ * @return 笔记图片目录
+ */
+QString VNoteAttachmentStore::imageDir()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/images";
+}
+
+/**
+ * @brief VNoteAttachmentStore::isStoredFile
+ * @param path 文件路径
+ * @return 文件名为内容哈希时返回true
+ */
+bool VNoteAttachmentStore::isStoredFile(const QString &path)
+{
+    QString baseName = QFileInfo(path).completeBaseName();
+    if (baseName.size() != HashLength) {
+        return false;
+    }
+    for (const QChar &c : baseName) {
+        if (!c.isDigit() && (c < QChar('a') || c > QChar('f'))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief VNoteAttachmentStore::findStored
+ * @param dirPath 存储目录
+ * @param hash 内容哈希
+ * @return 已有文件路径，不存在时为空
+ */
+QString VNoteAttachmentStore::findStored(const QString &dirPath, const QString &hash)
+{
+    QDir dir(dirPath);
+    //相同内容不同后缀时也使用已有文件，录音的波形文件（<哈希>.<后缀>.peaks）等附属文件除外
+    for (const QString &name : dir.entryList(QStringList(hash + ".*"), QDir::Files)) {
+        if (QFileInfo(name).completeBaseName() == hash) {
+            return dir.filePath(name);
+        }
+    }
+    return QString();
+}
+
+/**
+ * @brief VNoteAttachmentStore::importFile
+ * 复制的同时计算哈希，文件只读取一次
+ * @param srcPath 源文件路径
+ * @param dirPath 存储目录
+ * @return 存储路径
+ */
+QString VNoteAttachmentStore::importFile(const QString &srcPath, const QString &dirPath)
+{
+    QFile srcFile(srcPath);
+    if (!srcFile.open(QIODevice::ReadOnly)) {
+        qWarning() << __FUNCTION__ << "open file failed:" << srcPath << srcFile.errorString();
+        return QString();
+    }
+
+    QDir().mkpath(dirPath);
+    QTemporaryFile tempFile(dirPath + "/.import_XXXXXX");
+    if (!tempFile.open()) {
+        qWarning() << __FUNCTION__ << "create temp file failed:" << dirPath << tempFile.errorString();
+        return QString();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    while (!srcFile.atEnd()) {
+        QByteArray chunk = srcFile.read(CopyChunkSize);
+        if (chunk.isEmpty() || tempFile.write(chunk) != chunk.size()) {
+            qWarning() << __FUNCTION__ << "copy file failed:" << srcPath;
+            return QString();
+        }
+        hash.addData(chunk);
+    }
+    tempFile.flush();
+
+    QString hashName = hash.result().toHex();
+    QString storedPath = findStored(dirPath, hashName);
+    if (storedPath.isEmpty()) {
+        storedPath = QString("%1/%2.%3").arg(dirPath).arg(hashName).arg(QFileInfo(srcPath).suffix().toLower());
+        tempFile.setAutoRemove(false);
+        tempFile.close();
+        //并发导入相同内容时目标文件可能已存在
+        if (!QFile::rename(tempFile.fileName(), storedPath)) {
+            QFile::remove(tempFile.fileName());
+            if (!QFile::exists(storedPath)) {
+                return QString();
+            }
+        }
+    }
+
+    return storedPath;
+}
+
+/**
+ * @brief VNoteAttachmentStore::importData
+ * @param data 文件数据
+ * @param dirPath 存储目录
+ * @param suffix 文件后缀
+ * @return 存储路径
+ */
+QString VNoteAttachmentStore::importData(const QByteArray &data, const QString &dirPath, const QString &suffix)
+{
+    QString hashName = QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex();
+    QString storedPath = findStored(dirPath, hashName);
+    if (storedPath.isEmpty()) {
+        QDir().mkpath(dirPath);
+        QTemporaryFile tempFile(dirPath + "/.import_XXXXXX");
+        if (!tempFile.open() || tempFile.write(data) != data.size()) {
+            qWarning() << __FUNCTION__ << "write temp file failed:" << dirPath << tempFile.errorString();
+            return QString();
+        }
+        tempFile.flush();
+
+        storedPath = QString("%1/%2.%3").arg(dirPath).arg(hashName).arg(suffix.toLower());
+        tempFile.setAutoRemove(false);
+        tempFile.close();
+        if (!QFile::rename(tempFile.fileName(), storedPath)) {
+            QFile::remove(tempFile.fileName());
+            if (!QFile::exists(storedPath)) {
+                return QString();
+            }
+        }
+    }
+
+    return storedPath;
+}
+
+/**
+ * @brief VNoteAttachmentStore::adoptFile
+ * @param path 文件路径
+ * @return 存储路径
+ */
+QString VNoteAttachmentStore::adoptFile(const QString &path)
+{
+    if (isStoredFile(path)) {
+        return path;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return path;
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file)) {
+        return path;
+    }
+    file.close();
+
+    QFileInfo info(path);
+    QString hashName = hash.result().toHex();
+    QString storedPath = findStored(info.absolutePath(), hashName);
+    if (storedPath.isEmpty()) {
+        storedPath = QString("%1/%2.%3").arg(info.absolutePath()).arg(hashName).arg(info.suffix().toLower());
+        if (!QFile::rename(path, storedPath)) {
+            qWarning() << __FUNCTION__ << "rename file failed:" << path;
+            return path;
+        }
+    } else {
+        QFile::remove(path);
+    }
+
+    return storedPath;
+}
@@ -0,0 +1,41 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEATTACHMENTSTORE_H
+#define VNOTEATTACHMENTSTORE_H
+
+#include <QByteArray>
+#include <QString>
+
+/**
+ * @brief The VNoteAttachmentStore class
+ * 笔记附件存储，图片和录音文件以内容哈希命名，相同内容只保存一份，
+ * 文件是否仍被引用以笔记内容为准，由启动清理统一判断
+ */
+class VNoteAttachmentStore
+{
+public:
+    enum {
+        HashLength = 40, //sha1十六进制长度
+        CopyChunkSize = 256 * 1024, //流式复制的块大小
+    };
+
+    //笔记图片目录
+    static QString imageDir();
+    //流式复制文件并计算哈希，内容已存在时直接返回已有文件，失败返回空
+    static QString importFile(const QString &srcPath, const QString &dirPath);
+    //保存数据，内容已存在时直接返回已有文件，失败返回空
+    static QString importData(const QByteArray &data, const QString &dirPath, const QString &suffix);
+    //将目录下的文件按内容哈希重命名，用于录音等已在目录中生成的文件，失败返回原路径
+    static QString adoptFile(const QString &path);
+    //文件是否以内容哈希命名
+    static bool isStoredFile(const QString &path);
+
+private:
+    //查找相同内容的已有文件
+    static QString findStored(const QString &dirPath, const QString &hash);
+};
+
+#endif // VNOTEATTACHMENTSTORE_H
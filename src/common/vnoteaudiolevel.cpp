@@ -0,0 +1,488 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoteaudiolevel.h"
+
+#include <QAudioFormat>
+#include <QSysInfo>
+#include <QtMath>
+
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#ifdef __GNUC__
+//AVX2在运行时检测，只编译对应函数
+#include <immintrin.h>
+#define VNOTE_HAS_AVX2
+#define VNOTE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VNOTE_HAS_NEON
+#endif
+
+//满幅值，整数采样归一化到[-1,1]
+static const float S16Scale = 1.0f / 32768.0f;
+static const float S32Scale = 1.0f / 2147483648.0f;
+
+static inline float sampleValue(qint32 value)
+{
+    return value * S32Scale;
+}
+
+static inline float sampleValue(float value)
+{
+    return value;
+}
+
+/**
+ * @brief windowS16Scalar
+ * S16的绝对值饱和到32767，与向量实现一致
+ * @param samples 采样数据
+ * @param count 采样数
+ * @param peak 绝对值峰值
+ * @param sumSquares 平方和
+ */
+static void windowS16Scalar(const qint16 *samples, int count, int &peak, qint64 &sumSquares)
+{
+    int maxAbs = 0;
+    qint64 sum = 0;
+    for (int i = 0; i < count; i++) {
+        int a = qMin(qAbs(static_cast<int>(samples[i])), 32767);
+        maxAbs = qMax(maxAbs, a);
+        sum += a * a;
+    }
+    peak = maxAbs;
+    sumSquares = sum;
+}
+
+/**
+ * @brief windowFloatScalar
+ * @param samples 采样数据，S32或F32
+ * @param count 采样数
+ * @param peak 归一化的绝对值峰值
+ * @param sumSquares 归一化的平方和
+ */
+template<typename T>
+static void windowFloatScalar(const T *samples, int count, float &peak, double &sumSquares)
+{
+    float maxAbs = 0;
+    double sum = 0;
+    for (int i = 0; i < count; i++) {
+        float a = qAbs(sampleValue(samples[i]));
+        maxAbs = qMax(maxAbs, a);
+        sum += static_cast<double>(a) * a;
+    }
+    peak = maxAbs;
+    sumSquares = sum;
+}
+
+#ifdef __SSE2__
+/**
+ * @brief windowS16Sse2
+ * 一次处理8个采样
+ */
+static void windowS16Sse2(const qint16 *samples, int count, int &peak, qint64 &sumSquares)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i maxAbs = zero;
+    __m128i sum = zero;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(samples + i));
+        //饱和减法，-32768的绝对值为32767
+        __m128i a = _mm_max_epi16(x, _mm_subs_epi16(zero, x));
+        maxAbs = _mm_max_epi16(maxAbs, a);
+        //相邻两个采样的平方和不超过2*32767^2，不会溢出int32
+        __m128i squares = _mm_madd_epi16(a, a);
+        sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(squares, zero));
+        sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(squares, zero));
+    }
+
+    qint16 maxLanes[8];
+    qint64 sumLanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(maxLanes), maxAbs);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(sumLanes), sum);
+
+    windowS16Scalar(samples + i, count - i, peak, sumSquares);
+    for (qint16 lane : maxLanes) {
+        peak = qMax(peak, static_cast<int>(lane));
+    }
+    sumSquares += sumLanes[0] + sumLanes[1];
+}
+
+static inline __m128 loadSse2(const float *samples)
+{
+    return _mm_loadu_ps(samples);
+}
+
+static inline __m128 loadSse2(const qint32 *samples)
+{
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(samples));
+    return _mm_mul_ps(_mm_cvtepi32_ps(x), _mm_set1_ps(S32Scale));
+}
+
+/**
+ * @brief windowFloatSse2
+ * 一次处理4个采样
+ */
+template<typename T>
+static void windowFloatSse2(const T *samples, int count, float &peak, double &sumSquares)
+{
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 maxAbs = _mm_setzero_ps();
+    __m128 sum = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 a = _mm_and_ps(loadSse2(samples + i), absMask);
+        maxAbs = _mm_max_ps(maxAbs, a);
+        sum = _mm_add_ps(sum, _mm_mul_ps(a, a));
+    }
+
+    float maxLanes[4];
+    float sumLanes[4];
+    _mm_storeu_ps(maxLanes, maxAbs);
+    _mm_storeu_ps(sumLanes, sum);
+
+    windowFloatScalar(samples + i, count - i, peak, sumSquares);
+    for (int j = 0; j < 4; j++) {
+        peak = qMax(peak, maxLanes[j]);
+        sumSquares += sumLanes[j];
+    }
+}
+#endif
+
+#ifdef VNOTE_HAS_AVX2
+/**
+ * @brief windowS16Avx2
+ * 一次处理16个采样
+ */
+VNOTE_TARGET_AVX2 static void windowS16Avx2(const qint16 *samples, int count, int &peak, qint64 &sumSquares)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i maxAbs = zero;
+    __m256i sumLo = zero;
+    __m256i sumHi = zero;
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(samples + i));
+        __m256i a = _mm256_max_epi16(x, _mm256_subs_epi16(zero, x));
+        maxAbs = _mm256_max_epi16(maxAbs, a);
+        //两个累加器交替累加，减少依赖
+        __m256i squares = _mm256_madd_epi16(a, a);
+        sumLo = _mm256_add_epi64(sumLo, _mm256_unpacklo_epi32(squares, zero));
+        sumHi = _mm256_add_epi64(sumHi, _mm256_unpackhi_epi32(squares, zero));
+    }
+    __m256i sum = _mm256_add_epi64(sumLo, sumHi);
+
+    qint16 maxLanes[16];
+    qint64 sumLanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(maxLanes), maxAbs);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(sumLanes), sum);
+
+    //尾部使用标量实现，不混用非VEX编码的SSE指令，避免状态切换的开销
+    windowS16Scalar(samples + i, count - i, peak, sumSquares);
+    for (qint16 lane : maxLanes) {
+        peak = qMax(peak, static_cast<int>(lane));
+    }
+    sumSquares += sumLanes[0] + sumLanes[1] + sumLanes[2] + sumLanes[3];
+}
+
+VNOTE_TARGET_AVX2 static inline __m256 loadAvx2(const float *samples)
+{
+    return _mm256_loadu_ps(samples);
+}
+
+VNOTE_TARGET_AVX2 static inline __m256 loadAvx2(const qint32 *samples)
+{
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(samples));
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(x), _mm256_set1_ps(S32Scale));
+}
+
+/**
+ * @brief windowFloatAvx2
+ * 一次处理8个采样
+ */
+template<typename T>
+VNOTE_TARGET_AVX2 static void windowFloatAvx2(const T *samples, int count, float &peak, double &sumSquares)
+{
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 maxAbs = _mm256_setzero_ps();
+    __m256 sum = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 a = _mm256_and_ps(loadAvx2(samples + i), absMask);
+        maxAbs = _mm256_max_ps(maxAbs, a);
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(a, a));
+    }
+
+    float maxLanes[8];
+    float sumLanes[8];
+    _mm256_storeu_ps(maxLanes, maxAbs);
+    _mm256_storeu_ps(sumLanes, sum);
+
+    windowFloatScalar(samples + i, count - i, peak, sumSquares);
+    for (int j = 0; j < 8; j++) {
+        peak = qMax(peak, maxLanes[j]);
+        sumSquares += sumLanes[j];
+    }
+}
+#endif
+
+#ifdef VNOTE_HAS_NEON
+/**
+ * @brief windowS16Neon
+ * 一次处理8个采样
+ */
+static void windowS16Neon(const qint16 *samples, int count, int &peak, qint64 &sumSquares)
+{
+    int16x8_t maxAbs = vdupq_n_s16(0);
+    int64x2_t sum = vdupq_n_s64(0);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        //饱和取绝对值，-32768的绝对值为32767
+        int16x8_t a = vqabsq_s16(vld1q_s16(samples + i));
+        maxAbs = vmaxq_s16(maxAbs, a);
+        sum = vpadalq_s32(sum, vmull_s16(vget_low_s16(a), vget_low_s16(a)));
+        sum = vpadalq_s32(sum, vmull_s16(vget_high_s16(a), vget_high_s16(a)));
+    }
+
+    int16_t maxLanes[8];
+    int64_t sumLanes[2];
+    vst1q_s16(maxLanes, maxAbs);
+    vst1q_s64(sumLanes, sum);
+
+    windowS16Scalar(samples + i, count - i, peak, sumSquares);
+    for (int16_t lane : maxLanes) {
+        peak = qMax(peak, static_cast<int>(lane));
+    }
+    sumSquares += sumLanes[0] + sumLanes[1];
+}
+
+static inline float32x4_t loadNeon(const float *samples)
+{
+    return vld1q_f32(samples);
+}
+
+static inline float32x4_t loadNeon(const qint32 *samples)
+{
+    return vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(samples)), S32Scale);
+}
+
+/**
+ * @brief windowFloatNeon
+ * 一次处理4个采样
+ */
+template<typename T>
+static void windowFloatNeon(const T *samples, int count, float &peak, double &sumSquares)
+{
+    float32x4_t maxAbs = vdupq_n_f32(0);
+    float32x4_t sum = vdupq_n_f32(0);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t a = vabsq_f32(loadNeon(samples + i));
+        maxAbs = vmaxq_f32(maxAbs, a);
+        sum = vmlaq_f32(sum, a, a);
+    }
+
+    float maxLanes[4];
+    float sumLanes[4];
+    vst1q_f32(maxLanes, maxAbs);
+    vst1q_f32(sumLanes, sum);
+
+    windowFloatScalar(samples + i, count - i, peak, sumSquares);
+    for (int j = 0; j < 4; j++) {
+        peak = qMax(peak, maxLanes[j]);
+        sumSquares += sumLanes[j];
+    }
+}
+#endif
+
+/**
+ * @brief windowKernel
+ * S16使用整数统计，最后归一化
+ */
+static void windowKernel(VNoteAudioLevel::Kernel kernel, const qint16 *samples, int count, float &peak, double &sumSquares)
+{
+    int maxAbs = 0;
+    qint64 sum = 0;
+    switch (kernel) {
+#ifdef __SSE2__
+    case VNoteAudioLevel::Sse2:
+        windowS16Sse2(samples, count, maxAbs, sum);
+        break;
+#endif
+#ifdef VNOTE_HAS_AVX2
+    case VNoteAudioLevel::Avx2:
+        windowS16Avx2(samples, count, maxAbs, sum);
+        break;
+#endif
+#ifdef VNOTE_HAS_NEON
+    case VNoteAudioLevel::Neon:
+        windowS16Neon(samples, count, maxAbs, sum);
+        break;
+#endif
+    default:
+        windowS16Scalar(samples, count, maxAbs, sum);
+        break;
+    }
+    peak = maxAbs * S16Scale;
+    sumSquares = static_cast<double>(sum) * S16Scale * S16Scale;
+}
+
+/**
+ * @brief windowKernel
+ * S32转换为浮点后与F32共用实现
+ */
+template<typename T>
+static void windowKernel(VNoteAudioLevel::Kernel kernel, const T *samples, int count, float &peak, double &sumSquares)
+{
+    switch (kernel) {
+#ifdef __SSE2__
+    case VNoteAudioLevel::Sse2:
+        windowFloatSse2(samples, count, peak, sumSquares);
+        break;
+#endif
+#ifdef VNOTE_HAS_AVX2
+    case VNoteAudioLevel::Avx2:
+        windowFloatAvx2(samples, count, peak, sumSquares);
+        break;
+#endif
+#ifdef VNOTE_HAS_NEON
+    case VNoteAudioLevel::Neon:
+        windowFloatNeon(samples, count, peak, sumSquares);
+        break;
+#endif
+    default:
+        windowFloatScalar(samples, count, peak, sumSquares);
+        break;
+    }
+}
+
+/**
+ * @brief VNoteAudioLevel::window
+ * @param kernel 实现，需为availableKernels中的一个
+ * @param samples 采样数据
+ * @param count 采样数
+ * @param peak 绝对值峰值
+ * @param sumSquares 平方和
+ */
+template<typename T>
+void VNoteAudioLevel::window(Kernel kernel, const T *samples, int count, float &peak, double &sumSquares)
+{
+    windowKernel(kernel, samples, count, peak, sumSquares);
+}
+
+/**
+ * @brief VNoteAudioLevel::measure
+ * @param data 交织的采样数据
+ * @param frames 帧数
+ * @param channels 通道数
+ * @param levels 窗口电平
+ */
+template<typename T>
+void VNoteAudioLevel::measure(const T *data, int frames, int channels, VNoteAudioLevels &levels)
+{
+    levels.count = 0;
+    if (nullptr == data || frames <= 0 || channels <= 0) {
+        return;
+    }
+
+    const Kernel kernel = bestKernel();
+    int windowFrames = qMax(static_cast<int>(WindowFrames), (frames + VNoteAudioLevels::MaxWindows - 1) / VNoteAudioLevels::MaxWindows);
+    for (int start = 0; start < frames; start += windowFrames) {
+        int count = qMin(windowFrames, frames - start) * channels;
+        float peak = 0;
+        double sumSquares = 0;
+        windowKernel(kernel, data + start * channels, count, peak, sumSquares);
+
+        levels.peak[levels.count] = peak;
+        levels.rms[levels.count] = static_cast<float>(qSqrt(sumSquares / count));
+        levels.count++;
+    }
+}
+
+template void VNoteAudioLevel::measure<qint16>(const qint16 *, int, int, VNoteAudioLevels &);
+template void VNoteAudioLevel::measure<qint32>(const qint32 *, int, int, VNoteAudioLevels &);
+template void VNoteAudioLevel::measure<float>(const float *, int, int, VNoteAudioLevels &);
+template void VNoteAudioLevel::window<qint16>(Kernel, const qint16 *, int, float &, double &);
+template void VNoteAudioLevel::window<qint32>(Kernel, const qint32 *, int, float &, double &);
+template void VNoteAudioLevel::window<float>(Kernel, const float *, int, float &, double &);
+
+/**
+ * @brief VNoteAudioLevel::measure
+ * 每段数据只判断一次格式，之后使用对应格式的实现
+ * @param format 音频格式
+ * @param data 采样数据
+ * @param bytes 数据长度
+ * @param levels 窗口电平
+ * @return 支持的格式返回true
+ */
+bool VNoteAudioLevel::measure(const QAudioFormat &format, const void *data, int bytes, VNoteAudioLevels &levels)
+{
+    levels.count = 0;
+    if (!format.isValid() || format.codec() != "audio/pcm"
+        || format.byteOrder() != static_cast<QAudioFormat::Endian>(QSysInfo::ByteOrder)) {
+        return false;
+    }
+
+    int channels = format.channelCount();
+    int frames = bytes / (format.sampleSize() / 8) / channels;
+    switch (format.sampleType()) {
+    case QAudioFormat::SignedInt:
+        if (16 == format.sampleSize()) {
+            measure(static_cast<const qint16 *>(data), frames, channels, levels);
+            return true;
+        }
+        if (32 == format.sampleSize()) {
+            measure(static_cast<const qint32 *>(data), frames, channels, levels);
+            return true;
+        }
+        break;
+    case QAudioFormat::Float:
+        if (32 == format.sampleSize()) {
+            measure(static_cast<const float *>(data), frames, channels, levels);
+            return true;
+        }
+        break;
+    default:
+        break;
+    }
+    return false;
+}
+
+/**
+ * @brief VNoteAudioLevel::availableKernels
+ * @return 当前CPU可用的实现，由慢到快
+ */
+QList<VNoteAudioLevel::Kernel> VNoteAudioLevel::availableKernels()
+{
+    QList<Kernel> kernels {Scalar};
+#ifdef __SSE2__
+    kernels.append(Sse2);
+#endif
+#ifdef VNOTE_HAS_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.append(Avx2);
+    }
+#endif
+#ifdef VNOTE_HAS_NEON
+    kernels.append(Neon);
+#endif
+    return kernels;
+}
+
+/**
+ * @brief VNoteAudioLevel::bestKernel
+ * @return 当前CPU最快的实现
+ */
+VNoteAudioLevel::Kernel VNoteAudioLevel::bestKernel()
+{
+    static const Kernel kernel = availableKernels().last();
+    return kernel;
+}
@@ -0,0 +1,64 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEAUDIOLEVEL_H
+#define VNOTEAUDIOLEVEL_H
+
+#include <QtGlobal>
+#include <QList>
+
+class QAudioFormat;
+
+/**
+ * @brief The VNoteAudioLevels struct
+ * 一段录音数据的窗口电平，峰值与均方根均归一化到[0,1]
+ */
+struct VNoteAudioLevels {
+    enum {
+        MaxWindows = 32, //一段数据最多的窗口数
+    };
+    qint64 position {-1}; //数据开始时间，毫秒
+    int count {0}; //有效窗口数
+    float peak[MaxWindows]; //窗口峰值
+    float rms[MaxWindows]; //窗口均方根
+};
+
+/**
+ * @brief The VNoteAudioLevel class
+ * 录音电平计算，直接在交织的PCM数据上按窗口统计峰值与均方根，
+ * 所有通道合并统计，与通道数无关
+ * 支持S16、S32、F32格式，按CPU选择SSE2/AVX2/NEON实现，其他平台使用标量实现
+ */
+class VNoteAudioLevel
+{
+public:
+    enum {
+        WindowFrames = 256, //默认窗口帧数，数据过长时窗口加长，保证不超过MaxWindows
+    };
+
+    //窗口统计的实现
+    enum Kernel {
+        Scalar = 0,
+        Sse2,
+        Avx2,
+        Neon,
+    };
+
+    //按音频格式计算窗口电平，不支持的格式返回false
+    static bool measure(const QAudioFormat &format, const void *data, int bytes, VNoteAudioLevels &levels);
+    //计算交织数据的窗口电平，T为qint16、qint32或float
+    template<typename T>
+    static void measure(const T *data, int frames, int channels, VNoteAudioLevels &levels);
+
+    //当前CPU可用的实现
+    static QList<Kernel> availableKernels();
+    //当前CPU最快的实现
+    static Kernel bestKernel();
+    //统计一个窗口的绝对值峰值与平方和，均已归一化
+    template<typename T>
+    static void window(Kernel kernel, const T *samples, int count, float &peak, double &sumSquares);
+};
+
+#endif // VNOTEAUDIOLEVEL_H
@@ -0,0 +1,93 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoteautosavescheduler.h"
+
+#include <QtMath>
+
+/**
+ * @brief VNoteAutosaveScheduler::VNoteAutosaveScheduler
+ * @param parent
+ */
+VNoteAutosaveScheduler::VNoteAutosaveScheduler(QObject *parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &VNoteAutosaveScheduler::onTimeout);
+}
+
+/**
+ * @brief VNoteAutosaveScheduler::markDirty
+ * 每次变化重新开始等待，但不超过未保存的最长时间
+ */
+void VNoteAutosaveScheduler::markDirty()
+{
+    if (!m_dirty) {
+        m_dirty = true;
+        m_dirtyTime.start();
+    }
+    qint64 remain = qMax<qint64>(0, MaxStaleness - m_dirtyTime.elapsed());
+    m_timer.start(static_cast<int>(qMin<qint64>(idleDelay(), remain)));
+}
+
+/**
+ * @brief VNoteAutosaveScheduler::cancel
+ */
+void VNoteAutosaveScheduler::cancel()
+{
+    m_timer.stop();
+    m_dirty = false;
+}
+
+/**
+ * @brief VNoteAutosaveScheduler::isDirty
+ * @return 有待执行的保存返回true
+ */
+bool VNoteAutosaveScheduler::isDirty() const
+{
+    return m_dirty;
+}
+
+/**
+ * @brief VNoteAutosaveScheduler::saveStarted
+ */
+void VNoteAutosaveScheduler::saveStarted()
+{
+    m_saveTime.start();
+}
+
+/**
+ * @brief VNoteAutosaveScheduler::saveFinished
+ * 保存耗时取滑动平均，避免单次抖动影响保存频率
+ */
+void VNoteAutosaveScheduler::saveFinished()
+{
+    if (!m_saveTime.isValid()) {
+        return;
+    }
+    qreal cost = m_saveTime.elapsed();
+    m_saveCost = qFuzzyIsNull(m_saveCost) ? cost : m_saveCost * 0.7 + cost * 0.3;
+    m_saveTime.invalidate();
+}
+
+/**
+ * @brief VNoteAutosaveScheduler::idleDelay
+ * @return 停止输入等待时间
+ */
+int VNoteAutosaveScheduler::idleDelay() const
+{
+    int delay = MinIdleDelay + qRound(m_saveCost * CostFactor);
+    return qBound(static_cast<int>(MinIdleDelay), delay, static_cast<int>(MaxIdleDelay));
+}
+
+/**
+ * @brief VNoteAutosaveScheduler::onTimeout
+ */
+void VNoteAutosaveScheduler::onTimeout()
+{
+    m_timer.stop();
+    m_dirty = false;
+    emit saveRequested();
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEAUTOSAVESCHEDULER_H
+#define VNOTEAUTOSAVESCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+/**
+ * @brief The VNoteAutosaveScheduler class
+ * 自动保存调度，停止输入一段时间后保存，连续输入时最长不超过MaxStaleness保存一次，
+ * 停止输入的等待时间根据实际保存耗时调整，大笔记保存频率更低
+ */
+class VNoteAutosaveScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit VNoteAutosaveScheduler(QObject *parent = nullptr);
+
+    //时间参数，单位毫秒
+    enum {
+        MinIdleDelay = 500, //最短停止输入等待时间
+        MaxIdleDelay = 3000, //最长停止输入等待时间
+        MaxStaleness = 5000, //内容未保存的最长时间
+        CostFactor = 4, //等待时间为保存耗时的倍数
+    };
+
+    //内容发生变化
+    void markDirty();
+    //取消待执行的保存
+    void cancel();
+    //是否有待执行的保存
+    bool isDirty() const;
+    //记录保存开始、结束，用于统计保存耗时
+    void saveStarted();
+    void saveFinished();
+    //当前停止输入等待时间
+    int idleDelay() const;
+
+signals:
+    //需要保存
+    void saveRequested();
+
+private slots:
+    void onTimeout();
+
+private:
+    QTimer m_timer; //保存定时器
+    QElapsedTimer m_dirtyTime; //第一次未保存变化至今的时间
+    QElapsedTimer m_saveTime; //本次保存耗时
+    qreal m_saveCost {0}; //平均保存耗时
+    bool m_dirty {false};
+};
+
+#endif // VNOTEAUTOSAVESCHEDULER_H
@@ -10,6 +10,8 @@
 #include "task/loadiconsworker.h"
 #include "vnoteforlder.h"
 #include "vnoteitem.h"
+#include "vnotesearchindex.h"
+#include "vnotejournal.h"
 
 #include <DLog>
 
@@ -80,6 +82,7 @@ VNoteFolder *VNoteDataManager::addFolder(VNoteFolder *folder)
         m_qspNoteFoldersMap->lock.unlock();
 
         retFlder = folder;
+        increaseDataVersion();
     }
 
     return retFlder;
@@ -135,6 +138,8 @@ VNoteFolder *VNoteDataManager::delFolder(qint64 folderId)
             //Remove voice files in the folder
             for (auto it : foldersMap->folderNotes) {
                 it->delNoteData();
+                VNoteSearchIndex::instance()->removeNote(it->noteId);
+                VNoteJournal::instance()->remove(it->noteId);
             }
         }
 
@@ -143,6 +148,7 @@ VNoteFolder *VNoteDataManager::delFolder(qint64 folderId)
 
         retFlder = *itFolder;
         m_qspNoteFoldersMap->folders.erase(itFolder);
+        increaseDataVersion();
     }
 
     m_qspNoteFoldersMap->lock.unlock();
@@ -217,6 +223,7 @@ VNoteItem *VNoteDataManager::addNote(VNoteItem *note)
         m_qspAllNotesMap->lock.unlock();
 
         retNote = note;
+        increaseDataVersion();
     }
 
     return retNote;
@@ -298,6 +305,9 @@ VNoteItem *VNoteDataManager::delNote(qint64 folderId, qint32 noteId)
 
             //Remove voice file of voice note
             retNote->delNoteData();
+            VNoteSearchIndex::instance()->removeNote(noteId);
+            VNoteJournal::instance()->remove(noteId);
+            increaseDataVersion();
         }
 
         notesInFolder->lock.unlock();
@@ -515,6 +525,7 @@ void VNoteDataManager::onAllNotesLoaded(VNOTE_ALL_NOTES_MAP *notesMap)
     }
 
     m_qspAllNotesMap.reset(notesMap);
+    increaseDataVersion();
 
     qInfo() << "Release old notesMap:" << m_qspAllNotesMap.get()
             << "All notes in folders:" << m_qspAllNotesMap->notes.size();
@@ -532,3 +543,47 @@ void VNoteDataManager::onAllNotesLoaded(VNOTE_ALL_NOTES_MAP *notesMap)
         emit onAllDatasReady();
     }
 }
+
+/**
+ * @brief VNoteDataManager::dataVersion
+ * @return 当前数据版本号
+ */
+int VNoteDataManager::dataVersion() const
+{
+    return m_dataVersion.loadAcquire();
+}
+
+/**
+ * @brief VNoteDataManager::increaseDataVersion
+ * 笔记数据发生增删改时调用，使基于旧数据的缓存失效
+ */
+void VNoteDataManager::increaseDataVersion()
+{
+    m_dataVersion.fetchAndAddOrdered(1);
+}
+
+/**
+ * @brief VNoteDataManager::findNote
+ * 用于异步操作完成后重新获取笔记，避免使用已释放的数据
+ * @param noteId 笔记id
+ * @return 笔记数据
+ */
+VNoteItem *VNoteDataManager::findNote(qint32 noteId)
+{
+    VNoteItem *retNote = nullptr;
+    if (m_qspAllNotesMap.isNull()) {
+        return retNote;
+    }
+
+    m_qspAllNotesMap->lock.lockForRead();
+    for (auto folderNotes : m_qspAllNotesMap->notes) {
+        VNOTE_ITEMS_DATA_MAP::iterator noteIter = folderNotes->folderNotes.find(noteId);
+        if (noteIter != folderNotes->folderNotes.end()) {
+            retNote = *noteIter;
+            break;
+        }
+    }
+    m_qspAllNotesMap->lock.unlock();
+
+    return retNote;
+}
@@ -9,6 +9,7 @@
 #include "datatypedef.h"
 
 #include <QObject>
+#include <QAtomicInt>
 
 class LoadFolderWorker;
 class LoadNoteItemsWorker;
@@ -35,6 +36,12 @@ public:
     void reqNoteFolders();
     //加载记事项数据
     void reqNoteItems();
+    //获取数据版本号，笔记数据每次增删改后递增
+    int dataVersion() const;
+    //按笔记id查找笔记，笔记id全局唯一，不存在时返回nullptr
+    VNoteItem *findNote(qint32 noteId);
+    //递增数据版本号，笔记内容只在内存中更新时（如编辑日志）也需要调用
+    void increaseDataVersion();
 signals:
     //记事本数据加载完成
     void onNoteFoldersLoaded();
@@ -88,6 +95,8 @@ private:
 
     int m_fDataState = {DataNotLoaded};
 
+    QAtomicInt m_dataVersion {0}; //数据版本号，用于校验搜索缓存等派生数据
+
     bool isAllDatasReady() const;
 
     static VNoteDataManager *_instance;
@@ -99,6 +108,7 @@ private:
     friend class VNoteFolderOper;
     friend class VNoteItemOper;
     friend class FolderQryDbVisitor;
+    friend class VNoteSearchIndex;
     friend struct VNoteFolder;
 };
 
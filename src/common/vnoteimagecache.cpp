@@ -0,0 +1,265 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoteimagecache.h"
+#include "task/imageloadworker.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QImageReader>
+#include <QMutex>
+#include <QPixmapCache>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QDebug>
+
+VNoteImageCache *VNoteImageCache::_instance = nullptr;
+
+namespace {
+//内容哈希缓存，文件大小和修改时间不变时不重新计算
+struct ContentKeyEntry {
+    qint64 size {0};
+    qint64 modifyTime {0};
+    QByteArray key;
+};
+QHash<QString, ContentKeyEntry> g_contentKeys;
+QMutex g_contentKeyMutex;
+} // namespace
+
+/**
+ * @brief VNoteImageCache::VNoteImageCache
+ * @param parent
+ */
+VNoteImageCache::VNoteImageCache(QObject *parent)
+    : QObject(parent)
+{
+    //解码占用内存较多，限制并发数
+    m_pool.setMaxThreadCount(qBound(2, QThread::idealThreadCount() / 2, 4));
+    if (QPixmapCache::cacheLimit() < MemoryCacheLimit) {
+        QPixmapCache::setCacheLimit(MemoryCacheLimit);
+    }
+}
+
+VNoteImageCache::~VNoteImageCache()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+/**
+ * @brief VNoteImageCache::instance
+ * @return 单例对象
+ */
+VNoteImageCache *VNoteImageCache::instance()
+{
+    if (nullptr == _instance) {
+        _instance = new VNoteImageCache();
+    }
+
+    return _instance;
+}
+
+/**
+ * @brief VNoteImageCache::memoryKey
+ * @param path 图片路径
+ * @param maxSize 最大显示尺寸
+ * @return 内存缓存键值
+ */
+QString VNoteImageCache::memoryKey(const QString &path, const QSize &maxSize)
+{
+    qint64 modifyTime = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+    return QString("%1|%2|%3x%4").arg(path).arg(modifyTime).arg(maxSize.width()).arg(maxSize.height());
+}
+
+/**
+ * @brief VNoteImageCache::find
+ * @param path 图片路径
+ * @param maxSize 最大显示尺寸
+ * @param pixmap 缓存的图片
+ * @return 命中返回true
+ */
+bool VNoteImageCache::find(const QString &path, const QSize &maxSize, QPixmap *pixmap) const
+{
+    return QPixmapCache::find(memoryKey(path, maxSize), pixmap);
+}
+
+/**
+ * @brief VNoteImageCache::request
+ * @param path 图片路径
+ * @param maxSize 最大显示尺寸
+ */
+void VNoteImageCache::request(const QString &path, const QSize &maxSize)
+{
+    QPixmap pixmap;
+    if (find(path, maxSize, &pixmap)) {
+        emit imageReady(path, maxSize, pixmap);
+        return;
+    }
+
+    //同一图片正在解码时不重复解码
+    QString pendingKey = QString("%1|%2x%3").arg(path).arg(maxSize.width()).arg(maxSize.height());
+    if (m_pending.contains(pendingKey)) {
+        return;
+    }
+    m_pending.insert(pendingKey);
+
+    ImageLoadWorker *worker = new ImageLoadWorker(path, maxSize);
+    worker->setAutoDelete(true);
+    worker->setObjectName("ImageLoadWorker");
+    connect(worker, &ImageLoadWorker::imageLoaded, this, &VNoteImageCache::onImageLoaded, Qt::QueuedConnection);
+    m_pool.start(worker);
+}
+
+/**
+ * @brief VNoteImageCache::onImageLoaded
+ * @param path 图片路径
+ * @param maxSize 最大显示尺寸
+ * @param image 图片
+ */
+void VNoteImageCache::onImageLoaded(const QString &path, const QSize &maxSize, const QImage &image)
+{
+    m_pending.remove(QString("%1|%2x%3").arg(path).arg(maxSize.width()).arg(maxSize.height()));
+
+    QPixmap pixmap;
+    if (!image.isNull()) {
+        pixmap = QPixmap::fromImage(image);
+        QPixmapCache::insert(memoryKey(path, maxSize), pixmap);
+    }
+    emit imageReady(path, maxSize, pixmap);
+}
+
+/**
+ * @brief VNoteImageCache::diskCacheDir
+ * @return 磁盘缓存目录
+ */
+QString VNoteImageCache::diskCacheDir()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails";
+}
+
+/**
+ * @brief VNoteImageCache::contentKey
+ * @param path 图片路径
+ * @return 内容哈希，读取失败时为空
+ */
+QByteArray VNoteImageCache::contentKey(const QString &path)
+{
+    QFileInfo info(path);
+    if (!info.isFile()) {
+        return QByteArray();
+    }
+
+    qint64 size = info.size();
+    qint64 modifyTime = info.lastModified().toMSecsSinceEpoch();
+    {
+        QMutexLocker locker(&g_contentKeyMutex);
+        auto it = g_contentKeys.constFind(path);
+        if (it != g_contentKeys.constEnd() && it->size == size && it->modifyTime == modifyTime) {
+            return it->key;
+        }
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file)) {
+        return QByteArray();
+    }
+
+    ContentKeyEntry entry;
+    entry.size = size;
+    entry.modifyTime = modifyTime;
+    entry.key = hash.result().toHex();
+
+    QMutexLocker locker(&g_contentKeyMutex);
+    g_contentKeys.insert(path, entry);
+    return entry.key;
+}
+
+/**
+ * @brief VNoteImageCache::loadScaled
+ * 通过解码器直接按目标尺寸解码，jpg等格式不需要先解码出原图，
+ * 缩小后的图片写入磁盘缓存，下次直接读取
+ * @param path 图片路径
+ * @param maxSize 最大尺寸，无效时不缩放
+ * @return 图片，失败时为空
+ */
+QImage VNoteImageCache::loadScaled(const QString &path, const QSize &maxSize)
+{
+    QImageReader reader(path);
+    reader.setDecideFormatFromContent(true);
+    reader.setAutoTransform(true);
+
+    //解码器的尺寸为旋转前的尺寸
+    QSize size = reader.size();
+    QSize bound = maxSize;
+    if (reader.transformation() & QImageIOHandler::TransformationRotate90) {
+        bound.transpose();
+    }
+
+    //图片不超过最大尺寸时直接解码
+    if (!size.isValid() || !bound.isValid()
+            || (size.width() <= bound.width() && size.height() <= bound.height())) {
+        QImage image = reader.read();
+        if (image.isNull()) {
+            qWarning() << __FUNCTION__ << "read image failed:" << path << reader.errorString();
+        }
+        return image;
+    }
+
+    QSize scaledSize = size.scaled(bound, Qt::KeepAspectRatio);
+    QString cachePath;
+    QByteArray key = contentKey(path);
+    if (!key.isEmpty()) {
+        cachePath = QString("%1/%2_%3x%4").arg(diskCacheDir()).arg(QString(key)).arg(scaledSize.width()).arg(scaledSize.height());
+        QImageReader cacheReader(cachePath);
+        cacheReader.setDecideFormatFromContent(true);
+        QImage cached = cacheReader.read();
+        if (!cached.isNull()) {
+            return cached;
+        }
+    }
+
+    reader.setScaledSize(scaledSize);
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << __FUNCTION__ << "read image failed:" << path << reader.errorString();
+        return image;
+    }
+
+    if (!cachePath.isEmpty()) {
+        QDir().mkpath(diskCacheDir());
+        //有透明通道时使用png，否则使用jpg减小体积
+        QSaveFile file(cachePath);
+        if (file.open(QIODevice::WriteOnly) && image.save(&file, image.hasAlphaChannel() ? "png" : "jpg", 90)) {
+            file.commit();
+        }
+    }
+    return image;
+}
+
+/**
+ * @brief VNoteImageCache::trimDiskCache
+ * @param maxBytes 磁盘缓存上限
+ */
+void VNoteImageCache::trimDiskCache(qint64 maxBytes)
+{
+    QDir dir(diskCacheDir());
+    qint64 totalSize = 0;
+    //按修改时间排序，新生成的在前
+    for (const QFileInfo &info : dir.entryInfoList(QDir::Files, QDir::Time)) {
+        totalSize += info.size();
+        if (totalSize > maxBytes) {
+            QFile::remove(info.absoluteFilePath());
+        }
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEIMAGECACHE_H
+#define VNOTEIMAGECACHE_H
+
+#include <QObject>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+#include <QThreadPool>
+
+/**
+ * @brief The VNoteImageCache class
+ * 笔记图片解码缓存服务，图片按最大显示尺寸直接解码，不解码原始大小，
+ * 缩小后的图片按内容哈希和尺寸保存在磁盘缓存中，界面使用的图片保存在内存缓存中
+ */
+class VNoteImageCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit VNoteImageCache(QObject *parent = nullptr);
+    ~VNoteImageCache() override;
+
+    enum {
+        MemoryCacheLimit = 64 * 1024, //内存缓存上限，单位KB
+        DiskCacheLimit = 256 * 1024 * 1024, //磁盘缓存上限，单位字节
+    };
+
+    static VNoteImageCache *instance();
+
+    //查找内存缓存，只能在主线程调用
+    bool find(const QString &path, const QSize &maxSize, QPixmap *pixmap) const;
+    //后台解码图片，完成后发送imageReady信号，内存缓存命中时直接发送
+    void request(const QString &path, const QSize &maxSize);
+
+    //按最大尺寸解码图片，只缩小不放大，可以在任意线程调用
+    static QImage loadScaled(const QString &path, const QSize &maxSize);
+    //图片内容哈希，相同内容的图片共用磁盘缓存
+    static QByteArray contentKey(const QString &path);
+    //磁盘缓存目录
+    static QString diskCacheDir();
+    //清理磁盘缓存，超过上限时删除最早生成的缓存
+    static void trimDiskCache(qint64 maxBytes = DiskCacheLimit);
+
+signals:
+    /**
+     * @brief 图片解码完成
+     * @param path 图片路径
+     * @param maxSize 最大显示尺寸
+     * @param pixmap 图片，失败时为空
+     */
+    void imageReady(const QString &path, const QSize &maxSize, const QPixmap &pixmap);
+
+private slots:
+    //后台解码完成，加入内存缓存
+    void onImageLoaded(const QString &path, const QSize &maxSize, const QImage &image);
+
+private:
+    //内存缓存键值，包含文件修改时间，图片被替换后不使用旧缓存
+    static QString memoryKey(const QString &path, const QSize &maxSize);
+
+    static VNoteImageCache *_instance;
+
+    QSet<QString> m_pending; //解码中的请求
+    QThreadPool m_pool; //解码线程池
+};
+
+#endif // VNOTEIMAGECACHE_H
@@ -0,0 +1,171 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoteimagepolicy.h"
+#include "globaldef.h"
+#include "setting.h"
+
+#include <QBuffer>
+#include <QFileInfo>
+#include <QImageWriter>
+#include <QSet>
+#include <QtMath>
+
+/**
+ * @brief VNoteImagePolicy::fromSettings
+ * 只能在主线程调用，读取后传给后台任务
+ * @return 插入策略
+ */
+VNoteImagePolicy VNoteImagePolicy::fromSettings()
+{
+    VNoteImagePolicy policy;
+    policy.maxSize = setting::instance()->getOption(VNOTE_IMAGE_MAX_SIZE).toInt();
+    policy.sizeBudget = setting::instance()->getOption(VNOTE_IMAGE_SIZE_BUDGET).toLongLong() * 1024;
+    policy.transcode = setting::instance()->getOption(VNOTE_IMAGE_TRANSCODE).toBool();
+    policy.keepOriginal = setting::instance()->getOption(VNOTE_IMAGE_KEEP_ORIGINAL).toBool();
+    return policy;
+}
+
+/**
+ * @brief VNoteImagePolicy::isWebpSupported
+ * @return 安装了webp图片插件时返回true
+ */
+bool VNoteImagePolicy::isWebpSupported()
+{
+    static const bool supported = QImageWriter::supportedImageFormats().contains("webp");
+    return supported;
+}
+
+/**
+ * @brief VNoteImagePolicy::suffix
+ * @param format 编码格式
+ * @return 文件后缀
+ */
+QString VNoteImagePolicy::suffix(Format format)
+{
+    switch (format) {
+    case Jpeg:
+        return "jpg";
+    case WebP:
+        return "webp";
+    default:
+        return "png";
+    }
+}
+
+/**
+ * @brief VNoteImagePolicy::countColors
+ * 按网格均匀采样，大图不遍历所有像素
+ * @param image 图片
+ * @param limit 统计上限
+ * @return 颜色数
+ */
+int VNoteImagePolicy::countColors(const QImage &image, int limit)
+{
+    if (image.isNull()) {
+        return 0;
+    }
+
+    QImage argb = image.convertToFormat(QImage::Format_ARGB32);
+    qint64 pixels = static_cast<qint64>(argb.width()) * argb.height();
+    int step = qMax(1, static_cast<int>(qSqrt(static_cast<qreal>(pixels) / SampleCount)));
+
+    QSet<QRgb> colors;
+    for (int y = 0; y < argb.height(); y += step) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(argb.constScanLine(y));
+        for (int x = 0; x < argb.width(); x += step) {
+            colors.insert(line[x]);
+            if (colors.size() >= limit) {
+                return colors.size();
+            }
+        }
+    }
+    return colors.size();
+}
+
+/**
+ * @brief VNoteImagePolicy::needTranscode
+ * 文件在尺寸和大小预算内时保持原样，避免重复有损编码
+ * @param path 图片路径
+ * @param size 图片尺寸
+ * @return 需要重新编码返回true
+ */
+bool VNoteImagePolicy::needTranscode(const QString &path, const QSize &size) const
+{
+    if (maxSize > 0 && size.isValid() && (size.width() > maxSize || size.height() > maxSize)) {
+        return true;
+    }
+    if (!transcode) {
+        return false;
+    }
+
+    QFileInfo info(path);
+    //bmp未压缩
+    if (info.suffix().toLower() == "bmp") {
+        return true;
+    }
+    return sizeBudget > 0 && info.size() > sizeBudget;
+}
+
+/**
+ * @brief VNoteImagePolicy::capSize
+ * @param image 图片
+ * @return 不超过最大尺寸的图片
+ */
+QImage VNoteImagePolicy::capSize(const QImage &image) const
+{
+    if (maxSize > 0 && (image.width() > maxSize || image.height() > maxSize)) {
+        return image.scaled(maxSize, maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+/**
+ * @brief VNoteImagePolicy::chooseFormat
+ * @param image 图片
+ * @return 编码格式
+ */
+VNoteImagePolicy::Format VNoteImagePolicy::chooseFormat(const QImage &image) const
+{
+    if (!transcode) {
+        return Png;
+    }
+    //颜色较少的截图、图标使用无损编码，体积小且文字清晰
+    if (countColors(image, MaxPngColors + 1) <= MaxPngColors) {
+        return Png;
+    }
+    if (isWebpSupported()) {
+        return WebP;
+    }
+    //jpg不支持透明
+    return image.hasAlphaChannel() ? Png : Jpeg;
+}
+
+/**
+ * @brief VNoteImagePolicy::encode
+ * @param image 图片
+ * @param format 实际使用的格式
+ * @return 编码数据，失败时为空
+ */
+QByteArray VNoteImagePolicy::encode(const QImage &image, Format &format) const
+{
+    format = chooseFormat(image);
+    QByteArray format8 = suffix(format).toLatin1();
+
+    QByteArray data;
+    for (int quality = DefaultQuality; quality >= MinQuality; quality -= QualityStep) {
+        data.clear();
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        if (!image.save(&buffer, format8.constData(), Png == format ? -1 : quality)) {
+            return QByteArray();
+        }
+        //无损编码质量不影响大小
+        if (Png == format || sizeBudget <= 0 || data.size() <= sizeBudget) {
+            break;
+        }
+    }
+    return data;
+}
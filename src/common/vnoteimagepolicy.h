@@ -0,0 +1,59 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEIMAGEPOLICY_H
+#define VNOTEIMAGEPOLICY_H
+
+#include <QImage>
+#include <QString>
+
+/**
+ * @brief The VNoteImagePolicy class
+ * 插入图片的编码策略，根据图片统计信息选择编码格式：
+ * 颜色较少的截图使用png，照片使用webp（不支持时使用jpg），超过大小预算时逐步降低质量
+ */
+class VNoteImagePolicy
+{
+public:
+    //编码格式
+    enum Format {
+        Png = 0,
+        Jpeg,
+        WebP,
+    };
+
+    enum {
+        SampleCount = 64 * 1024, //统计颜色时的最大采样像素数
+        MaxPngColors = 2048, //采样颜色数不超过该值时视为截图
+        DefaultQuality = 90, //有损编码默认质量
+        MinQuality = 60, //超过大小预算时的最低质量
+        QualityStep = 10, //降低质量的步长
+    };
+
+    //从设置中读取插入策略
+    static VNoteImagePolicy fromSettings();
+    //统计采样像素的颜色数，达到limit时停止统计
+    static int countColors(const QImage &image, int limit);
+    //是否支持webp编码
+    static bool isWebpSupported();
+    //编码格式对应的文件后缀
+    static QString suffix(Format format);
+
+    //图片文件是否需要重新编码，size为图片尺寸
+    bool needTranscode(const QString &path, const QSize &size) const;
+    //超过最大尺寸时缩小
+    QImage capSize(const QImage &image) const;
+    //根据图片统计信息选择编码格式
+    Format chooseFormat(const QImage &image) const;
+    //按策略编码图片，返回编码数据，format为实际使用的格式
+    QByteArray encode(const QImage &image, Format &format) const;
+
+    int maxSize {0}; //图片最大边长，小于等于0时不限制
+    qint64 sizeBudget {0}; //单张图片大小预算，单位字节，小于等于0时不限制
+    bool transcode {true}; //是否按图片内容重新编码，关闭时剪贴板图片使用png，文件保持原样
+    bool keepOriginal {false}; //重新编码时是否同时保存原图
+};
+
+#endif // VNOTEIMAGEPOLICY_H
@@ -5,6 +5,7 @@
 
 #include "vnoteitem.h"
 #include "common/utils.h"
+#include "common/vnotesearchindex.h"
 
 #include <DLog>
 #include <DGuiApplicationHelper>
@@ -12,6 +13,8 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QRegExp>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 //导出为html文件时的头部部分
 static const QString htmlHead =
@@ -110,6 +113,11 @@ bool VNoteItem::search(const QString &keyword)
                 }
             }
         }
+
+        //语音转写、图片ocr等附件文本
+        if (!fContainKeyword) {
+            fContainKeyword = VNoteSearchIndex::instance()->search(this, keyword);
+        }
     }
 
     return fContainKeyword;
@@ -314,6 +322,64 @@ QStringList VNoteItem::getVoiceJsons() const
     return list;
 }
 
+/**
+ * @brief VNoteItem::setVoiceText
+ * 与web端转写完成时的处理一致，json中记录转写文本，文本段落插入到语音块之后
+ * @param voicePath 语音文件路径
+ * @param text 转写文本
+ * @return 找到语音并修改了内容返回true
+ */
+bool VNoteItem::setVoiceText(const QString &voicePath, const QString &text)
+{
+    if (text.trimmed().isEmpty()) {
+        return false;
+    }
+
+    QRegExp rx("<div[^>]*jsonkey=\"([^\"]*)\"[^>]*>", Qt::CaseInsensitive);
+    QRegExp rxDiv("<(/?)div\\b", Qt::CaseInsensitive);
+    int pos = 0;
+    while ((pos = rx.indexIn(htmlCode, pos)) != -1) {
+        QString attr = rx.cap(1);
+        QString json = attr;
+        json.replace("&quot;", "\"").replace("&lt;", "<").replace("&gt;", ">").replace("&amp;", "&");
+        QJsonObject voice = QJsonDocument::fromJson(json.toUtf8()).object();
+        int start = pos + rx.matchedLength();
+        if (voice.value("voicePath").toString() != voicePath) {
+            pos = start;
+            continue;
+        }
+        //已有转写文本时不重复插入
+        if (!voice.value("text").toString().isEmpty()) {
+            return false;
+        }
+
+        //语音块内有嵌套的div，按层级找到语音块的结束位置
+        int depth = 1;
+        int index = start;
+        while (depth > 0 && (index = rxDiv.indexIn(htmlCode, index)) != -1) {
+            depth += rxDiv.cap(1).isEmpty() ? 1 : -1;
+            index += rxDiv.matchedLength();
+        }
+        int end = depth > 0 ? -1 : htmlCode.indexOf('>', index);
+        if (end < 0) {
+            return false;
+        }
+        end++;
+
+        voice.insert("text", text.trimmed());
+        QString newAttr = QString::fromUtf8(QJsonDocument(voice).toJson(QJsonDocument::Compact));
+        newAttr.replace("&", "&amp;").replace("\"", "&quot;").replace("<", "&lt;").replace(">", "&gt;");
+
+        int attrPos = rx.pos(1);
+        htmlCode = htmlCode.left(attrPos) + newAttr
+                   + htmlCode.mid(attrPos + attr.size(), end - attrPos - attr.size())
+                   + "<p>" + text.trimmed().toHtmlEscaped() + "</p>"
+                   + htmlCode.mid(end);
+        return true;
+    }
+    return false;
+}
+
 /**
  * @brief VNoteItem::getFullHtml
  * 通过补全css样式和将图片路径转换为base64编码得到完整html字符串
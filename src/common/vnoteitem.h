@@ -96,6 +96,8 @@ public:
     qint32 voiceCount() const;
     //获取文本内所有语音json数据
     QStringList getVoiceJsons() const;
+    //设置语音的转写文本，语音后插入文本段落，笔记不在编辑区显示时使用
+    bool setVoiceText(const QString &voicePath, const QString &text);
     //获取html
     QString getFullHtml() const;
 
@@ -167,5 +169,6 @@ struct VNVoiceBlock : public VNoteBlock {
     QString voiceTitle {""};
     bool state {false};
     QDateTime createTime;
+    VNOTE_SPEECH_SEGMENTS speechSegments; //录音时检测的语音段，为空时未检测
 };
 #endif // VNOTEITEM_H
@@ -0,0 +1,276 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnotejournal.h"
+#include "vnoteitem.h"
+#include "vnotedatamanager.h"
+#include "vnotesearchindex.h"
+#include "task/journalwriteworker.h"
+#include "db/vnoteitemoper.h"
+
+#include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStandardPaths>
+#include <QDebug>
+
+VNoteJournal *VNoteJournal::_instance = nullptr;
+
+/**
+ * @brief VNoteJournal::VNoteJournal
+ * @param parent
+ */
+VNoteJournal::VNoteJournal(QObject *parent)
+    : QObject(parent)
+    , m_journalDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/journal")
+{
+    m_pool.setMaxThreadCount(1);
+    QDir().mkpath(m_journalDir);
+
+    m_compactTimer.setSingleShot(true);
+    m_compactTimer.setInterval(CompactDelay);
+    connect(&m_compactTimer, &QTimer::timeout, this, &VNoteJournal::flushCompaction);
+}
+
+VNoteJournal::~VNoteJournal()
+{
+    m_pool.waitForDone();
+}
+
+/**
+ * @brief VNoteJournal::instance
+ * @return 单例对象
+ */
+VNoteJournal *VNoteJournal::instance()
+{
+    if (nullptr == _instance) {
+        _instance = new VNoteJournal();
+    }
+
+    return _instance;
+}
+
+/**
+ * @brief VNoteJournal::journalPath
+ * @param noteId 笔记id
+ * @return 日志文件路径
+ */
+QString VNoteJournal::journalPath(qint32 noteId) const
+{
+    return QString("%1/%2.journal").arg(m_journalDir).arg(noteId);
+}
+
+/**
+ * @brief VNoteJournal::append
+ * @param noteId 笔记id
+ * @param record 增量记录
+ */
+void VNoteJournal::append(qint32 noteId, QJsonObject record)
+{
+    record.insert("time", QDateTime::currentMSecsSinceEpoch());
+    m_journalNotes.insert(noteId);
+    QByteArray data = QJsonDocument(record).toJson(QJsonDocument::Compact);
+    startWorker(new JournalWriteWorker(JournalWriteWorker::Append, journalPath(noteId), data));
+}
+
+/**
+ * @brief VNoteJournal::remove
+ * @param noteId 笔记id
+ */
+void VNoteJournal::remove(qint32 noteId)
+{
+    m_journalNotes.remove(noteId);
+    m_compactNotes.remove(noteId);
+    startWorker(new JournalWriteWorker(JournalWriteWorker::Remove, journalPath(noteId)));
+}
+
+/**
+ * @brief VNoteJournal::hasJournal
+ * @param noteId 笔记id
+ * @return 已有日志返回true
+ */
+bool VNoteJournal::hasJournal(qint32 noteId) const
+{
+    return m_journalNotes.contains(noteId);
+}
+
+/**
+ * @brief VNoteJournal::compact
+ * 笔记内容已在内存中更新，日志保证数据不丢失，数据库写入可以延后合并
+ * @param noteId 笔记id
+ */
+void VNoteJournal::compact(qint32 noteId)
+{
+    m_compactNotes.insert(noteId);
+    if (!m_compactTimer.isActive()) {
+        m_compactTimer.start();
+    }
+}
+
+/**
+ * @brief VNoteJournal::flushCompaction
+ * @return 写入成功返回true，失败时保留日志，下次再合并
+ */
+bool VNoteJournal::flushCompaction()
+{
+    m_compactTimer.stop();
+    if (m_compactNotes.isEmpty()) {
+        return true;
+    }
+
+    QList<VNoteItem *> notes;
+    for (qint32 noteId : m_compactNotes) {
+        //笔记已删除时日志随笔记一起删除
+        VNoteItem *note = VNoteDataManager::instance()->findNote(noteId);
+        if (nullptr != note) {
+            notes.append(note);
+        }
+    }
+
+    if (!VNoteItemOper::updateNotes(notes)) {
+        qWarning() << __FUNCTION__ << "compact notes failed:" << notes.size();
+        m_compactTimer.start();
+        return false;
+    }
+
+    for (VNoteItem *note : notes) {
+        remove(note->noteId);
+        VNoteSearchIndex::instance()->scheduleNote(note);
+    }
+    m_compactNotes.clear();
+    return true;
+}
+
+/**
+ * @brief VNoteJournal::waitForDone
+ * @param msecs 超时时间
+ */
+void VNoteJournal::waitForDone(int msecs)
+{
+    m_pool.waitForDone(msecs);
+}
+
+/**
+ * @brief VNoteJournal::startWorker
+ * @param worker 日志任务
+ */
+void VNoteJournal::startWorker(JournalWriteWorker *worker)
+{
+    worker->setAutoDelete(true);
+    worker->setObjectName("JournalWriteWorker");
+    m_pool.start(worker);
+}
+
+/**
+ * @brief VNoteJournal::applyDelta
+ * 增量为reset时替换全部块，否则从start位置删除remove个块后插入新块
+ * @param blocks 笔记的顶层块
+ * @param delta 增量
+ * @return 应用成功返回true
+ */
+bool VNoteJournal::applyDelta(QStringList &blocks, const QJsonObject &delta)
+{
+    QStringList newBlocks;
+    for (const QJsonValue &value : delta.value("blocks").toArray()) {
+        newBlocks.append(value.toString());
+    }
+
+    if (delta.value("reset").toBool()) {
+        blocks = newBlocks;
+        return true;
+    }
+
+    int start = delta.value("start").toInt(-1);
+    int remove = delta.value("remove").toInt(-1);
+    if (start < 0 || remove < 0 || start + remove > blocks.size()) {
+        return false;
+    }
+
+    blocks.erase(blocks.begin() + start, blocks.begin() + start + remove);
+    for (int i = 0; i < newBlocks.size(); i++) {
+        blocks.insert(start + i, newBlocks.at(i));
+    }
+    return true;
+}
+
+/**
+ * @brief VNoteJournal::replay
+ * 日志第一条记录为全量内容，之后依次应用增量，末尾不完整的记录忽略
+ * @param path 日志文件路径
+ * @param minTime 数据库中笔记的修改时间，早于此时间的日志已经合并过
+ * @param blocks 重建的笔记块
+ * @return 需要恢复时返回true
+ */
+bool VNoteJournal::replay(const QString &path, qint64 minTime, QStringList &blocks)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    qint64 lastTime = 0;
+    bool hasBase = false;
+    while (!file.atEnd()) {
+        QJsonObject record = QJsonDocument::fromJson(file.readLine()).object();
+        if (record.isEmpty()) {
+            break;
+        }
+        //没有全量记录时无法恢复
+        if (!hasBase && !record.value("reset").toBool()) {
+            break;
+        }
+        if (!applyDelta(blocks, record)) {
+            break;
+        }
+        hasBase = true;
+        lastTime = static_cast<qint64>(record.value("time").toDouble());
+    }
+
+    return hasBase && lastTime > minTime;
+}
+
+/**
+ * @brief VNoteJournal::recover
+ * 在笔记数据加载完成后调用
+ * @return 恢复的笔记数量
+ */
+int VNoteJournal::recover()
+{
+    QList<VNoteItem *> notes;
+    QStringList paths;
+    QDir dir(m_journalDir);
+    for (const QFileInfo &info : dir.entryInfoList(QStringList() << "*.journal", QDir::Files)) {
+        bool ok = false;
+        qint32 noteId = info.baseName().toInt(&ok);
+        VNoteItem *note = ok ? VNoteDataManager::instance()->findNote(noteId) : nullptr;
+
+        QStringList blocks;
+        if (nullptr != note && replay(info.absoluteFilePath(), note->modifyTime.toMSecsSinceEpoch(), blocks)) {
+            note->htmlCode = blocks.join("");
+            notes.append(note);
+        }
+        paths.append(info.absoluteFilePath());
+    }
+
+    if (!VNoteItemOper::updateNotes(notes)) {
+        //写入失败保留日志，下次启动再恢复
+        qWarning() << __FUNCTION__ << "recover notes failed:" << notes.size();
+        return 0;
+    }
+
+    for (const QString &path : paths) {
+        QFile::remove(path);
+    }
+    for (VNoteItem *note : notes) {
+        VNoteSearchIndex::instance()->scheduleNote(note);
+    }
+
+    if (!notes.isEmpty()) {
+        qInfo() << __FUNCTION__ << "recovered notes:" << notes.size();
+    }
+    return notes.size();
+}
@@ -0,0 +1,75 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEJOURNAL_H
+#define VNOTEJOURNAL_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <QSet>
+
+class JournalWriteWorker;
+
+/**
+ * @brief The VNoteJournal class
+ * 笔记编辑日志，编辑区的增量内容先追加到日志文件，定期合并写入数据库后删除日志，
+ * 程序异常退出时启动后根据日志恢复未写入数据库的内容
+ *
+ * 日志每行一条json记录：
+ * {"time":毫秒时间戳, "version":版本号, "reset":是否全量, "start":起始块, "remove":删除块数, "blocks":[新块html]}
+ */
+class VNoteJournal : public QObject
+{
+    Q_OBJECT
+public:
+    explicit VNoteJournal(QObject *parent = nullptr);
+    ~VNoteJournal() override;
+
+    //合并写入数据库的延时，单位毫秒
+    enum {
+        CompactDelay = 2000,
+    };
+
+    static VNoteJournal *instance();
+
+    //后台追加一条记录，记录中的时间由日志填写
+    void append(qint32 noteId, QJsonObject record);
+    //后台删除笔记日志，笔记内容已写入数据库或笔记已删除
+    void remove(qint32 noteId);
+    //笔记是否已有日志，没有日志时第一条记录需要为全量内容
+    bool hasJournal(qint32 noteId) const;
+    //请求将笔记内容合并写入数据库，短时间内的多个请求合并为一次事务
+    void compact(qint32 noteId);
+    //立即将所有待合并的笔记写入数据库
+    bool flushCompaction();
+    //等待后台任务结束
+    void waitForDone(int msecs = -1);
+    //根据日志恢复未写入数据库的笔记内容，返回恢复的笔记数量
+    int recover();
+
+    //日志文件路径
+    QString journalPath(qint32 noteId) const;
+    //将增量应用到块列表，增量与当前块不匹配时返回false
+    static bool applyDelta(QStringList &blocks, const QJsonObject &delta);
+
+private:
+    //读取日志重建笔记块，日志不早于minTime时返回true
+    bool replay(const QString &path, qint64 minTime, QStringList &blocks);
+    //提交后台任务，保证按提交顺序执行
+    void startWorker(JournalWriteWorker *worker);
+
+    static VNoteJournal *_instance;
+
+    QString m_journalDir {""}; //日志目录
+    QSet<qint32> m_journalNotes; //已有日志的笔记
+    QSet<qint32> m_compactNotes; //待合并写入数据库的笔记
+    QTimer m_compactTimer; //合并延时定时器
+    QThreadPool m_pool; //单线程池，保证同一笔记的追加、删除顺序
+};
+
+#endif // VNOTEJOURNAL_H
@@ -0,0 +1,321 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnotepeakfile.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDebug>
+
+#include <climits>
+
+static_assert(sizeof(VNotePeak) == 2, "VNotePeak is stored as raw bytes");
+
+/**
+ * @brief VNotePeakFile::peakPath
+ * @param voicePath 录音文件路径
+ * @return 峰值文件路径
+ */
+QString VNotePeakFile::peakPath(const QString &voicePath)
+{
+    return voicePath + ".peaks";
+}
+
+/**
+ * @brief VNotePeakFile::movePeakFile
+ * @param voicePath 原录音文件路径
+ * @param newVoicePath 新录音文件路径
+ */
+void VNotePeakFile::movePeakFile(const QString &voicePath, const QString &newVoicePath)
+{
+    if (voicePath == newVoicePath) {
+        return;
+    }
+
+    QString from = peakPath(voicePath);
+    if (!QFile::exists(from)) {
+        return;
+    }
+    //相同内容的录音已有峰值文件
+    if (QFile::exists(peakPath(newVoicePath)) || !QFile::rename(from, peakPath(newVoicePath))) {
+        QFile::remove(from);
+    }
+}
+
+/**
+ * @brief VNotePeakFile::reset
+ * @param sampleRate 采样率
+ */
+void VNotePeakFile::reset(int sampleRate)
+{
+    m_sampleRate = sampleRate;
+    m_frames = 0;
+    m_levels.clear();
+    m_levels.resize(1);
+    m_blockFrames = 0;
+    m_blockMin = SHRT_MAX;
+    m_blockMax = SHRT_MIN;
+}
+
+/**
+ * @brief VNotePeakFile::appendS16
+ * 按块统计，块内的循环只有最小最大值计算，便于编译器向量化
+ * @param data 采样数据
+ * @param frames 帧数
+ * @param channels 通道数
+ */
+void VNotePeakFile::appendS16(const qint16 *data, int frames, int channels)
+{
+    if (m_sampleRate <= 0 || nullptr == data || frames <= 0 || channels <= 0) {
+        return;
+    }
+
+    int offset = 0;
+    while (offset < frames) {
+        int count = qMin(BlockFrames - m_blockFrames, frames - offset);
+        const qint16 *samples = data + offset * channels;
+        int minValue = m_blockMin;
+        int maxValue = m_blockMax;
+        for (int i = 0; i < count * channels; i++) {
+            minValue = qMin(minValue, static_cast<int>(samples[i]));
+            maxValue = qMax(maxValue, static_cast<int>(samples[i]));
+        }
+        m_blockMin = minValue;
+        m_blockMax = maxValue;
+        m_blockFrames += count;
+        offset += count;
+
+        if (BlockFrames == m_blockFrames) {
+            flushBlock();
+        }
+    }
+    m_frames += frames;
+}
+
+/**
+ * @brief VNotePeakFile::flushBlock
+ */
+void VNotePeakFile::flushBlock()
+{
+    if (0 == m_blockFrames) {
+        return;
+    }
+
+    VNotePeak peak;
+    peak.min = static_cast<qint8>(m_blockMin >> 8);
+    peak.max = static_cast<qint8>(m_blockMax >> 8);
+    m_levels[0].append(peak);
+
+    m_blockFrames = 0;
+    m_blockMin = SHRT_MAX;
+    m_blockMax = SHRT_MIN;
+}
+
+/**
+ * @brief VNotePeakFile::finish
+ */
+void VNotePeakFile::finish()
+{
+    if (m_levels.isEmpty()) {
+        return;
+    }
+
+    flushBlock();
+    m_levels.resize(1);
+    while (m_levels.size() < MaxLevels && m_levels.last().size() > 1) {
+        const QVector<VNotePeak> &lower = m_levels.last();
+        QVector<VNotePeak> upper;
+        upper.reserve(lower.size() / LevelFactor + 1);
+        for (int i = 0; i < lower.size(); i += LevelFactor) {
+            VNotePeak peak = lower.at(i);
+            for (int j = i + 1; j < qMin(i + static_cast<int>(LevelFactor), lower.size()); j++) {
+                peak.min = qMin(peak.min, lower.at(j).min);
+                peak.max = qMax(peak.max, lower.at(j).max);
+            }
+            upper.append(peak);
+        }
+        m_levels.append(upper);
+    }
+}
+
+/**
+ * @brief VNotePeakFile::save
+ * @param path 峰值文件路径
+ * @return 成功返回true
+ */
+bool VNotePeakFile::save(const QString &path)
+{
+    finish();
+    if (isEmpty()) {
+        return false;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << __FUNCTION__ << "open peak file failed:" << path << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << static_cast<quint32>(Magic) << static_cast<quint16>(Version)
+           << static_cast<quint16>(m_levels.size()) << static_cast<quint32>(m_sampleRate)
+           << static_cast<quint32>(BlockFrames) << static_cast<quint32>(LevelFactor) << m_frames;
+    for (const QVector<VNotePeak> &peaks : m_levels) {
+        stream << static_cast<quint32>(peaks.size());
+    }
+    for (const QVector<VNotePeak> &peaks : m_levels) {
+        stream.writeRawData(reinterpret_cast<const char *>(peaks.constData()), peaks.size() * static_cast<int>(sizeof(VNotePeak)));
+    }
+    return QDataStream::Ok == stream.status() && file.commit();
+}
+
+/**
+ * @brief VNotePeakFile::load
+ * @param path 峰值文件路径
+ * @return 成功返回true
+ */
+bool VNotePeakFile::load(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint16 levelCount = 0;
+    quint32 sampleRate = 0;
+    quint32 blockFrames = 0;
+    quint32 levelFactor = 0;
+    qint64 frames = 0;
+    stream >> magic >> version >> levelCount >> sampleRate >> blockFrames >> levelFactor >> frames;
+    if (Magic != magic || Version != version || BlockFrames != blockFrames || LevelFactor != levelFactor
+        || 0 == levelCount || levelCount > MaxLevels || 0 == sampleRate || frames < 0) {
+        qWarning() << __FUNCTION__ << "invalid peak file:" << path;
+        return false;
+    }
+
+    QVector<quint32> counts(levelCount);
+    for (quint32 &count : counts) {
+        stream >> count;
+        //峰值数不会超过文件大小
+        if (count > file.size() / sizeof(VNotePeak)) {
+            return false;
+        }
+    }
+
+    QVector<QVector<VNotePeak>> levels(levelCount);
+    for (int i = 0; i < levelCount; i++) {
+        levels[i].resize(static_cast<int>(counts.at(i)));
+        int bytes = levels[i].size() * static_cast<int>(sizeof(VNotePeak));
+        if (stream.readRawData(reinterpret_cast<char *>(levels[i].data()), bytes) != bytes) {
+            return false;
+        }
+    }
+    if (QDataStream::Ok != stream.status()) {
+        return false;
+    }
+
+    m_sampleRate = static_cast<int>(sampleRate);
+    m_frames = frames;
+    m_levels = levels;
+    m_blockFrames = 0;
+    return true;
+}
+
+/**
+ * @brief VNotePeakFile::isEmpty
+ * @return 没有峰值时返回true
+ */
+bool VNotePeakFile::isEmpty() const
+{
+    return m_levels.isEmpty() || m_levels.first().isEmpty();
+}
+
+/**
+ * @brief VNotePeakFile::sampleRate
+ * @return 采样率
+ */
+int VNotePeakFile::sampleRate() const
+{
+    return m_sampleRate;
+}
+
+/**
+ * @brief VNotePeakFile::duration
+ * @return 录音时长，毫秒
+ */
+qint64 VNotePeakFile::duration() const
+{
+    return m_sampleRate > 0 ? m_frames * 1000 / m_sampleRate : 0;
+}
+
+/**
+ * @brief VNotePeakFile::levelCount
+ * @return 层数
+ */
+int VNotePeakFile::levelCount() const
+{
+    return m_levels.size();
+}
+
+/**
+ * @brief VNotePeakFile::level
+ * @param index 层级
+ * @return 该层的峰值
+ */
+const QVector<VNotePeak> &VNotePeakFile::level(int index) const
+{
+    return m_levels.at(index);
+}
+
+/**
+ * @brief VNotePeakFile::peaks
+ * 选择每段至少包含一个峰值的最粗层级，段内峰值合并
+ * @param startMs 开始时间
+ * @param endMs 结束时间
+ * @param count 段数
+ * @return 每段的峰值，超出录音的部分为0
+ */
+QVector<VNotePeak> VNotePeakFile::peaks(qint64 startMs, qint64 endMs, int count) const
+{
+    QVector<VNotePeak> result(qMax(count, 0));
+    if (isEmpty() || count <= 0 || endMs <= startMs) {
+        return result;
+    }
+
+    qint64 startFrame = startMs * m_sampleRate / 1000;
+    qint64 endFrame = endMs * m_sampleRate / 1000;
+    qreal bucketFrames = static_cast<qreal>(endFrame - startFrame) / count;
+
+    int index = 0;
+    qint64 levelFrames = BlockFrames;
+    while (index + 1 < m_levels.size() && levelFrames * LevelFactor <= bucketFrames) {
+        index++;
+        levelFrames *= LevelFactor;
+    }
+
+    const QVector<VNotePeak> &peaks = m_levels.at(index);
+    for (int i = 0; i < count; i++) {
+        qint64 first = (startFrame + static_cast<qint64>(i * bucketFrames)) / levelFrames;
+        qint64 last = (startFrame + static_cast<qint64>((i + 1) * bucketFrames) + levelFrames - 1) / levelFrames;
+        last = qMin(qMax(last, first + 1), static_cast<qint64>(peaks.size()));
+        if (first >= last) {
+            continue;
+        }
+
+        VNotePeak peak = peaks.at(static_cast<int>(first));
+        for (qint64 j = first + 1; j < last; j++) {
+            peak.min = qMin(peak.min, peaks.at(static_cast<int>(j)).min);
+            peak.max = qMax(peak.max, peaks.at(static_cast<int>(j)).max);
+        }
+        result[i] = peak;
+    }
+    return result;
+}
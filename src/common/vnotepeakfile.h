@@ -0,0 +1,79 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEPEAKFILE_H
+#define VNOTEPEAKFILE_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The VNotePeak struct
+ * 一段采样的最小值与最大值，S16采样取高8位
+ */
+struct VNotePeak {
+    qint8 min {0};
+    qint8 max {0};
+};
+
+/**
+ * @brief The VNotePeakFile class
+ * 录音波形峰值文件，录音时逐段统计，保存在录音文件旁，
+ * 播放时直接读取绘制波形，不需要解码录音
+ *
+ * 第0层每BlockFrames帧一个峰值，之后每层由上一层每LevelFactor个峰值合并，
+ * 文件格式（小端）：
+ * magic(4) version(2) levelCount(2) sampleRate(4) blockFrames(4) levelFactor(4) frames(8)
+ * 每层峰值数(4)*levelCount，之后依次为各层的峰值数据，每个峰值为min(1) max(1)
+ */
+class VNotePeakFile
+{
+public:
+    enum {
+        Magic = 0x4b504e56, //"VNPK"
+        Version = 1,
+        BlockFrames = 256, //第0层每个峰值的帧数
+        LevelFactor = 8, //相邻两层的帧数比
+        MaxLevels = 6, //最多层数
+    };
+
+    //录音文件对应的峰值文件路径
+    static QString peakPath(const QString &voicePath);
+    //录音文件改名后峰值文件随之改名，目标已存在时删除原文件
+    static void movePeakFile(const QString &voicePath, const QString &newVoicePath);
+
+    //开始统计新的录音
+    void reset(int sampleRate);
+    //追加交织的S16采样，所有通道合并统计
+    void appendS16(const qint16 *data, int frames, int channels);
+    //结束统计，生成各层峰值
+    void finish();
+    //结束统计并保存
+    bool save(const QString &path);
+    //读取峰值文件
+    bool load(const QString &path);
+
+    bool isEmpty() const;
+    int sampleRate() const;
+    //录音时长，毫秒
+    qint64 duration() const;
+    int levelCount() const;
+    const QVector<VNotePeak> &level(int index) const;
+    //将[startMs, endMs)均分为count段，返回每段的峰值，自动选择合适的层级
+    QVector<VNotePeak> peaks(qint64 startMs, qint64 endMs, int count) const;
+
+private:
+    //统计完整的块，写入第0层
+    void flushBlock();
+
+    int m_sampleRate {0};
+    qint64 m_frames {0}; //总帧数
+    QVector<QVector<VNotePeak>> m_levels;
+    int m_blockFrames {0}; //当前块已统计的帧数
+    int m_blockMin {0}; //当前块的最小值
+    int m_blockMax {0}; //当前块的最大值
+};
+
+#endif // VNOTEPEAKFILE_H
@@ -0,0 +1,104 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoterecordprofile.h"
+#include "globaldef.h"
+#include "setting.h"
+
+/**
+ * @brief VNoteRecordProfile::fromSettings
+ * 只能在主线程调用
+ * @return 录音编码配置
+ */
+VNoteRecordProfile VNoteRecordProfile::fromSettings()
+{
+    return fromCodec(setting::instance()->getOption(VNOTE_RECORD_CODEC).toInt());
+}
+
+/**
+ * @brief VNoteRecordProfile::fromCodec
+ * @param codec 编码格式
+ * @return 录音编码配置
+ */
+VNoteRecordProfile VNoteRecordProfile::fromCodec(int codec)
+{
+    VNoteRecordProfile profile;
+    switch (codec) {
+    case Opus:
+        //opus只支持48k等固定采样率，单声道语音32kbps已足够清晰
+        profile.codec = Opus;
+        profile.suffix = "ogg";
+        profile.element = "opusenc";
+        profile.encoder = "opusenc name=enc bitrate=32000 audio-type=voice ! oggmux";
+        profile.sampleRate = 48000;
+        profile.channels = 1;
+        profile.bitrate = 32;
+        profile.streamable = false;
+        break;
+    case Aac:
+        //adts格式每帧带头信息，可以直接拼接
+        profile.codec = Aac;
+        profile.suffix = "aac";
+        profile.element = "voaacenc";
+        profile.encoder = "voaacenc name=enc bitrate=64000 ! aacparse ! audio/mpeg,mpegversion=4,stream-format=adts";
+        profile.sampleRate = 44100;
+        profile.channels = 1;
+        profile.bitrate = 64;
+        profile.streamable = true;
+        break;
+    case Flac:
+        profile.codec = Flac;
+        profile.suffix = "flac";
+        profile.element = "flacenc";
+        profile.encoder = "flacenc name=enc quality=5";
+        profile.sampleRate = 44100;
+        profile.channels = 2;
+        profile.bitrate = 0;
+        profile.streamable = false;
+        break;
+    default:
+        profile.encoder = "lamemp3enc name=enc target=1 cbr=true bitrate=192";
+        break;
+    }
+    return profile;
+}
+
+/**
+ * @brief VNoteRecordProfile::voiceSuffixes
+ * @return 录音文件后缀
+ */
+QStringList VNoteRecordProfile::voiceSuffixes()
+{
+    QStringList suffixes;
+    for (int codec = Mp3; codec < CodecCount; codec++) {
+        suffixes.append(fromCodec(codec).suffix);
+    }
+    return suffixes;
+}
+
+/**
+ * @brief VNoteRecordProfile::voiceFilters
+ * @return 录音文件名称过滤
+ */
+QStringList VNoteRecordProfile::voiceFilters()
+{
+    QStringList filters;
+    for (const QString &suffix : voiceSuffixes()) {
+        filters.append("*." + suffix);
+    }
+    return filters;
+}
+
+/**
+ * @brief VNoteRecordProfile::pipeline
+ * @return 编码器的gstreamer描述
+ */
+QString VNoteRecordProfile::pipeline() const
+{
+    return QString("capsfilter caps=audio/x-raw,format=S16LE,rate=%1,channels=%2 ! %3")
+        .arg(sampleRate)
+        .arg(channels)
+        .arg(encoder);
+}
@@ -0,0 +1,51 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTERECORDPROFILE_H
+#define VNOTERECORDPROFILE_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The VNoteRecordProfile class
+ * 录音编码配置，决定编码器、采样参数和录音文件后缀。
+ * 编码器输入统一为S16LE，录音电平和波形峰值按此格式计算
+ */
+class VNoteRecordProfile
+{
+public:
+    //编码格式，与设置项的选项顺序一致
+    enum Codec {
+        Mp3 = 0, //兼容性最好
+        Opus, //语音，体积小
+        Aac,
+        Flac, //无损，用于存档
+        CodecCount,
+    };
+
+    //从设置中读取录音编码配置
+    static VNoteRecordProfile fromSettings();
+    //编码格式对应的配置，格式无效时为mp3
+    static VNoteRecordProfile fromCodec(int codec);
+    //所有录音文件后缀，不含点
+    static QStringList voiceSuffixes();
+    //所有录音文件的名称过滤
+    static QStringList voiceFilters();
+
+    //编码器输入格式及编码器，用于创建gstreamer编码器
+    QString pipeline() const;
+
+    Codec codec {Mp3};
+    QString suffix {"mp3"}; //录音文件后缀
+    QString element {"lamemp3enc"}; //编码器插件，未安装时不能使用该配置
+    QString encoder; //编码器及封装的gstreamer描述
+    int sampleRate {44100}; //采样率
+    int channels {2}; //声道数
+    int bitrate {192}; //码率，单位kbps，无损编码为0
+    bool streamable {true}; //编码输出由独立的帧组成，分段可以直接拼接
+};
+
+#endif // VNOTERECORDPROFILE_H
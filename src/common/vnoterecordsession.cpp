@@ -0,0 +1,369 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoterecordsession.h"
+#include "vnotedatamanager.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+
+#include <cstdio>
+#include <unistd.h>
+
+static const QString manifestName = "session.json";
+static const QString segmentPattern = "segment_%05d.";
+static const qint64 copyChunkSize = 256 * 1024;
+
+/**
+ * @brief VNoteRecordSession::sessionRoot
+ * 位于录音目录下的隐藏目录，文件清理只扫描录音目录下的文件，不会删除分段
+ * @return 会话目录的上级目录
+ */
+QString VNoteRecordSession::sessionRoot()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/voicenote/.segments";
+}
+
+/**
+ * @brief VNoteRecordSession::sessionDir
+ * @param outputPath 录音文件路径
+ * @return 会话目录
+ */
+QString VNoteRecordSession::sessionDir(const QString &outputPath)
+{
+    return sessionRoot() + "/" + QFileInfo(outputPath).completeBaseName();
+}
+
+/**
+ * @brief VNoteRecordSession::begin
+ * @param outputPath 录音文件路径
+ * @param bitrate 编码码率，无损编码为0
+ * @return 分段文件名模板
+ */
+QString VNoteRecordSession::begin(const QString &outputPath, int bitrate)
+{
+    QString dirPath = sessionDir(outputPath);
+    //同名的旧会话已恢复或合并失败，不能与新录音混在一起
+    QDir(dirPath).removeRecursively();
+    if (!QDir().mkpath(dirPath)) {
+        qCritical() << __FUNCTION__ << "create session failed:" << dirPath;
+        return "";
+    }
+
+    QJsonObject manifest;
+    manifest.insert("output", outputPath);
+    manifest.insert("createTime", QDateTime::currentMSecsSinceEpoch());
+    manifest.insert("noteId", -1);
+    manifest.insert("bitrate", bitrate);
+    manifest.insert("duration", 0);
+    manifest.insert("recovered", false);
+    if (!writeManifest(dirPath, manifest)) {
+        return "";
+    }
+    //分段与录音文件格式相同
+    return dirPath + "/" + segmentPattern + QFileInfo(outputPath).suffix();
+}
+
+/**
+ * @brief VNoteRecordSession::setNoteId
+ * @param outputPath 录音文件路径
+ * @param noteId 笔记id
+ * @return 成功返回true
+ */
+bool VNoteRecordSession::setNoteId(const QString &outputPath, qint32 noteId)
+{
+    return updateManifest(outputPath, "noteId", noteId);
+}
+
+/**
+ * @brief VNoteRecordSession::setDuration
+ * @param outputPath 录音文件路径
+ * @param duration 已录制时长，单位毫秒
+ * @return 成功返回true
+ */
+bool VNoteRecordSession::setDuration(const QString &outputPath, qint64 duration)
+{
+    return updateManifest(outputPath, "duration", duration);
+}
+
+/**
+ * @brief VNoteRecordSession::finish
+ * 合并失败时保留会话目录，下次启动再恢复
+ * @param outputPath 录音文件路径
+ * @return 成功返回true
+ */
+bool VNoteRecordSession::finish(const QString &outputPath)
+{
+    QString dirPath = sessionDir(outputPath);
+    QStringList segmentPaths = segments(dirPath);
+    if (segmentPaths.isEmpty()) {
+        QDir(dirPath).removeRecursively();
+        return false;
+    }
+
+    //只有一个分段时不需要复制
+    bool moved = 1 == segmentPaths.size() && moveSegment(segmentPaths.first(), outputPath);
+    if (!moved && !concatenate(segmentPaths, outputPath)) {
+        qCritical() << __FUNCTION__ << "concatenate segments failed:" << outputPath;
+        return false;
+    }
+    QDir(dirPath).removeRecursively();
+    return true;
+}
+
+/**
+ * @brief VNoteRecordSession::recover
+ * 在笔记数据加载完成后、开始录音前调用，此时所有会话都是异常退出遗留的。
+ * 笔记打开时再合并插入，避免插入到其他笔记
+ * @return 待恢复的录音数量
+ */
+int VNoteRecordSession::recover()
+{
+    int count = 0;
+    QDir root(sessionRoot());
+    for (const QFileInfo &info : root.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QString dirPath = info.absoluteFilePath();
+        QJsonObject manifest = readManifest(dirPath);
+        qint32 noteId = manifest.value("noteId").toInt(-1);
+
+        qint64 bytes = 0;
+        for (const QString &path : segments(dirPath)) {
+            bytes += QFileInfo(path).size();
+        }
+
+        //笔记已删除或录音过短时不再恢复
+        if (manifest.value("output").toString().isEmpty()
+            || nullptr == VNoteDataManager::instance()->findNote(noteId)
+            || recoveredDuration(manifest, bytes) < MinDuration) {
+            QDir(dirPath).removeRecursively();
+            continue;
+        }
+
+        manifest.insert("recovered", true);
+        if (writeManifest(dirPath, manifest)) {
+            count++;
+        }
+    }
+
+    if (count > 0) {
+        qInfo() << __FUNCTION__ << "recovered recordings:" << count;
+    }
+    return count;
+}
+
+/**
+ * @brief VNoteRecordSession::hasRecovered
+ * @param noteId 笔记id
+ * @return 有待恢复的录音返回true
+ */
+bool VNoteRecordSession::hasRecovered(qint32 noteId)
+{
+    QDir root(sessionRoot());
+    for (const QFileInfo &info : root.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QJsonObject manifest = readManifest(info.absoluteFilePath());
+        if (manifest.value("recovered").toBool() && manifest.value("noteId").toInt(-1) == noteId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief VNoteRecordSession::finishRecovered
+ * 分段复制合并，不移动，插入笔记前中断时下次仍可恢复
+ * @param noteId 笔记id
+ * @return 合并后的录音文件
+ */
+QList<VNoteRecordSession::Recovered> VNoteRecordSession::finishRecovered(qint32 noteId)
+{
+    QList<Recovered> recovered;
+    QDir root(sessionRoot());
+    for (const QFileInfo &info : root.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)) {
+        QString dirPath = info.absoluteFilePath();
+        QJsonObject manifest = readManifest(dirPath);
+        if (!manifest.value("recovered").toBool() || manifest.value("noteId").toInt(-1) != noteId) {
+            continue;
+        }
+
+        Recovered voice;
+        voice.path = manifest.value("output").toString();
+        voice.createTime = QDateTime::fromMSecsSinceEpoch(
+            static_cast<qint64>(manifest.value("createTime").toDouble()));
+        QStringList segmentPaths = segments(dirPath);
+        if (segmentPaths.isEmpty()) {
+            QDir(dirPath).removeRecursively();
+            continue;
+        }
+        if (concatenate(segmentPaths, voice.path)) {
+            voice.duration = recoveredDuration(manifest, QFileInfo(voice.path).size());
+            recovered.append(voice);
+        } else {
+            qCritical() << __FUNCTION__ << "concatenate segments failed:" << voice.path;
+        }
+    }
+    return recovered;
+}
+
+/**
+ * @brief VNoteRecordSession::discard
+ * @param outputPath 录音文件路径
+ */
+void VNoteRecordSession::discard(const QString &outputPath)
+{
+    QDir(sessionDir(outputPath)).removeRecursively();
+}
+
+/**
+ * @brief VNoteRecordSession::segments
+ * @param dirPath 会话目录
+ * @return 分段文件路径
+ */
+QStringList VNoteRecordSession::segments(const QString &dirPath)
+{
+    QStringList segmentPaths;
+    QDir dir(dirPath);
+    //序号补零，按文件名排序即为录制顺序
+    for (const QString &fileName : dir.entryList(QStringList("segment_*"), QDir::Files, QDir::Name)) {
+        segmentPaths.append(dir.filePath(fileName));
+    }
+    return segmentPaths;
+}
+
+/**
+ * @brief VNoteRecordSession::estimateDuration
+ * @param bytes 录音数据大小
+ * @param bitrate 码率，单位kbps
+ * @return 时长，单位毫秒
+ */
+qint64 VNoteRecordSession::estimateDuration(qint64 bytes, int bitrate)
+{
+    return bitrate > 0 ? bytes * 8 / bitrate : 0;
+}
+
+/**
+ * @brief VNoteRecordSession::recoveredDuration
+ * @param manifest 会话记录
+ * @param bytes 录音数据大小
+ * @return 时长，单位毫秒
+ */
+qint64 VNoteRecordSession::recoveredDuration(const QJsonObject &manifest, qint64 bytes)
+{
+    int bitrate = manifest.value("bitrate").toInt();
+    if (bitrate > 0) {
+        return estimateDuration(bytes, bitrate);
+    }
+    return static_cast<qint64>(manifest.value("duration").toDouble());
+}
+
+/**
+ * @brief VNoteRecordSession::concatenate
+ * mp3、adts等格式由独立的帧组成，分段在帧边界切分，直接拼接即为完整录音，
+ * 带文件头的格式只有一个分段
+ * @param segmentPaths 分段文件路径
+ * @param outputPath 目标文件
+ * @return 成功返回true
+ */
+bool VNoteRecordSession::concatenate(const QStringList &segmentPaths, const QString &outputPath)
+{
+    QSaveFile output(outputPath);
+    if (!output.open(QIODevice::WriteOnly)) {
+        qCritical() << __FUNCTION__ << "open output failed:" << outputPath << output.errorString();
+        return false;
+    }
+
+    for (const QString &path : segmentPaths) {
+        QFile segment(path);
+        if (!segment.open(QIODevice::ReadOnly)) {
+            qCritical() << __FUNCTION__ << "open segment failed:" << path << segment.errorString();
+            output.cancelWriting();
+            return false;
+        }
+        while (!segment.atEnd()) {
+            QByteArray data = segment.read(copyChunkSize);
+            if (data.isEmpty() || output.write(data) != data.size()) {
+                output.cancelWriting();
+                return false;
+            }
+        }
+    }
+
+    //替换前写入磁盘，重命名后的文件内容完整
+    if (!output.flush() || 0 != fsync(output.handle())) {
+        output.cancelWriting();
+        return false;
+    }
+    return output.commit();
+}
+
+/**
+ * @brief VNoteRecordSession::moveSegment
+ * @param segmentPath 分段文件
+ * @param outputPath 目标文件
+ * @return 成功返回true
+ */
+bool VNoteRecordSession::moveSegment(const QString &segmentPath, const QString &outputPath)
+{
+    QFile segment(segmentPath);
+    if (!segment.open(QIODevice::ReadOnly) || 0 != fsync(segment.handle())) {
+        return false;
+    }
+    segment.close();
+    //rename原子替换已存在的目标文件
+    return 0 == std::rename(QFile::encodeName(segmentPath).constData(), QFile::encodeName(outputPath).constData());
+}
+
+/**
+ * @brief VNoteRecordSession::updateManifest
+ * @param outputPath 录音文件路径
+ * @param key 记录项
+ * @param value 记录值
+ * @return 成功返回true
+ */
+bool VNoteRecordSession::updateManifest(const QString &outputPath, const QString &key, const QJsonValue &value)
+{
+    QString dirPath = sessionDir(outputPath);
+    QJsonObject manifest = readManifest(dirPath);
+    if (manifest.isEmpty()) {
+        return false;
+    }
+    manifest.insert(key, value);
+    return writeManifest(dirPath, manifest);
+}
+
+/**
+ * @brief VNoteRecordSession::readManifest
+ * @param dirPath 会话目录
+ * @return 会话记录，不存在或已损坏时为空
+ */
+QJsonObject VNoteRecordSession::readManifest(const QString &dirPath)
+{
+    QFile file(dirPath + "/" + manifestName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+/**
+ * @brief VNoteRecordSession::writeManifest
+ * @param dirPath 会话目录
+ * @param manifest 会话记录
+ * @return 成功返回true
+ */
+bool VNoteRecordSession::writeManifest(const QString &dirPath, const QJsonObject &manifest)
+{
+    QSaveFile file(dirPath + "/" + manifestName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCritical() << __FUNCTION__ << "write manifest failed:" << dirPath << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(manifest).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
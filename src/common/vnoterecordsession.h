@@ -0,0 +1,77 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTERECORDSESSION_H
+#define VNOTERECORDSESSION_H
+
+#include <QDateTime>
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+
+/**
+ * @brief The VNoteRecordSession class
+ * 录音会话，录音过程中按固定时长分段写入会话目录，已完成的分段在后台同步到磁盘，
+ * 停止录音时按顺序合并分段并原子替换录音文件，程序异常退出时启动后恢复遗留的分段
+ *
+ * 会话目录下session.json记录：
+ * {"output":录音文件路径, "createTime":开始时间毫秒, "noteId":所属笔记, "bitrate":码率,
+ *  "duration":已录制时长, "recovered":是否待恢复}
+ */
+class VNoteRecordSession
+{
+public:
+    enum {
+        SegmentDuration = 10, //分段时长，单位秒
+        MinDuration = 1000, //可恢复的最短录音，单位毫秒，与插入录音的限制一致
+    };
+
+    //待插入笔记的恢复录音
+    struct Recovered {
+        QString path; //录音文件路径
+        qint64 duration {0}; //录音时长，单位毫秒
+        QDateTime createTime; //录音开始时间
+    };
+
+    //所有会话目录的上级目录
+    static QString sessionRoot();
+    //录音文件对应的会话目录
+    static QString sessionDir(const QString &outputPath);
+    //开始录音会话，bitrate为编码码率，返回分段文件名模板，失败返回空
+    static QString begin(const QString &outputPath, int bitrate);
+    //记录录音所属的笔记，恢复时插入该笔记
+    static bool setNoteId(const QString &outputPath, qint32 noteId);
+    //记录已录制的时长，无法按码率估算时长时使用
+    static bool setDuration(const QString &outputPath, qint64 duration);
+    //按顺序合并分段，原子写入录音文件并删除会话目录
+    static bool finish(const QString &outputPath);
+    //启动时检查异常退出遗留的会话，返回待恢复的录音数量
+    static int recover();
+    //笔记是否有待恢复的录音
+    static bool hasRecovered(qint32 noteId);
+    //合并笔记待恢复的录音，会话保留到录音插入笔记后再删除，可以重复合并
+    static QList<Recovered> finishRecovered(qint32 noteId);
+    //录音已插入笔记，删除会话目录
+    static void discard(const QString &outputPath);
+
+    //会话目录下按序号排列的分段文件
+    static QStringList segments(const QString &dirPath);
+    //按码率估算时长，单位毫秒，码率单位kbps
+    static qint64 estimateDuration(qint64 bytes, int bitrate);
+
+private:
+    //更新会话记录中的一项
+    static bool updateManifest(const QString &outputPath, const QString &key, const QJsonValue &value);
+    //恢复的录音时长，有码率时按大小估算，否则使用最后记录的时长
+    static qint64 recoveredDuration(const QJsonObject &manifest, qint64 bytes);
+    //按顺序拼接分段写入目标文件，写入完成后才替换目标文件
+    static bool concatenate(const QStringList &segmentPaths, const QString &outputPath);
+    //只有一个分段时写入磁盘后直接重命名为目标文件，不在同一文件系统时失败
+    static bool moveSegment(const QString &segmentPath, const QString &outputPath);
+    static QJsonObject readManifest(const QString &dirPath);
+    static bool writeManifest(const QString &dirPath, const QJsonObject &manifest);
+};
+
+#endif // VNOTERECORDSESSION_H
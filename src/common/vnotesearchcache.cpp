@@ -0,0 +1,61 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnotesearchcache.h"
+
+/**
+ * @brief VNoteSearchCache::VNoteSearchCache
+ * @param maxCount 最多缓存的关键字数量
+ */
+VNoteSearchCache::VNoteSearchCache(int maxCount)
+    : m_cache(maxCount)
+{
+}
+
+/**
+ * @brief VNoteSearchCache::find
+ * @param key 搜索关键字
+ * @param dataVersion 当前数据版本号
+ * @param noteIds 命中的笔记id
+ * @return true 缓存命中
+ */
+bool VNoteSearchCache::find(const QString &key, int dataVersion, QVector<qint32> &noteIds)
+{
+    Entry *entry = m_cache.object(key);
+    if (nullptr == entry) {
+        return false;
+    }
+
+    //数据已变化，结果过期
+    if (entry->dataVersion != dataVersion) {
+        m_cache.remove(key);
+        return false;
+    }
+
+    noteIds = entry->noteIds;
+    return true;
+}
+
+/**
+ * @brief VNoteSearchCache::insert
+ * @param key 搜索关键字
+ * @param dataVersion 当前数据版本号
+ * @param noteIds 命中的笔记id
+ */
+void VNoteSearchCache::insert(const QString &key, int dataVersion, const QVector<qint32> &noteIds)
+{
+    Entry *entry = new Entry;
+    entry->dataVersion = dataVersion;
+    entry->noteIds = noteIds;
+    m_cache.insert(key, entry);
+}
+
+/**
+ * @brief VNoteSearchCache::clear
+ */
+void VNoteSearchCache::clear()
+{
+    m_cache.clear();
+}
@@ -0,0 +1,39 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTESEARCHCACHE_H
+#define VNOTESEARCHCACHE_H
+
+#include <QCache>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The VNoteSearchCache class
+ * 搜索结果缓存，按关键字保存命中的笔记id，最近最少使用的结果优先淘汰，
+ * 数据版本号变化后缓存结果失效
+ */
+class VNoteSearchCache
+{
+public:
+    explicit VNoteSearchCache(int maxCount = 32);
+
+    //查找缓存结果，版本号不一致时视为未命中
+    bool find(const QString &key, int dataVersion, QVector<qint32> &noteIds);
+    //保存搜索结果
+    void insert(const QString &key, int dataVersion, const QVector<qint32> &noteIds);
+    //清空缓存
+    void clear();
+
+private:
+    struct Entry {
+        int dataVersion {0}; //结果对应的数据版本号
+        QVector<qint32> noteIds; //命中的笔记id
+    };
+
+    QCache<QString, Entry> m_cache;
+};
+
+#endif // VNOTESEARCHCACHE_H
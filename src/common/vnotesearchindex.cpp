@@ -0,0 +1,468 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnotesearchindex.h"
+#include "vnoteitem.h"
+#include "vnotedatamanager.h"
+#include "metadataparser.h"
+#include "task/textextractworker.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QDebug>
+
+VNoteSearchIndex *VNoteSearchIndex::_instance = nullptr;
+
+/**
+ * @brief cacheFilePath
+ * @return ocr结果缓存文件路径
+ */
+static QString cacheFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/searchindex.json";
+}
+
+/**
+ * @brief VNoteSearchIndex::VNoteSearchIndex
+ * @param parent
+ */
+VNoteSearchIndex::VNoteSearchIndex(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);
+}
+
+VNoteSearchIndex::~VNoteSearchIndex()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+    qDeleteAll(m_extractors);
+    m_extractors.clear();
+}
+
+/**
+ * @brief VNoteSearchIndex::instance
+ * 创建单例并注册默认的语音、ocr提取器
+ * @return 单例对象
+ */
+VNoteSearchIndex *VNoteSearchIndex::instance()
+{
+    if (nullptr == _instance) {
+        _instance = new VNoteSearchIndex();
+        _instance->registerExtractor(new VNoteVoiceTextExtractor);
+
+        VNoteOcrTextExtractor *ocr = new VNoteOcrTextExtractor;
+        if (ocr->isAvailable()) {
+            _instance->registerExtractor(ocr);
+        } else {
+            qInfo() << "ocr program not found, image text will not be indexed";
+            delete ocr;
+        }
+
+        _instance->loadCache();
+    }
+
+    return _instance;
+}
+
+/**
+ * @brief VNoteSearchIndex::registerExtractor
+ * @param extractor 提取器
+ */
+void VNoteSearchIndex::registerExtractor(VNoteTextExtractor *extractor)
+{
+    if (nullptr != extractor) {
+        QWriteLocker locker(&m_indexLock);
+        m_extractors.append(extractor);
+    }
+}
+
+/**
+ * @brief VNoteSearchIndex::collectItems
+ * 从笔记内容中解析语音及图片附件
+ * @param note 笔记数据
+ * @return 附件列表
+ */
+QList<VNoteExtractItem> VNoteSearchIndex::collectItems(const VNoteItem *note)
+{
+    QList<VNoteExtractItem> items;
+    if (nullptr == note) {
+        return items;
+    }
+
+    if (note->htmlCode.isEmpty()) {
+        //5.9及以前版本的数据
+        for (auto block : note->datas.voiceBlocks) {
+            VNoteExtractItem item;
+            item.type = VNoteExtractItem::Voice;
+            item.path = block->ptrVoice->voicePath;
+            item.hint = block->blockText;
+            items.append(item);
+        }
+        return items;
+    }
+
+    //语音转写结果保存在语音块json数据中
+    MetaDataParser dataParser;
+    for (auto json : note->getVoiceJsons()) {
+        VNVoiceBlock voiceBlock;
+        if (dataParser.parse(json, &voiceBlock)) {
+            VNoteExtractItem item;
+            item.type = VNoteExtractItem::Voice;
+            item.path = voiceBlock.voicePath;
+            item.hint = voiceBlock.blockText;
+            items.append(item);
+        }
+    }
+
+    //匹配图片块标签的正则表达式
+    QRegExp rx("<img.+src=.+>");
+    rx.setMinimal(true); //最小匹配
+    //匹配本地图片路径的正则表达式
+    QRegExp rxPath("(/\\S+)+/images/[\\w\\-]+\\.[a-z]{3,4}");
+    rxPath.setMinimal(false); //最大匹配
+    int pos = 0;
+    while ((pos = rx.indexIn(note->htmlCode, pos)) != -1) {
+        if (rxPath.indexIn(rx.cap(0)) != -1) {
+            VNoteExtractItem item;
+            item.type = VNoteExtractItem::Image;
+            item.path = rxPath.cap(0);
+            items.append(item);
+        }
+        pos += rx.matchedLength();
+    }
+
+    return items;
+}
+
+/**
+ * @brief VNoteSearchIndex::scheduleAllNotes
+ * 启动时以最低优先级加入所有笔记的附件
+ * @param notesMap 所有笔记数据
+ */
+void VNoteSearchIndex::scheduleAllNotes(VNOTE_ALL_NOTES_MAP *notesMap)
+{
+    if (nullptr == notesMap) {
+        return;
+    }
+
+    notesMap->lock.lockForRead();
+    for (auto &folderNotes : notesMap->notes) {
+        for (auto note : folderNotes->folderNotes) {
+            enqueue(note->noteId, collectItems(note), Low);
+        }
+    }
+    notesMap->lock.unlock();
+
+    startWorker();
+}
+
+/**
+ * @brief VNoteSearchIndex::scheduleNote
+ * @param note 笔记数据
+ * @param priority 优先级
+ */
+void VNoteSearchIndex::scheduleNote(const VNoteItem *note, Priority priority)
+{
+    if (nullptr == note) {
+        return;
+    }
+
+    enqueue(note->noteId, collectItems(note), priority);
+    startWorker();
+}
+
+/**
+ * @brief VNoteSearchIndex::enqueue
+ * 更新笔记的附件列表，文本未变化的附件不再重复提取
+ * @param noteId 笔记id
+ * @param items 附件列表
+ * @param priority 优先级
+ */
+void VNoteSearchIndex::enqueue(qint32 noteId, const QList<VNoteExtractItem> &items, Priority priority)
+{
+    QList<VNoteExtractItem> pending;
+    QStringList paths;
+    {
+        QWriteLocker locker(&m_indexLock);
+        for (const VNoteExtractItem &item : items) {
+            if (item.path.isEmpty()) {
+                continue;
+            }
+            paths.append(item.path);
+
+            auto it = m_texts.find(item.path);
+            if (VNoteExtractItem::Voice == item.type) {
+                //转写结果未变化
+                if (it != m_texts.end() && it.value() == item.hint.simplified()) {
+                    continue;
+                }
+            } else {
+                if (it != m_texts.end()) {
+                    continue;
+                }
+                //命中磁盘缓存
+                auto cacheIt = m_cache.find(item.path);
+                if (cacheIt != m_cache.end()) {
+                    m_texts.insert(item.path, cacheIt.value());
+                    continue;
+                }
+            }
+            pending.append(item);
+        }
+        m_noteItems.insert(noteId, paths);
+    }
+
+    if (pending.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(&m_queueLock);
+    for (const VNoteExtractItem &item : pending) {
+        int target = priority;
+        if (m_queuedPaths.contains(item.path)) {
+            //已在队列中，移除旧数据（语音转写结果可能已更新），按较高的优先级重新加入
+            for (int i = 0; i < PriorityCount; i++) {
+                for (int j = m_queues[i].size() - 1; j >= 0; j--) {
+                    if (m_queues[i].at(j).path == item.path) {
+                        m_queues[i].removeAt(j);
+                        target = qMin(target, i);
+                    }
+                }
+            }
+        }
+        m_queuedPaths.insert(item.path);
+        m_queues[target].append(item);
+    }
+}
+
+/**
+ * @brief VNoteSearchIndex::removeNote
+ * 附件去重、复制和移动后多个笔记可能引用同一附件，只删除不再被引用的文本
+ * @param noteId 笔记id
+ */
+void VNoteSearchIndex::removeNote(qint32 noteId)
+{
+    QWriteLocker locker(&m_indexLock);
+    QSet<QString> paths = m_noteItems.take(noteId).toSet();
+    for (const QStringList &items : m_noteItems) {
+        for (const QString &path : items) {
+            paths.remove(path);
+        }
+        if (paths.isEmpty()) {
+            return;
+        }
+    }
+    for (const QString &path : paths) {
+        m_texts.remove(path);
+    }
+}
+
+/**
+ * @brief VNoteSearchIndex::search
+ * @param note 笔记数据
+ * @param keyword 搜索关键字
+ * @return true 笔记附件文本包含关键字
+ */
+bool VNoteSearchIndex::search(const VNoteItem *note, const QString &keyword)
+{
+    if (nullptr == note || keyword.isEmpty()) {
+        return false;
+    }
+
+    QReadLocker locker(&m_indexLock);
+    for (const QString &path : m_noteItems.value(note->noteId)) {
+        if (m_texts.value(path).contains(keyword, Qt::CaseInsensitive)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief VNoteSearchIndex::extractedText
+ * @param path 附件路径
+ * @return 已提取的文本
+ */
+QString VNoteSearchIndex::extractedText(const QString &path)
+{
+    QReadLocker locker(&m_indexLock);
+    return m_texts.value(path);
+}
+
+/**
+ * @brief VNoteSearchIndex::takeBatch
+ * 按优先级取出一批附件，队列为空时标记后台任务结束
+ * @param maxCount 最大数量
+ * @return 附件列表
+ */
+QList<VNoteExtractItem> VNoteSearchIndex::takeBatch(int maxCount)
+{
+    QList<VNoteExtractItem> batch;
+    QMutexLocker locker(&m_queueLock);
+    for (int i = 0; i < PriorityCount && batch.size() < maxCount; i++) {
+        while (!m_queues[i].isEmpty() && batch.size() < maxCount) {
+            VNoteExtractItem item = m_queues[i].takeFirst();
+            m_queuedPaths.remove(item.path);
+            batch.append(item);
+        }
+    }
+
+    if (batch.isEmpty()) {
+        m_workerRunning = false;
+    }
+
+    return batch;
+}
+
+/**
+ * @brief VNoteSearchIndex::extract
+ * 使用第一个支持该附件的提取器提取文本
+ * @param item 附件
+ * @return 提取的文本
+ */
+QString VNoteSearchIndex::extract(const VNoteExtractItem &item)
+{
+    QList<VNoteTextExtractor *> extractors;
+    {
+        QReadLocker locker(&m_indexLock);
+        extractors = m_extractors;
+    }
+
+    for (VNoteTextExtractor *extractor : extractors) {
+        if (extractor->canExtract(item)) {
+            return extractor->extract(item);
+        }
+    }
+
+    return "";
+}
+
+/**
+ * @brief VNoteSearchIndex::setExtractedText
+ * @param item 附件
+ * @param text 提取的文本
+ */
+void VNoteSearchIndex::setExtractedText(const VNoteExtractItem &item, const QString &text)
+{
+    QWriteLocker locker(&m_indexLock);
+    m_texts.insert(item.path, text);
+
+    if (VNoteExtractItem::Voice != item.type) {
+        for (VNoteTextExtractor *extractor : m_extractors) {
+            if (extractor->canExtract(item) && extractor->cacheable()) {
+                m_cache.insert(item.path, text);
+                m_cacheChanged = true;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief VNoteSearchIndex::startWorker
+ * 队列不为空且没有运行中的任务时启动后台任务
+ */
+void VNoteSearchIndex::startWorker()
+{
+    {
+        QMutexLocker locker(&m_queueLock);
+        if (m_workerRunning) {
+            return;
+        }
+        bool isEmpty = true;
+        for (int i = 0; i < PriorityCount; i++) {
+            isEmpty = isEmpty && m_queues[i].isEmpty();
+        }
+        if (isEmpty) {
+            return;
+        }
+        m_workerRunning = true;
+    }
+
+    TextExtractWorker *worker = new TextExtractWorker(this);
+    worker->setAutoDelete(true);
+    worker->setObjectName("TextExtractWorker");
+    connect(worker, &TextExtractWorker::extractFinished, this, &VNoteSearchIndex::onWorkerFinished);
+    m_pool.start(worker);
+}
+
+/**
+ * @brief VNoteSearchIndex::onWorkerFinished
+ * @param count 提取的附件数
+ */
+void VNoteSearchIndex::onWorkerFinished(int count)
+{
+    //附件文本变化后，已缓存的搜索结果需要失效
+    if (count > 0) {
+        VNoteDataManager::instance()->increaseDataVersion();
+    }
+    emit batchExtracted(count);
+    //处理期间可能有新加入的附件
+    startWorker();
+}
+
+/**
+ * @brief VNoteSearchIndex::waitForDone
+ * @param msecs 超时时间
+ */
+void VNoteSearchIndex::waitForDone(int msecs)
+{
+    m_pool.waitForDone(msecs);
+}
+
+/**
+ * @brief VNoteSearchIndex::loadCache
+ * 加载ocr结果磁盘缓存，已识别的图片不再重复识别
+ */
+void VNoteSearchIndex::loadCache()
+{
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonObject obj = QJsonDocument::fromJson(file.readAll()).object();
+    QWriteLocker locker(&m_indexLock);
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        //图片已被清理
+        if (QFile::exists(it.key())) {
+            m_cache.insert(it.key(), it.value().toString());
+        } else {
+            m_cacheChanged = true;
+        }
+    }
+}
+
+/**
+ * @brief VNoteSearchIndex::saveCache
+ */
+void VNoteSearchIndex::saveCache()
+{
+    QJsonObject obj;
+    {
+        QWriteLocker locker(&m_indexLock);
+        if (!m_cacheChanged) {
+            return;
+        }
+        m_cacheChanged = false;
+        for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+            obj.insert(it.key(), it.value());
+        }
+    }
+
+    QDir().mkpath(QFileInfo(cacheFilePath()).absolutePath());
+    QSaveFile file(cacheFilePath());
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTESEARCHINDEX_H
+#define VNOTESEARCHINDEX_H
+
+#include "datatypedef.h"
+#include "vnotetextextractor.h"
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QThreadPool>
+
+struct VNoteItem;
+class TextExtractWorker;
+
+/**
+ * @brief The VNoteSearchIndex class
+ * 附件文本搜索索引，后台按优先级批量提取语音转写文本、图片ocr文本，
+ * 供笔记搜索时匹配附件内容
+ */
+class VNoteSearchIndex : public QObject
+{
+    Q_OBJECT
+public:
+    //提取优先级，数值越小越先处理
+    enum Priority {
+        High = 0, //当前编辑的笔记
+        Normal, //新增、修改的笔记
+        Low, //启动时的全量数据
+        PriorityCount
+    };
+
+    explicit VNoteSearchIndex(QObject *parent = nullptr);
+    ~VNoteSearchIndex() override;
+
+    static VNoteSearchIndex *instance();
+
+    //注册提取器，索引对象负责释放
+    void registerExtractor(VNoteTextExtractor *extractor);
+    //加入所有笔记的附件
+    void scheduleAllNotes(VNOTE_ALL_NOTES_MAP *notesMap);
+    //笔记内容变化后重新收集附件
+    void scheduleNote(const VNoteItem *note, Priority priority = Normal);
+    //删除笔记的附件索引
+    void removeNote(qint32 noteId);
+    //笔记附件内容是否包含关键字
+    bool search(const VNoteItem *note, const QString &keyword);
+    //获取附件已提取的文本
+    QString extractedText(const QString &path);
+    //等待后台任务结束
+    void waitForDone(int msecs = -1);
+
+    //获取笔记内所有附件
+    static QList<VNoteExtractItem> collectItems(const VNoteItem *note);
+
+signals:
+    //一批附件提取完成
+    void batchExtracted(int count);
+
+protected slots:
+    //后台任务结束
+    void onWorkerFinished(int count);
+
+protected:
+    //取出一批待提取附件，队列为空时返回空列表
+    QList<VNoteExtractItem> takeBatch(int maxCount);
+    //提取单个附件文本
+    QString extract(const VNoteExtractItem &item);
+    //保存提取结果
+    void setExtractedText(const VNoteExtractItem &item, const QString &text);
+    //启动后台任务
+    void startWorker();
+    //加载、保存ocr磁盘缓存
+    void loadCache();
+    void saveCache();
+
+private:
+    //加入待提取队列
+    void enqueue(qint32 noteId, const QList<VNoteExtractItem> &items, Priority priority);
+
+    static VNoteSearchIndex *_instance;
+
+    QList<VNoteTextExtractor *> m_extractors; //已注册的提取器
+    QReadWriteLock m_indexLock; //索引数据读写锁
+    QHash<qint32, QStringList> m_noteItems; //笔记包含的附件路径，笔记id全局唯一
+    QHash<QString, QString> m_texts; //附件路径对应的文本
+    QHash<QString, QString> m_cache; //可缓存的提取结果（ocr）
+    bool m_cacheChanged {false}; //缓存是否需要保存
+
+    QMutex m_queueLock; //待提取队列锁
+    QList<VNoteExtractItem> m_queues[PriorityCount]; //各优先级待提取队列
+    QSet<QString> m_queuedPaths; //已在队列中的路径，防止重复提取
+    bool m_workerRunning {false}; //后台任务是否运行中
+    QThreadPool m_pool; //独立线程池，不占用全局线程池
+
+    friend class TextExtractWorker;
+};
+
+#endif // VNOTESEARCHINDEX_H
@@ -0,0 +1,67 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTESPSCRING_H
+#define VNOTESPSCRING_H
+
+#include <QAtomicInteger>
+
+/**
+ * @brief The VNoteSpscRing class
+ * 单生产者单消费者无锁环形队列，槽位预先分配，生产者在槽位上直接写入，
+ * 消费者直接读取槽位，不加锁也不拷贝
+ * Size必须为2的幂，队列满时生产者放弃写入
+ */
+template<typename T, int Size>
+class VNoteSpscRing
+{
+    static_assert(Size > 1 && (Size & (Size - 1)) == 0, "Size must be a power of two");
+
+public:
+    //生产者：获取可写槽位，队列满时返回nullptr
+    T *beginWrite()
+    {
+        quint32 head = m_head.load();
+        if (head - m_tail.loadAcquire() >= static_cast<quint32>(Size)) {
+            return nullptr;
+        }
+        return &m_slots[head & (Size - 1)];
+    }
+
+    //生产者：提交beginWrite获取的槽位
+    void endWrite()
+    {
+        m_head.storeRelease(m_head.load() + 1);
+    }
+
+    //消费者：获取最早的可读槽位，队列空时返回nullptr
+    const T *front() const
+    {
+        quint32 tail = m_tail.load();
+        if (tail == m_head.loadAcquire()) {
+            return nullptr;
+        }
+        return &m_slots[tail & (Size - 1)];
+    }
+
+    //消费者：释放front获取的槽位
+    void pop()
+    {
+        m_tail.storeRelease(m_tail.load() + 1);
+    }
+
+    //消费者：丢弃全部数据
+    void clear()
+    {
+        m_tail.storeRelease(m_head.loadAcquire());
+    }
+
+private:
+    T m_slots[Size];
+    QAtomicInteger<quint32> m_head {0}; //写入计数，只由生产者修改，溢出后回绕
+    QAtomicInteger<quint32> m_tail {0}; //读取计数，只由消费者修改
+};
+
+#endif // VNOTESPSCRING_H
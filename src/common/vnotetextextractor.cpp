@@ -0,0 +1,131 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnotetextextractor.h"
+
+#include <QFileInfo>
+#include <QProcess>
+#include <QStandardPaths>
+#include <QDebug>
+
+VNoteTextExtractor::~VNoteTextExtractor()
+{
+}
+
+/**
+ * @brief VNoteTextExtractor::cacheable
+ * @return true 提取结果可写入磁盘缓存
+ */
+bool VNoteTextExtractor::cacheable() const
+{
+    return true;
+}
+
+/**
+ * @brief VNoteVoiceTextExtractor::name
+ * @return 提取器名称
+ */
+QString VNoteVoiceTextExtractor::name() const
+{
+    return "voice";
+}
+
+/**
+ * @brief VNoteVoiceTextExtractor::canExtract
+ * @param item 附件
+ * @return true 可以提取
+ */
+bool VNoteVoiceTextExtractor::canExtract(const VNoteExtractItem &item) const
+{
+    return VNoteExtractItem::Voice == item.type;
+}
+
+/**
+ * @brief VNoteVoiceTextExtractor::extract
+ * 转写结果已保存在语音数据中，无需再次识别
+ * @param item 附件
+ * @return 转写文本
+ */
+QString VNoteVoiceTextExtractor::extract(const VNoteExtractItem &item)
+{
+    return item.hint.simplified();
+}
+
+/**
+ * @brief VNoteVoiceTextExtractor::cacheable
+ * 转写文本随笔记内容保存，不需要写入缓存
+ * @return false
+ */
+bool VNoteVoiceTextExtractor::cacheable() const
+{
+    return false;
+}
+
+/**
+ * @brief VNoteOcrTextExtractor::VNoteOcrTextExtractor
+ * @param program ocr程序名称
+ */
+VNoteOcrTextExtractor::VNoteOcrTextExtractor(const QString &program)
+    : m_programPath(QStandardPaths::findExecutable(program))
+{
+}
+
+/**
+ * @brief VNoteOcrTextExtractor::name
+ * @return 提取器名称
+ */
+QString VNoteOcrTextExtractor::name() const
+{
+    return "ocr";
+}
+
+/**
+ * @brief VNoteOcrTextExtractor::isAvailable
+ * @return true ocr程序存在
+ */
+bool VNoteOcrTextExtractor::isAvailable() const
+{
+    return !m_programPath.isEmpty();
+}
+
+/**
+ * @brief VNoteOcrTextExtractor::canExtract
+ * @param item 附件
+ * @return true 可以提取
+ */
+bool VNoteOcrTextExtractor::canExtract(const VNoteExtractItem &item) const
+{
+    return isAvailable() && VNoteExtractItem::Image == item.type;
+}
+
+/**
+ * @brief VNoteOcrTextExtractor::extract
+ * 调用ocr进程识别图片文字，识别失败返回空字符串
+ * @param item 附件
+ * @return 识别文本
+ */
+QString VNoteOcrTextExtractor::extract(const VNoteExtractItem &item)
+{
+    if (!QFileInfo(item.path).isFile()) {
+        return "";
+    }
+
+    QProcess process;
+    //结果输出到标准输出
+    process.start(m_programPath, QStringList() << item.path << "stdout");
+    if (!process.waitForFinished(m_timeout)) {
+        process.kill();
+        process.waitForFinished();
+        qWarning() << "ocr timeout:" << item.path;
+        return "";
+    }
+
+    if (QProcess::NormalExit != process.exitStatus() || 0 != process.exitCode()) {
+        qWarning() << "ocr failed:" << item.path << process.readAllStandardError();
+        return "";
+    }
+
+    return QString::fromUtf8(process.readAllStandardOutput()).simplified();
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTETEXTEXTRACTOR_H
+#define VNOTETEXTEXTRACTOR_H
+
+#include <QString>
+
+/**
+ * @brief The VNoteExtractItem struct
+ * 待提取文本的附件（语音、图片）
+ */
+struct VNoteExtractItem {
+    enum Type {
+        Voice = 0,
+        Image,
+    };
+
+    //附件类型
+    qint32 type {Voice};
+    //附件完整路径
+    QString path {""};
+    //附件已有的文本，语音为转写结果
+    QString hint {""};
+};
+
+/**
+ * @brief The VNoteTextExtractor class
+ * 附件文本提取器基类，新增提取方式时继承此类并注册到VNoteSearchIndex
+ */
+class VNoteTextExtractor
+{
+public:
+    virtual ~VNoteTextExtractor();
+    //提取器名称
+    virtual QString name() const = 0;
+    //是否支持该附件
+    virtual bool canExtract(const VNoteExtractItem &item) const = 0;
+    //提取文本，在工作线程中调用
+    virtual QString extract(const VNoteExtractItem &item) = 0;
+    //结果是否可以缓存到磁盘
+    virtual bool cacheable() const;
+};
+
+/**
+ * @brief The VNoteVoiceTextExtractor class
+ * 语音转写结果提取器，直接使用语音块中保存的转写文本
+ */
+class VNoteVoiceTextExtractor : public VNoteTextExtractor
+{
+public:
+    QString name() const override;
+    bool canExtract(const VNoteExtractItem &item) const override;
+    QString extract(const VNoteExtractItem &item) override;
+    bool cacheable() const override;
+};
+
+/**
+ * @brief The VNoteOcrTextExtractor class
+ * 图片文字识别提取器，调用本地ocr进程（tesseract）识别图片文字
+ */
+class VNoteOcrTextExtractor : public VNoteTextExtractor
+{
+public:
+    explicit VNoteOcrTextExtractor(const QString &program = "tesseract");
+    QString name() const override;
+    bool canExtract(const VNoteExtractItem &item) const override;
+    QString extract(const VNoteExtractItem &item) override;
+    //本地ocr进程是否可用
+    bool isAvailable() const;
+
+private:
+    QString m_programPath {""}; //ocr程序完整路径
+    int m_timeout {30000}; //单张图片识别超时时间，单位毫秒
+};
+
+#endif // VNOTETEXTEXTRACTOR_H
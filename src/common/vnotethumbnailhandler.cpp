@@ -0,0 +1,115 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnotethumbnailhandler.h"
+#include "task/thumbnailworker.h"
+
+#include <QBuffer>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QUrlQuery>
+#include <QDebug>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+#include <QWebEngineUrlScheme>
+#endif
+
+const QByteArray VNoteThumbnailHandler::scheme = "vnthumb";
+
+/**
+ * @brief VNoteThumbnailHandler::VNoteThumbnailHandler
+ * @param parent
+ */
+VNoteThumbnailHandler::VNoteThumbnailHandler(QObject *parent)
+    : QWebEngineUrlSchemeHandler(parent)
+    , m_imageDir(QDir::cleanPath(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/images"))
+{
+    //解码占用内存较多，限制并发数
+    m_pool.setMaxThreadCount(2);
+}
+
+VNoteThumbnailHandler::~VNoteThumbnailHandler()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+/**
+ * @brief VNoteThumbnailHandler::registerScheme
+ */
+void VNoteThumbnailHandler::registerScheme()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+    QWebEngineUrlScheme thumbScheme(scheme);
+    thumbScheme.setSyntax(QWebEngineUrlScheme::Syntax::Path);
+    //本地页面可以加载该协议的图片
+    thumbScheme.setFlags(QWebEngineUrlScheme::LocalScheme | QWebEngineUrlScheme::LocalAccessAllowed);
+    QWebEngineUrlScheme::registerScheme(thumbScheme);
+#endif
+}
+
+/**
+ * @brief VNoteThumbnailHandler::isAllowedPath
+ * @param path 图片路径
+ * @return 在笔记图片目录下返回true
+ */
+bool VNoteThumbnailHandler::isAllowedPath(const QString &path) const
+{
+    QString cleanPath = QDir::cleanPath(path);
+    return cleanPath.startsWith(m_imageDir + "/") && QFileInfo(cleanPath).isFile();
+}
+
+/**
+ * @brief VNoteThumbnailHandler::requestStarted
+ * @param job 请求
+ */
+void VNoteThumbnailHandler::requestStarted(QWebEngineUrlRequestJob *job)
+{
+    QUrl url = job->requestUrl();
+    QString path = url.path(QUrl::FullyDecoded);
+    if (!isAllowedPath(path)) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    int width = QUrlQuery(url).queryItemValue("w").toInt();
+    width = qBound(static_cast<int>(MinWidth), width, static_cast<int>(MaxWidth));
+
+    quint64 requestId = ++m_nextRequestId;
+    m_jobs.insert(requestId, QPointer<QWebEngineUrlRequestJob>(job));
+
+    ThumbnailWorker *worker = new ThumbnailWorker(requestId, path, width);
+    worker->setAutoDelete(true);
+    worker->setObjectName("ThumbnailWorker");
+    connect(worker, &ThumbnailWorker::thumbnailReady, this, &VNoteThumbnailHandler::onThumbnailReady, Qt::QueuedConnection);
+    m_pool.start(worker);
+}
+
+/**
+ * @brief VNoteThumbnailHandler::onThumbnailReady
+ * @param requestId 请求id
+ * @param data 图片数据
+ * @param mimeType 图片类型
+ */
+void VNoteThumbnailHandler::onThumbnailReady(quint64 requestId, const QByteArray &data, const QByteArray &mimeType)
+{
+    QPointer<QWebEngineUrlRequestJob> job = m_jobs.take(requestId);
+    //页面切换后请求已取消
+    if (job.isNull()) {
+        return;
+    }
+
+    if (data.isEmpty()) {
+        job->fail(QWebEngineUrlRequestJob::RequestFailed);
+        return;
+    }
+
+    //数据由请求负责释放
+    QBuffer *buffer = new QBuffer(job);
+    buffer->setData(data);
+    buffer->open(QIODevice::ReadOnly);
+    job->reply(mimeType, buffer);
+}
@@ -0,0 +1,53 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTETHUMBNAILHANDLER_H
+#define VNOTETHUMBNAILHANDLER_H
+
+#include <QWebEngineUrlSchemeHandler>
+#include <QWebEngineUrlRequestJob>
+#include <QPointer>
+#include <QHash>
+#include <QThreadPool>
+
+/**
+ * @brief The VNoteThumbnailHandler class
+ * 缩略图url协议处理，web端通过 vnthumb:<图片路径>?w=<显示宽度> 获取按显示尺寸缩小后的图片，
+ * 只允许访问笔记图片目录下的文件
+ */
+class VNoteThumbnailHandler : public QWebEngineUrlSchemeHandler
+{
+    Q_OBJECT
+public:
+    explicit VNoteThumbnailHandler(QObject *parent = nullptr);
+    ~VNoteThumbnailHandler() override;
+
+    //协议名
+    static const QByteArray scheme;
+    //缩略图宽度范围
+    enum {
+        MinWidth = 64,
+        MaxWidth = 4096,
+    };
+
+    //注册协议，需要在创建QApplication之前调用
+    static void registerScheme();
+    //处理请求
+    void requestStarted(QWebEngineUrlRequestJob *job) override;
+    //图片路径是否允许访问
+    bool isAllowedPath(const QString &path) const;
+
+private slots:
+    //缩略图生成完成，返回给web端
+    void onThumbnailReady(quint64 requestId, const QByteArray &data, const QByteArray &mimeType);
+
+private:
+    QString m_imageDir {""}; //笔记图片目录
+    quint64 m_nextRequestId {0};
+    QHash<quint64, QPointer<QWebEngineUrlRequestJob>> m_jobs; //处理中的请求，web端取消时自动置空
+    QThreadPool m_pool; //解码线程池
+};
+
+#endif // VNOTETHUMBNAILHANDLER_H
@@ -0,0 +1,155 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnotevoiceactivity.h"
+#include "globaldef.h"
+#include "setting.h"
+
+#include <QtMath>
+
+static const qint64 nsPerMs = 1000 * 1000;
+static const float floorRiseDb = 0.01f; //噪声基底每个窗口的上升量，约2dB/s
+static const float minFloorDb = -90.0f;
+
+/**
+ * @brief VNoteVoiceActivity::modeFromSettings
+ * 只能在主线程调用
+ * @return 静音处理方式
+ */
+VNoteVoiceActivity::SilenceMode VNoteVoiceActivity::modeFromSettings()
+{
+    int mode = setting::instance()->getOption(VNOTE_RECORD_SILENCE).toInt();
+    if (mode < KeepSilence || mode > RemoveSilence) {
+        return KeepSilence;
+    }
+    return static_cast<SilenceMode>(mode);
+}
+
+/**
+ * @brief VNoteVoiceActivity::skipSilence
+ * 只跳过语音段之间和开头的静音，间隔过短时不跳转
+ * @param segments 语音段
+ * @param position 播放位置
+ * @return 跳转位置
+ */
+qint64 VNoteVoiceActivity::skipSilence(const VNOTE_SPEECH_SEGMENTS &segments, qint64 position)
+{
+    for (const QPair<qint64, qint64> &segment : segments) {
+        if (position < segment.first) {
+            qint64 target = segment.first - SkipLeadMs;
+            return target - position > MergeGapMs ? target : -1;
+        }
+        if (position <= segment.second) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief VNoteVoiceActivity::reset
+ * @param mode 静音处理方式
+ */
+void VNoteVoiceActivity::reset(SilenceMode mode)
+{
+    m_mode = mode;
+    m_noiseFloor = -60.0f;
+    m_inputTime = 0;
+    m_removed = 0;
+    m_lastSpeech = -1;
+    m_segments.clear();
+}
+
+/**
+ * @brief VNoteVoiceActivity::process
+ * 开头和语音之后的静音保留MaxSilenceMs，超出部分去除
+ * @param levels 窗口电平
+ * @param frames 帧数
+ * @param sampleRate 采样率
+ * @return 写入录音返回true
+ */
+bool VNoteVoiceActivity::process(const VNoteAudioLevels &levels, int frames, int sampleRate)
+{
+    if (frames <= 0 || sampleRate <= 0) {
+        return true;
+    }
+
+    qint64 duration = static_cast<qint64>(frames) * 1000 * nsPerMs / sampleRate;
+    qint64 start = m_inputTime;
+    m_inputTime += duration;
+
+    bool speech = false;
+    for (int i = 0; i < levels.count; i++) {
+        //所有窗口都参与噪声基底统计
+        speech = isSpeech(levels.rms[i]) || speech;
+    }
+    if (speech) {
+        m_lastSpeech = m_inputTime;
+    }
+
+    //还未检测到语音时从录音开头计算静音时长
+    bool active = m_lastSpeech >= 0 && start < m_lastSpeech + HangoverMs * nsPerMs;
+    bool keep = start < qMax(m_lastSpeech, Q_INT64_C(0)) + MaxSilenceMs * nsPerMs;
+    if (!keep && RemoveSilence == m_mode) {
+        m_removed += duration;
+        return false;
+    }
+
+    if (active) {
+        //语音段使用去除静音后的录音文件时间
+        qint64 outStart = (start - m_removed) / nsPerMs;
+        qint64 outEnd = (m_inputTime - m_removed) / nsPerMs;
+        if (!m_segments.isEmpty() && outStart - m_segments.last().second <= MergeGapMs) {
+            m_segments.last().second = outEnd;
+        } else {
+            m_segments.append(qMakePair(outStart, outEnd));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief VNoteVoiceActivity::removedDuration
+ * @return 已去除的静音时长
+ */
+qint64 VNoteVoiceActivity::removedDuration() const
+{
+    return m_removed;
+}
+
+/**
+ * @brief VNoteVoiceActivity::speechSegments
+ * @return 语音段
+ */
+VNOTE_SPEECH_SEGMENTS VNoteVoiceActivity::speechSegments() const
+{
+    return m_segments;
+}
+
+/**
+ * @brief VNoteVoiceActivity::lastSpeechEnd
+ * @return 最后一个语音段的结束时间
+ */
+qint64 VNoteVoiceActivity::lastSpeechEnd() const
+{
+    return m_segments.isEmpty() ? -1 : m_segments.last().second;
+}
+
+/**
+ * @brief VNoteVoiceActivity::isSpeech
+ * 噪声基底遇到更低电平时立即下降，否则缓慢上升，适应环境噪声的变化
+ * @param rms 窗口均方根
+ * @return 语音返回true
+ */
+bool VNoteVoiceActivity::isSpeech(float rms)
+{
+    float db = rms > 0.0f ? 20.0f * std::log10(rms) : minFloorDb;
+    if (db < m_noiseFloor) {
+        m_noiseFloor = qMax(db, minFloorDb);
+    } else {
+        m_noiseFloor += floorRiseDb;
+    }
+    return db > qMax(m_noiseFloor + SpeechMarginDb, static_cast<float>(MinSpeechDb));
+}
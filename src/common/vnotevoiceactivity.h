@@ -0,0 +1,64 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEVOICEACTIVITY_H
+#define VNOTEVOICEACTIVITY_H
+
+#include "vnoteaudiolevel.h"
+#include "datatypedef.h"
+
+/**
+ * @brief The VNoteVoiceActivity class
+ * 录音语音检测，根据窗口均方根与自适应噪声基底判断语音，
+ * 统计录音文件中的语音段，并可在录音时去除过长的静音，只保留一段停顿
+ */
+class VNoteVoiceActivity
+{
+public:
+    enum {
+        HangoverMs = 300, //语音结束后仍视为语音的时长
+        MaxSilenceMs = 1000, //去除静音时保留的停顿时长
+        MergeGapMs = 500, //间隔不超过该值的语音段合并
+        SkipLeadMs = 200, //播放跳过静音时，在语音段前保留的时长
+        SpeechMarginDb = 15, //高于噪声基底多少dB视为语音
+        MinSpeechDb = -55, //低于该电平不视为语音
+    };
+
+    //静音处理方式，与设置项的选项顺序一致
+    enum SilenceMode {
+        KeepSilence = 0, //只检测语音段
+        SkipSilence, //播放时跳过静音
+        RemoveSilence, //录音时去除静音
+    };
+
+    //从设置中读取静音处理方式
+    static SilenceMode modeFromSettings();
+    //播放时跳过静音，返回下一个语音段前的位置，不需要跳转时返回-1，单位毫秒
+    static qint64 skipSilence(const VNOTE_SPEECH_SEGMENTS &segments, qint64 position);
+
+    //开始新的录音
+    void reset(SilenceMode mode);
+    //处理一段录音的窗口电平，frames为该段帧数，返回该段是否写入录音
+    bool process(const VNoteAudioLevels &levels, int frames, int sampleRate);
+    //已去除的静音时长，单位纳秒
+    qint64 removedDuration() const;
+    //录音文件中的语音段，单位毫秒
+    VNOTE_SPEECH_SEGMENTS speechSegments() const;
+    //最后一个语音段的结束时间，单位毫秒，未检测到语音时为-1
+    qint64 lastSpeechEnd() const;
+
+private:
+    //窗口是否为语音，同时更新噪声基底
+    bool isSpeech(float rms);
+
+    SilenceMode m_mode {KeepSilence};
+    float m_noiseFloor {-60.0f}; //噪声基底，单位dB
+    qint64 m_inputTime {0}; //已处理的录音时长，单位纳秒
+    qint64 m_removed {0}; //已去除的静音时长，单位纳秒
+    qint64 m_lastSpeech {-1}; //最后一次检测到语音的录音时间，单位纳秒，-1为未检测到
+    VNOTE_SPEECH_SEGMENTS m_segments; //录音文件中的语音段
+};
+
+#endif // VNOTEVOICEACTIVITY_H
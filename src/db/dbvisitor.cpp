@@ -58,6 +58,13 @@ const QStringList DbVisitor::DBSafer::saferColumnsName = {
     "create_time",
 };
 
+const QStringList DbVisitor::DBAsrJob::asrJobColumnsName = {
+    "voice_path",
+    "note_id",
+    "duration",
+    "create_time",
+};
+
 /**
  * @brief DbVisitor::DbVisitor
  * @param db 数据库对象
@@ -720,6 +727,43 @@ UpdateNoteDbVisitor::UpdateNoteDbVisitor(QSqlDatabase &db, const void *inParam,
 {
 }
 
+/**
+ * @brief makeUpdateNoteSqls
+ * 生成更新记事项内容及所属记事本修改时间的sql语句
+ * @param note 记事项
+ * @param sqls 生成的sql语句
+ */
+static void makeUpdateNoteSqls(const VNoteItem *note, QStringList &sqls)
+{
+    static constexpr char const *MODIFY_NOTETEXT_FMT = "UPDATE %s SET %s='%s', %s='%s' WHERE %s=%lld AND %s=%d;";
+    static constexpr char const *UPDATE_FOLDER_TIME = "UPDATE %s SET %s='%s' WHERE %s=%s;";
+
+    QString metaDataStr = note->metaDataConstRef().toString();
+    //同checkSqlStr，转义单引号
+    metaDataStr.replace("'", "''");
+
+    QString modifyNoteTextSql;
+    modifyNoteTextSql.sprintf(MODIFY_NOTETEXT_FMT,
+                              VNoteDbManager::NOTES_TABLE_NAME,
+                              DbVisitor::DBNote::noteColumnsName[DbVisitor::DBNote::meta_data].toUtf8().data(),
+                              //如果笔记是加密的，则更新也需要加密数据
+                              note->encryption ? metaDataStr.toLocal8Bit().toBase64().data() : metaDataStr.toUtf8().data(),
+                              DbVisitor::DBNote::noteColumnsName[DbVisitor::DBNote::modify_time].toUtf8().data(),
+                              note->modifyTime.toString(VNOTE_TIME_FMT).toUtf8().data(),
+                              DbVisitor::DBNote::noteColumnsName[DbVisitor::DBNote::folder_id].toUtf8().data(),
+                              note->folderId,
+                              DbVisitor::DBNote::noteColumnsName[DbVisitor::DBNote::note_id].toUtf8().data(),
+                              note->noteId);
+
+    QString updateSql;
+    QDateTime modifyTime = QDateTime::currentDateTime();
+
+    updateSql.sprintf(UPDATE_FOLDER_TIME, VNoteDbManager::FOLDER_TABLE_NAME, DbVisitor::DBFolder::folderColumnsName[DbVisitor::DBFolder::modify_time].toUtf8().data(), modifyTime.toString(VNOTE_TIME_FMT).toUtf8().data(), DbVisitor::DBFolder::folderColumnsName[DbVisitor::DBFolder::folder_id].toUtf8().data(), QString("%1").arg(note->folderId).toUtf8().data());
+
+    sqls.append(modifyNoteTextSql);
+    sqls.append(updateSql);
+}
+
 /**
  * @brief UpdateNoteDbVisitor::prepareSqls
  * @return true 成功
@@ -730,37 +774,43 @@ bool UpdateNoteDbVisitor::prepareSqls()
     const VNoteItem *note = param.newNote;
 
     if (nullptr != note) {
-        static constexpr char const *MODIFY_NOTETEXT_FMT = "UPDATE %s SET %s='%s', %s='%s' WHERE %s=%lld AND %s=%d;";
-        static constexpr char const *UPDATE_FOLDER_TIME = "UPDATE %s SET %s='%s' WHERE %s=%s;";
-
-        QString metaDataStr = note->metaDataConstRef().toString();
-        checkSqlStr(metaDataStr);
+        makeUpdateNoteSqls(note, m_dbvSqls);
+    } else {
+        fPrepareOK = false;
+    }
 
-        QString modifyNoteTextSql;
-        modifyNoteTextSql.sprintf(MODIFY_NOTETEXT_FMT,
-                                  VNoteDbManager::NOTES_TABLE_NAME,
-                                  DBNote::noteColumnsName[DBNote::meta_data].toUtf8().data(),
-                                  //如果笔记是加密的，则更新也需要加密数据
-                                  note->encryption ? metaDataStr.toLocal8Bit().toBase64().data() : metaDataStr.toUtf8().data(),
-                                  DBNote::noteColumnsName[DBNote::modify_time].toUtf8().data(),
-                                  note->modifyTime.toString(VNOTE_TIME_FMT).toUtf8().data(),
-                                  DBNote::noteColumnsName[DBNote::folder_id].toUtf8().data(),
-                                  note->folderId,
-                                  DBNote::noteColumnsName[DBNote::note_id].toUtf8().data(),
-                                  note->noteId);
+    return fPrepareOK;
+}
 
-        QString updateSql;
-        QDateTime modifyTime = QDateTime::currentDateTime();
+/**
+ * @brief UpdateNotesDbVisitor::UpdateNotesDbVisitor
+ * @param db
+ * @param inParam 记事项列表
+ * @param result
+ */
+UpdateNotesDbVisitor::UpdateNotesDbVisitor(QSqlDatabase &db, const void *inParam, void *result)
+    : DbVisitor(db, inParam, result)
+{
+}
 
-        updateSql.sprintf(UPDATE_FOLDER_TIME, VNoteDbManager::FOLDER_TABLE_NAME, DBFolder::folderColumnsName[DBFolder::modify_time].toUtf8().data(), modifyTime.toString(VNOTE_TIME_FMT).toUtf8().data(), DBFolder::folderColumnsName[DBFolder::folder_id].toUtf8().data(), QString("%1").arg(note->folderId).toUtf8().data());
+/**
+ * @brief UpdateNotesDbVisitor::prepareSqls
+ * @return true 成功
+ */
+bool UpdateNotesDbVisitor::prepareSqls()
+{
+    const QList<VNoteItem *> *notes = static_cast<const QList<VNoteItem *> *>(param.ptr);
+    if (nullptr == notes || notes->isEmpty()) {
+        return false;
+    }
 
-        m_dbvSqls.append(modifyNoteTextSql);
-        m_dbvSqls.append(updateSql);
-    } else {
-        fPrepareOK = false;
+    for (const VNoteItem *note : *notes) {
+        if (nullptr != note) {
+            makeUpdateNoteSqls(note, m_dbvSqls);
+        }
     }
 
-    return fPrepareOK;
+    return true;
 }
 
 /**
@@ -872,3 +922,133 @@ bool DelNoteDbVisitor::prepareSqls()
 
     return fPrepareOK;
 }
+
+/**
+ * @brief AsrJobQryDbVisitor::AsrJobQryDbVisitor
+ * @param db
+ * @param inParam
+ * @param result 任务列表
+ */
+AsrJobQryDbVisitor::AsrJobQryDbVisitor(QSqlDatabase &db, const void *inParam, void *result)
+    : DbVisitor(db, inParam, result)
+{
+}
+
+/**
+ * @brief AsrJobQryDbVisitor::visitorData
+ * @return true 成功
+ */
+bool AsrJobQryDbVisitor::visitorData()
+{
+    if (nullptr == results.asrJobs) {
+        return false;
+    }
+
+    while (m_sqlQuery->next()) {
+        VNoteAsrJob job;
+        job.voicePath = m_sqlQuery->value(DBAsrJob::voice_path).toString();
+        job.noteId = m_sqlQuery->value(DBAsrJob::note_id).toInt();
+        job.duration = m_sqlQuery->value(DBAsrJob::duration).toLongLong();
+        results.asrJobs->append(job);
+    }
+
+    return true;
+}
+
+/**
+ * @brief AsrJobQryDbVisitor::prepareSqls
+ * @return true 成功
+ */
+bool AsrJobQryDbVisitor::prepareSqls()
+{
+    static constexpr char const *QUERY_ASR_JOBS_FMT = "SELECT * FROM %s ORDER BY rowid;";
+
+    QString querySql;
+    querySql.sprintf(QUERY_ASR_JOBS_FMT, VNoteDbManager::ASR_JOB_TABLE_NAME);
+
+    m_dbvSqls.append(querySql);
+
+    return true;
+}
+
+/**
+ * @brief AddAsrJobsDbVisitor::AddAsrJobsDbVisitor
+ * @param db
+ * @param inParam 任务列表
+ * @param result
+ */
+AddAsrJobsDbVisitor::AddAsrJobsDbVisitor(QSqlDatabase &db, const void *inParam, void *result)
+    : DbVisitor(db, inParam, result)
+{
+}
+
+/**
+ * @brief AddAsrJobsDbVisitor::prepareSqls
+ * @return true 成功
+ */
+bool AddAsrJobsDbVisitor::prepareSqls()
+{
+    const VNoteAsrJobs *jobs = param.asrJobs;
+    if (nullptr == jobs || jobs->isEmpty()) {
+        return false;
+    }
+
+    static constexpr char const *INSERT_ASR_JOB_FMT = "INSERT OR IGNORE INTO %s (%s, %s, %s) VALUES ('%s', %d, %lld);";
+
+    for (const VNoteAsrJob &job : *jobs) {
+        QString voicePath = job.voicePath;
+        checkSqlStr(voicePath);
+
+        QString sql;
+        sql.sprintf(INSERT_ASR_JOB_FMT,
+                    VNoteDbManager::ASR_JOB_TABLE_NAME,
+                    DBAsrJob::asrJobColumnsName[DBAsrJob::voice_path].toUtf8().data(),
+                    DBAsrJob::asrJobColumnsName[DBAsrJob::note_id].toUtf8().data(),
+                    DBAsrJob::asrJobColumnsName[DBAsrJob::duration].toUtf8().data(),
+                    voicePath.toUtf8().data(),
+                    job.noteId,
+                    job.duration);
+        m_dbvSqls.append(sql);
+    }
+
+    return true;
+}
+
+/**
+ * @brief DelAsrJobsDbVisitor::DelAsrJobsDbVisitor
+ * @param db
+ * @param inParam 任务列表
+ * @param result
+ */
+DelAsrJobsDbVisitor::DelAsrJobsDbVisitor(QSqlDatabase &db, const void *inParam, void *result)
+    : DbVisitor(db, inParam, result)
+{
+}
+
+/**
+ * @brief DelAsrJobsDbVisitor::prepareSqls
+ * @return true 成功
+ */
+bool DelAsrJobsDbVisitor::prepareSqls()
+{
+    const VNoteAsrJobs *jobs = param.asrJobs;
+    if (nullptr == jobs || jobs->isEmpty()) {
+        return false;
+    }
+
+    static constexpr char const *DEL_ASR_JOB_FMT = "DELETE FROM %s WHERE %s='%s';";
+
+    for (const VNoteAsrJob &job : *jobs) {
+        QString voicePath = job.voicePath;
+        checkSqlStr(voicePath);
+
+        QString sql;
+        sql.sprintf(DEL_ASR_JOB_FMT,
+                    VNoteDbManager::ASR_JOB_TABLE_NAME,
+                    DBAsrJob::asrJobColumnsName[DBAsrJob::voice_path].toUtf8().data(),
+                    voicePath.toUtf8().data());
+        m_dbvSqls.append(sql);
+    }
+
+    return true;
+}
@@ -86,6 +86,17 @@ public:
 
         static const QStringList saferColumnsName;
     };
+    //语音转文字任务表字段
+    struct DBAsrJob {
+        enum {
+            voice_path = 0,
+            note_id,
+            duration,
+            create_time,
+        };
+
+        static const QStringList asrJobColumnsName;
+    };
 
 protected:
     //Check & replace the "'" in the string.
@@ -97,6 +108,7 @@ protected:
         VNoteFolder *newFolder;
         VNoteItem *newNote;
         SafetyDatas *safetyDatas;
+        VNoteAsrJobs *asrJobs;
         qint32 *count;
         qint64 *id;
         void *ptr;
@@ -106,6 +118,7 @@ protected:
         const VNoteFolder *newFolder;
         const VNoteItem *newNote;
         const VDataSafer *safer;
+        const VNoteAsrJobs *asrJobs;
         const qint32 *count;
         const qint64 *id;
         const void *ptr;
@@ -204,6 +217,15 @@ public:
     virtual bool prepareSqls() override;
 };
 
+//多个记事项批量更新，inParam为QList<VNoteItem *>
+class UpdateNotesDbVisitor : public DbVisitor
+{
+public:
+    explicit UpdateNotesDbVisitor(QSqlDatabase &db, const void *inParam, void *result);
+
+    virtual bool prepareSqls() override;
+};
+
 //更新记事项置顶属性
 class UpdateNoteTopDbVisitor : public DbVisitor
 {
@@ -230,4 +252,32 @@ public:
 
     virtual bool prepareSqls() override;
 };
+
+//语音转文字任务查询，按加入顺序排列
+class AsrJobQryDbVisitor : public DbVisitor
+{
+public:
+    explicit AsrJobQryDbVisitor(QSqlDatabase &db, const void *inParam, void *result);
+
+    virtual bool visitorData() override;
+    virtual bool prepareSqls() override;
+};
+
+//批量添加语音转文字任务，已存在的任务忽略
+class AddAsrJobsDbVisitor : public DbVisitor
+{
+public:
+    explicit AddAsrJobsDbVisitor(QSqlDatabase &db, const void *inParam, void *result);
+
+    virtual bool prepareSqls() override;
+};
+
+//批量删除语音转文字任务
+class DelAsrJobsDbVisitor : public DbVisitor
+{
+public:
+    explicit DelAsrJobsDbVisitor(QSqlDatabase &db, const void *inParam, void *result);
+
+    virtual bool prepareSqls() override;
+};
 #endif
@@ -0,0 +1,55 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnoteasrjoboper.h"
+#include "vnotedbmanager.h"
+#include "db/dbvisitor.h"
+
+/**
+ * @brief VNoteAsrJobOper::loadJobs
+ * @param jobs 任务列表
+ * @return true 成功
+ */
+bool VNoteAsrJobOper::loadJobs(VNoteAsrJobs &jobs)
+{
+    AsrJobQryDbVisitor jobVisitor(
+        VNoteDbManager::instance()->getVNoteDb(), nullptr, &jobs);
+
+    return VNoteDbManager::instance()->queryData(&jobVisitor);
+}
+
+/**
+ * @brief VNoteAsrJobOper::addJobs
+ * @param jobs 任务列表
+ * @return true 成功
+ */
+bool VNoteAsrJobOper::addJobs(const VNoteAsrJobs &jobs)
+{
+    if (jobs.isEmpty()) {
+        return true;
+    }
+
+    AddAsrJobsDbVisitor addVisitor(
+        VNoteDbManager::instance()->getVNoteDb(), &jobs, nullptr);
+
+    return VNoteDbManager::instance()->updateDataInTransaction(&addVisitor);
+}
+
+/**
+ * @brief VNoteAsrJobOper::removeJobs
+ * @param jobs 任务列表
+ * @return true 成功
+ */
+bool VNoteAsrJobOper::removeJobs(const VNoteAsrJobs &jobs)
+{
+    if (jobs.isEmpty()) {
+        return true;
+    }
+
+    DelAsrJobsDbVisitor delVisitor(
+        VNoteDbManager::instance()->getVNoteDb(), &jobs, nullptr);
+
+    return VNoteDbManager::instance()->updateDataInTransaction(&delVisitor);
+}
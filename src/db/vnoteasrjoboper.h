@@ -0,0 +1,23 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNOTEASRJOBOPER_H
+#define VNOTEASRJOBOPER_H
+
+#include "common/datatypedef.h"
+
+//语音转文字任务表操作
+class VNoteAsrJobOper
+{
+public:
+    //获取所有未完成的任务
+    static bool loadJobs(VNoteAsrJobs &jobs);
+    //在一个事务中批量添加任务
+    static bool addJobs(const VNoteAsrJobs &jobs);
+    //在一个事务中批量删除任务
+    static bool removeJobs(const VNoteAsrJobs &jobs);
+};
+
+#endif // VNOTEASRJOBOPER_H
@@ -158,6 +158,55 @@ bool VNoteDbManager::updateData(DbVisitor *visitor /*in/out*/)
     return updateOK;
 }
 
+/**
+ * @brief VNoteDbManager::updateDataInTransaction
+ * 多条更新语句合并为一次提交，减少磁盘写入次数
+ * @param visitor
+ * @return true 成功
+ */
+bool VNoteDbManager::updateDataInTransaction(DbVisitor *visitor /*in/out*/)
+{
+    CHECK_DB_INIT();
+
+    bool updateOK = true;
+
+    if (nullptr == visitor) {
+        qCritical() << "updateData invalid parameter: visitor is null";
+        return false;
+    }
+
+    if (Q_UNLIKELY(!visitor->prepareSqls())) {
+        qCritical() << "prepare sqls failed!";
+        return false;
+    }
+
+    CRITICAL_SECTION_BEGIN();
+
+    bool inTransaction = m_vnoteDB.transaction();
+    for (auto it : visitor->dbvSqls()) {
+        if (!it.trimmed().isEmpty()) {
+            if (!visitor->sqlQuery()->exec(it)) {
+                qCritical() << "Update data failed:" << it
+                            << " reason:" << visitor->sqlQuery()->lastError().text();
+                updateOK = false;
+                break;
+            }
+        }
+    }
+
+    if (inTransaction) {
+        if (updateOK) {
+            updateOK = m_vnoteDB.commit();
+        } else {
+            m_vnoteDB.rollback();
+        }
+    }
+
+    CRITICAL_SECTION_END();
+
+    return updateOK;
+}
+
 /**
  * @brief VNoteDbManager::queryData
  * @param visitor
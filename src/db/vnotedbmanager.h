@@ -29,6 +29,7 @@ public:
     static constexpr char const *NOTES_TABLE_NAME = "vnote_items_tbl";
     static constexpr char const *NOTES_KEY = "note_id";
     static constexpr char const *CATEGORY_TABLE_NAME = "vnote_category_tbl";
+    static constexpr char const *ASR_JOB_TABLE_NAME = "vnote_asr_job_tbl";
 
     //icon_path: Not used, maybe used in future
     //expand_fields are place holder, will be used in future
@@ -84,6 +85,12 @@ public:
             expand_filed4 TEXT, \
             expand_filed5 TEXT, \
             expand_filed6 TEXT \
+         ); \
+         CREATE TABLE IF NOT EXISTS vnote_asr_job_tbl(\
+            voice_path TEXT PRIMARY KEY, \
+            note_id    INT NOT NULL, \
+            duration   INT DEFAULT 0, \
+            create_time DATETIME NOT NULL DEFAULT (STRFTIME ('%Y-%m-%d %H:%M:%f','now','localtime')) \
          );";
 
     enum DB_TABLE {
@@ -97,6 +104,8 @@ public:
     bool insertData(DbVisitor *visitor /*in/out*/);
     //执行更新操作
     bool updateData(DbVisitor *visitor /*in/out*/);
+    //在一个事务中执行更新操作，任一语句失败时全部回滚
+    bool updateDataInTransaction(DbVisitor *visitor /*in/out*/);
     //执行查询操作
     bool queryData(DbVisitor *visitor /*in/out*/);
     //执行删除操作
@@ -77,6 +77,8 @@ bool VNoteItemOper::modifyNoteTitle(const QString &title)
             m_note->modifyTime = oldModifyTime;
 
             isUpdateOK = false;
+        } else {
+            VNoteDataManager::instance()->increaseDataVersion();
         }
     }
 
@@ -116,12 +118,59 @@ bool VNoteItemOper::updateNote()
             m_note->modifyTime = oldModifyTime;
 
             isUpdateOK = false;
+        } else {
+            VNoteDataManager::instance()->increaseDataVersion();
         }
     }
 
     return isUpdateOK;
 }
 
+/**
+ * @brief VNoteItemOper::updateNotes
+ * 多个记事项的内容合并为一次数据库提交，失败时恢复所有记事项的数据
+ * @param notes 记事项列表
+ * @return true 成功
+ */
+bool VNoteItemOper::updateNotes(const QList<VNoteItem *> &notes)
+{
+    if (notes.isEmpty()) {
+        return true;
+    }
+
+    QList<QVariant> oldMetaDatas;
+    QList<QDateTime> oldModifyTimes;
+    MetaDataParser metaParser;
+    QDateTime modifyTime = QDateTime::currentDateTime();
+
+    for (VNoteItem *note : notes) {
+        //backup
+        oldMetaDatas.append(note->metaDataConstRef());
+        oldModifyTimes.append(note->modifyTime);
+
+        metaParser.makeMetaData(note, note->metaDataRef());
+        note->modifyTime = modifyTime;
+
+        if (!note->haveVoice()) {
+            note->maxVoiceIdRef() = 0;
+        }
+    }
+
+    UpdateNotesDbVisitor updateNotesVisitor(
+        VNoteDbManager::instance()->getVNoteDb(), &notes, nullptr);
+
+    if (Q_UNLIKELY(!VNoteDbManager::instance()->updateDataInTransaction(&updateNotesVisitor))) {
+        for (int i = 0; i < notes.size(); i++) {
+            notes[i]->setMetadata(oldMetaDatas[i]);
+            notes[i]->modifyTime = oldModifyTimes[i];
+        }
+        return false;
+    }
+
+    VNoteDataManager::instance()->increaseDataVersion();
+    return true;
+}
+
 /**
  * @brief VNoteItemOper::addNote
  * @param note
@@ -293,6 +342,7 @@ bool VNoteItemOper::updateTop(int value)
         UpdateNoteTopDbVisitor updateNoteVisitor(VNoteDbManager::instance()->getVNoteDb(), m_note, nullptr);
         if (!Q_UNLIKELY(!VNoteDbManager::instance()->updateData(&updateNoteVisitor))) {
             updateOK = true;
+            VNoteDataManager::instance()->increaseDataVersion();
         } else {
             m_note->isTop = !value;
         }
@@ -312,6 +362,7 @@ bool VNoteItemOper::updateFolderId(VNoteItem *data)
         UpdateNoteFolderIdDbVisitor updateNoteVisitor(VNoteDbManager::instance()->getVNoteDb(), data, nullptr);
         if (!Q_UNLIKELY(!VNoteDbManager::instance()->updateData(&updateNoteVisitor))) {
             updateOK = true;
+            VNoteDataManager::instance()->increaseDataVersion();
         }
     }
     return updateOK;
@@ -19,6 +19,8 @@ public:
     bool modifyNoteTitle(const QString &title);
     //更新数据
     bool updateNote();
+    //在一个事务中批量更新多个记事项
+    static bool updateNotes(const QList<VNoteItem *> &notes);
     //添加记事项
     VNoteItem *addNote(VNoteItem &note);
     //获取记事项
@@ -4,13 +4,13 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dialog/imageviewerdialog.h"
+#include "common/vnoteimagecache.h"
 
 #include <DLog>
 #include <DGuiApplicationHelper>
 #include <QApplication>
 #include <QDesktopWidget>
 #include <QShortcut>
-#include <QImageReader>
 #include <QPainterPath>
 
 static const int kBorderSize = 12;
@@ -26,6 +26,7 @@ ImageViewerDialog::ImageViewerDialog(QWidget *parent)
     this->initUI();
 
     connect(m_closeButton, &Dtk::Widget::DIconButton::clicked, this, &ImageViewerDialog::close);
+    connect(VNoteImageCache::instance(), &VNoteImageCache::imageReady, this, &ImageViewerDialog::onImageReady);
 }
 
 ImageViewerDialog::~ImageViewerDialog()
@@ -35,40 +36,62 @@ ImageViewerDialog::~ImageViewerDialog()
 /**
  * @brief ImageViewer::open
  * @param filepath
- * @note 根据给定的图片文件路径，打开图片并全屏显示
+ * @note 根据给定的图片文件路径，后台按屏幕大小解码图片，完成后全屏显示
  */
 void ImageViewerDialog::open(const QString &filepath)
 {
-    QImage image;
-    QImageReader reader(filepath);
-    reader.setDecideFormatFromContent(true);
-    if (!reader.canRead() || !reader.read(&image)) {
+    //获取图片显示的最大大小（显示屏大小的80%）
+    const QRect screenRect = qApp->desktop()->screenGeometry(QCursor::pos());
+    m_imgPath = filepath;
+    m_maxSize = QSize(int(screenRect.width() * 0.8), int(screenRect.height() * 0.8));
+
+    //内存缓存命中时直接显示，否则等待后台解码完成
+    QPixmap pixmap;
+    if (VNoteImageCache::instance()->find(m_imgPath, m_maxSize, &pixmap)) {
+        showImage(pixmap);
         return;
     }
+    VNoteImageCache::instance()->request(m_imgPath, m_maxSize);
+}
 
-    //获取图片显示的最大大小（显示屏大小的80%）
-    const QRect screenRect = qApp->desktop()->screenGeometry(QCursor::pos());
-    int maxWidth = int(screenRect.width() * 0.8);
-    int maxHeight = int(screenRect.height() * 0.8);
-
-    //当图片过大时缩放图片
-    if (image.width() > maxWidth || image.height() > maxHeight) {
-        //设置图片保存纵横比平滑模式自适应控件大小
-        image = image.scaled(maxWidth, maxHeight, Qt::KeepAspectRatio,
-                             Qt::SmoothTransformation);
+/**
+ * @brief ImageViewerDialog::onImageReady
+ * @param path 图片路径
+ * @param maxSize 最大显示尺寸
+ * @param pixmap 图片
+ */
+void ImageViewerDialog::onImageReady(const QString &path, const QSize &maxSize, const QPixmap &pixmap)
+{
+    //解码期间打开了其他图片
+    if (path != m_imgPath || maxSize != m_maxSize) {
+        return;
+    }
+    showImage(pixmap);
+}
+
+/**
+ * @brief ImageViewerDialog::showImage
+ * @param pixmap 按屏幕大小缩放后的图片
+ */
+void ImageViewerDialog::showImage(const QPixmap &pixmap)
+{
+    m_imgPath.clear();
+    if (pixmap.isNull()) {
+        return;
     }
 
     //设置控件占据整个屏幕大小
+    const QRect screenRect = qApp->desktop()->screenGeometry(QCursor::pos());
     this->move(screenRect.topLeft());
     this->resize(screenRect.size());
     this->showFullScreen();
 
-    m_imgWidth = image.width();
-    m_imgHeight = image.height();
+    m_imgWidth = pixmap.width();
+    m_imgHeight = pixmap.height();
     //加载图片，图片居中显示
-    m_imgLabel->setPixmap(QPixmap::fromImage(image));
+    m_imgLabel->setPixmap(pixmap);
     m_imgLabel->setAlignment(Qt::AlignCenter);
-    m_imgLabel->resize(image.width(), image.height());
+    m_imgLabel->resize(pixmap.width(), pixmap.height());
     //将图片控件移至居中位置
     m_imgLabel->move(int((screenRect.width() - m_imgLabel->width()) / 2.0), int((screenRect.height() - m_imgLabel->height()) / 2.0));
 
@@ -10,6 +10,7 @@
 #include <DDialogCloseButton>
 
 #include <QDialog>
+#include <QPixmap>
 
 DWIDGET_USE_NAMESPACE
 
@@ -32,6 +33,15 @@ public slots:
      */
     void open(const QString &filepath);
 
+protected slots:
+    /**
+     * @brief 后台解码完成
+     * @param path 图片路径
+     * @param maxSize 最大显示尺寸
+     * @param pixmap 图片
+     */
+    void onImageReady(const QString &path, const QSize &maxSize, const QPixmap &pixmap);
+
 protected:
     void mousePressEvent(QMouseEvent *event) override;
     void paintEvent(QPaintEvent *event) override;
@@ -41,6 +51,11 @@ private:
      * @brief 初始化ui
      */
     void initUI();
+    /**
+     * @brief 全屏显示图片
+     * @param pixmap 图片
+     */
+    void showImage(const QPixmap &pixmap);
 
     using QDialog::open;
 
@@ -49,6 +64,8 @@ private:
     DDialogCloseButton *m_closeButton; //关闭按钮控件
     int m_imgWidth = 0; //图片实际宽度
     int m_imgHeight = 0; //图片实际高度
+    QString m_imgPath; //等待解码的图片路径
+    QSize m_maxSize; //图片显示的最大大小
 };
 
 #endif // DEEPIN_MANUAL_VIEW_WIDGETS_IMAGE_VIEWER_H
@@ -129,10 +129,6 @@ void VNoteMessageDialog::initMessage()
             m_pMessage->setText(DApplication::translate("VNoteMessageDialog", "Are you sure you want to delete this note?"));
         }
     } break;
-    case AsrTimeLimit: {
-        m_pMessage->setText(DApplication::translate("VNoteMessageDialog", "Cannot convert this voice note, as notes over 20 minutes are not supported at present."));
-        setSingleButton();
-    } break;
     case AborteAsr: {
         m_pMessage->setText(DApplication::translate("VNoteMessageDialog", "Converting a voice note now. Do you want to stop it?"));
     } break;
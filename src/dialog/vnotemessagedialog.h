@@ -24,7 +24,6 @@ public:
         DeleteNote,
         AbortRecord,
         DeleteFolder,
-        AsrTimeLimit,
         AborteAsr,
         VolumeTooLow,
         CutNote,
@@ -48,6 +48,13 @@
 #define VNOTE_FOLDER_SORT "base.folder_sort.folder_sort_data"
 #define VNOTE_NOTEPAD_LIST_SHOW "base.notepadlist.show"
 #define VNOTE_NOTEPAD_ENCRYPTION_KEY "base.encryption.key"
+#define VNOTE_IMAGE_MAX_SIZE "base.image.max_size"
+#define VNOTE_IMAGE_SIZE_BUDGET "base.image.size_budget"
+#define VNOTE_IMAGE_TRANSCODE "base.image.transcode"
+#define VNOTE_IMAGE_KEEP_ORIGINAL "base.image.keep_original"
+#define VNOTE_RECORD_CODEC "base.recording.codec"
+#define VNOTE_RECORD_SILENCE "base.recording.silence"
+#define VNOTE_PLAY_SPEED "base.playback.speed"
 //********************************************
 
 //Time format
@@ -65,8 +72,8 @@
 
 #define VN_JSON_METADATA_PARSER
 
-//Audio to text file lenght limit
-//20 minutes
+//Audio to text file lenght limit of one request
+//20 minutes, longer audio is split into chunks
 #define MAX_A2T_AUDIO_LEN_MS (20 * 60 * 1000)
 
 //Limit shortcut key response time
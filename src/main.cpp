@@ -9,6 +9,7 @@
 #include "globaldef.h"
 #include "common/performancemonitor.h"
 #include "common/utils.h"
+#include "common/vnotethumbnailhandler.h"
 
 #include <QDir>
 #include <QOpenGLContext>
@@ -51,6 +52,9 @@ int main(int argc, char *argv[])
         dir.removeRecursively();
     }
 
+    //web端缩略图协议需在创建应用前注册
+    VNoteThumbnailHandler::registerScheme();
+
     VNoteApplication app(argc, argv);
     if (!DPlatformWindowHandle::pluginVersion().isEmpty()) {
         app.setAttribute(Qt::AA_DontCreateNativeWidgetSiblings, true);
@@ -0,0 +1,219 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "asrchunkworker.h"
+
+#include <QDataStream>
+#include <QDebug>
+
+//解码后统一转为转写服务支持的16kHz单声道S16
+static const char *decodePipeline =
+    "filesrc name=src ! decodebin ! audioconvert ! audioresample"
+    " ! audio/x-raw,format=S16LE,layout=interleaved,rate=16000,channels=1"
+    " ! fakesink name=sink sync=false";
+static const qint64 waitIntervalMs = 100;
+
+/**
+ * @brief chunkProbe
+ * @param pad
+ * @param info
+ * @param user_data 分段线程
+ * @return 处理结果
+ */
+static GstPadProbeReturn chunkProbe(GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+    Q_UNUSED(pad);
+    GstBuffer *buffer = gst_pad_probe_info_get_buffer(info);
+    if (buffer) {
+        static_cast<AsrChunkWorker *>(user_data)->doBuffer(buffer);
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief AsrChunkWorker::AsrChunkWorker
+ * @param voicePath 录音文件
+ * @param outputDir 分段输出目录
+ * @param canceled 取消标记
+ * @param parent
+ */
+AsrChunkWorker::AsrChunkWorker(const QString &voicePath, const QSharedPointer<QTemporaryDir> &outputDir,
+                               const QSharedPointer<QAtomicInt> &canceled, QObject *parent)
+    : VNTask(parent)
+    , m_voicePath(voicePath)
+    , m_outputDir(outputDir)
+    , m_canceled(canceled)
+{
+}
+
+/**
+ * @brief AsrChunkWorker::wavHeader
+ * @param dataBytes 采样数据大小
+ * @return 44字节的wav文件头
+ */
+QByteArray AsrChunkWorker::wavHeader(qint64 dataBytes)
+{
+    const quint16 channels = 1;
+    const quint16 bitsPerSample = 16;
+    const quint32 blockAlign = channels * bitsPerSample / 8;
+
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.writeRawData("RIFF", 4);
+    stream << static_cast<quint32>(36 + dataBytes);
+    stream.writeRawData("WAVE", 4);
+    stream.writeRawData("fmt ", 4);
+    stream << static_cast<quint32>(16) << static_cast<quint16>(1) << channels
+           << static_cast<quint32>(VNoteAsrChunker::SampleRate)
+           << static_cast<quint32>(VNoteAsrChunker::SampleRate * blockAlign)
+           << static_cast<quint16>(blockAlign) << bitsPerSample;
+    stream.writeRawData("data", 4);
+    stream << static_cast<quint32>(dataBytes);
+    return header;
+}
+
+/**
+ * @brief AsrChunkWorker::run
+ */
+void AsrChunkWorker::run()
+{
+    m_chunker.reset();
+    bool success = decode();
+    //最后一个分段在录音末尾结束
+    if (success && m_file.isOpen()) {
+        success = closeChunk();
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+
+    emit decodeFinished(success && 0 == m_writeError.loadAcquire() && 0 == m_canceled->loadAcquire());
+}
+
+/**
+ * @brief AsrChunkWorker::decode
+ * @return 解码到录音末尾返回true
+ */
+bool AsrChunkWorker::decode()
+{
+    gst_init(nullptr, nullptr);
+
+    GError *error = nullptr;
+    GstElement *pipeline = gst_parse_launch(decodePipeline, &error);
+    if (nullptr == pipeline || nullptr != error) {
+        qCritical() << __FUNCTION__ << "create pipeline failed:" << (error ? error->message : "");
+        g_clear_error(&error);
+        if (pipeline) {
+            gst_object_unref(pipeline);
+        }
+        return false;
+    }
+
+    //文件路径直接设置属性，不需要在管道描述中转义
+    GstElement *src = gst_bin_get_by_name(GST_BIN(pipeline), "src");
+    g_object_set(G_OBJECT(src), "location", m_voicePath.toLocal8Bit().constData(), nullptr);
+    gst_object_unref(src);
+
+    GstElement *sink = gst_bin_get_by_name(GST_BIN(pipeline), "sink");
+    GstPad *pad = gst_element_get_static_pad(sink, "sink");
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, chunkProbe, this, nullptr);
+    gst_object_unref(pad);
+    gst_object_unref(sink);
+
+    bool success = false;
+    GstBus *bus = gst_element_get_bus(pipeline);
+    if (GST_STATE_CHANGE_FAILURE != gst_element_set_state(pipeline, GST_STATE_PLAYING)) {
+        //定时检查取消标记
+        while (0 == m_canceled->loadAcquire() && 0 == m_writeError.loadAcquire()) {
+            GstMessage *msg = gst_bus_timed_pop_filtered(
+                bus, static_cast<GstClockTime>(waitIntervalMs) * GST_MSECOND,
+                static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+            if (nullptr == msg) {
+                continue;
+            }
+            if (GST_MESSAGE_ERROR == GST_MESSAGE_TYPE(msg)) {
+                gst_message_parse_error(msg, &error, nullptr);
+                qCritical() << __FUNCTION__ << "decode failed:" << m_voicePath << (error ? error->message : "");
+                g_clear_error(&error);
+            } else {
+                success = true;
+            }
+            gst_message_unref(msg);
+            break;
+        }
+    }
+    gst_object_unref(bus);
+
+    //停止后流线程不再回调，之后可以在本线程结束分段
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    gst_object_unref(pipeline);
+    return success;
+}
+
+/**
+ * @brief AsrChunkWorker::doBuffer
+ * @param buffer 解码后的采样
+ */
+void AsrChunkWorker::doBuffer(GstBuffer *buffer)
+{
+    if (0 != m_writeError.loadAcquire() || 0 != m_canceled->loadAcquire()) {
+        return;
+    }
+
+    GstMapInfo info;
+    if (!gst_buffer_map(buffer, &info, GST_MAP_READ)) {
+        return;
+    }
+
+    int frames = static_cast<int>(info.size / sizeof(qint16));
+    if (frames > 0 && (m_file.isOpen() || openChunk())) {
+        qint64 bytes = static_cast<qint64>(frames) * static_cast<qint64>(sizeof(qint16));
+        if (m_file.write(reinterpret_cast<const char *>(info.data), bytes) != bytes) {
+            m_writeError.storeRelease(1);
+        } else if (m_chunker.process(reinterpret_cast<const qint16 *>(info.data), frames)) {
+            closeChunk();
+        }
+    }
+    gst_buffer_unmap(buffer, &info);
+}
+
+/**
+ * @brief AsrChunkWorker::openChunk
+ * 文件头先占位，结束分段时再写入数据大小
+ * @return 成功返回true
+ */
+bool AsrChunkWorker::openChunk()
+{
+    m_file.setFileName(QString("%1/chunk_%2.wav").arg(m_outputDir->path()).arg(m_index, 4, 10, QChar('0')));
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || m_file.write(wavHeader(0)) != 44) {
+        qCritical() << __FUNCTION__ << "open chunk failed:" << m_file.fileName() << m_file.errorString();
+        m_writeError.storeRelease(1);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief AsrChunkWorker::closeChunk
+ * @return 成功返回true
+ */
+bool AsrChunkWorker::closeChunk()
+{
+    qint64 dataBytes = m_file.size() - 44;
+    bool success = m_file.seek(0) && m_file.write(wavHeader(dataBytes)) == 44 && m_file.flush();
+    m_file.close();
+    if (!success) {
+        m_writeError.storeRelease(1);
+        return false;
+    }
+
+    qint64 end = m_chunker.position();
+    emit chunkReady(m_index, m_file.fileName(), m_chunkStart, end);
+    m_index++;
+    m_chunkStart = end;
+    return true;
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ASRCHUNKWORKER_H
+#define ASRCHUNKWORKER_H
+
+#include "vntask.h"
+#include "common/vnoteasrchunker.h"
+
+#include <QAtomicInt>
+#include <QFile>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+
+#include <gst/gst.h>
+
+/**
+ * @brief The AsrChunkWorker class
+ * 长录音分段线程，只解码一遍录音，转为16kHz单声道wav分段写入输出目录，
+ * 每写完一个分段立即通知，分段转写与后续分段的解码同时进行
+ */
+class AsrChunkWorker : public VNTask
+{
+    Q_OBJECT
+public:
+    AsrChunkWorker(const QString &voicePath, const QSharedPointer<QTemporaryDir> &outputDir,
+                   const QSharedPointer<QAtomicInt> &canceled, QObject *parent = nullptr);
+
+    //处理一段解码后的采样，在流线程中调用
+    void doBuffer(GstBuffer *buffer);
+    //wav文件头，dataBytes为采样数据大小
+    static QByteArray wavHeader(qint64 dataBytes);
+
+signals:
+    /**
+     * @brief 一个分段写入完成
+     * @param index 分段序号
+     * @param path 分段文件路径
+     * @param start 开始时间，单位毫秒
+     * @param end 结束时间，单位毫秒
+     */
+    void chunkReady(int index, const QString &path, qint64 start, qint64 end);
+    //解码结束，取消时也会发出
+    void decodeFinished(bool success);
+
+protected:
+    virtual void run() override;
+
+private:
+    //解码录音，到达末尾返回true
+    bool decode();
+    //开始写入新的分段
+    bool openChunk();
+    //补全文件头并结束当前分段
+    bool closeChunk();
+
+    QString m_voicePath {""}; //录音文件
+    QSharedPointer<QTemporaryDir> m_outputDir; //分段输出目录，取消后线程结束前仍可能写入，随线程释放
+    QSharedPointer<QAtomicInt> m_canceled; //非0时停止解码
+    VNoteAsrChunker m_chunker; //确定切分位置
+    QFile m_file; //当前分段文件
+    int m_index {0}; //当前分段序号
+    qint64 m_chunkStart {0}; //当前分段开始时间，单位毫秒
+    QAtomicInt m_writeError {0}; //写入分段失败，在流线程中设置，解码线程中读取
+};
+
+#endif // ASRCHUNKWORKER_H
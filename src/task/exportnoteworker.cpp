@@ -203,7 +203,8 @@ ExportNoteWorker::ExportError ExportNoteWorker::exportOneVoice(VNoteBlock *noteb
 
     if (noteblock && noteblock->blockType == VNoteBlock::Voice) {
         QString baseFileName = m_exportPath + "/" + noteblock->ptrVoice->voiceTitle;
-        QString fileSuffix = ".mp3";
+        //保持录音文件的编码格式
+        QString fileSuffix = "." + QFileInfo(noteblock->ptrVoice->voicePath).suffix();
         QString dstFileName = getExportFileName(baseFileName, fileSuffix);
         if (!QFile::copy(noteblock->ptrVoice->voicePath, dstFileName)) {
             error = Savefailed; //保存失败
@@ -5,6 +5,7 @@
 
 #include "filecleanupworker.h"
 #include "common/vnoteitem.h"
+#include "common/vnoterecordprofile.h"
 
 #include <QDir>
 #include <QStandardPaths>
@@ -13,6 +14,7 @@
 FileCleanupWorker::FileCleanupWorker(VNOTE_ALL_NOTES_MAP *qspAllNotesMap, QObject *parent)
     : VNTask(parent)
     , m_qspAllNotesMap(qspAllNotesMap)
+    , m_startTime(QDateTime::currentDateTime())
 {
 }
 void FileCleanupWorker::run()
@@ -44,6 +46,16 @@ void FileCleanupWorker::cleanVoice()
             qCritical() << "remove file " << path << " failed!";
         }
     }
+
+    //删除录音已不存在的峰值文件
+    QString dirPath = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/voicenote";
+    QDir dir(dirPath);
+    for (auto fileName : dir.entryList(QStringList("*.peaks"), QDir::Files | QDir::NoSymLinks)) {
+        QString peakPath = dirPath + "/" + fileName;
+        if (!QFile::exists(peakPath.left(peakPath.size() - QString(".peaks").size()))) {
+            QFile::remove(peakPath);
+        }
+    }
 }
 
 /**
@@ -73,8 +85,12 @@ void FileCleanupWorker::fillVoiceSet()
     }
 
     //存放文件路径
-    for (auto fileName : dir.entryList(QStringList("*.mp3"), QDir::Files | QDir::NoSymLinks)) {
-        m_voiceSet.insert(dirPath + "/" + fileName);
+    for (const QFileInfo &info : dir.entryInfoList(VNoteRecordProfile::voiceFilters(), QDir::Files | QDir::NoSymLinks)) {
+        //清理期间新录制或恢复的录音
+        if (info.lastModified() >= m_startTime) {
+            continue;
+        }
+        m_voiceSet.insert(dirPath + "/" + info.fileName());
     }
 }
 
@@ -91,7 +107,7 @@ void FileCleanupWorker::fillPictureSet()
         return;
     }
 
-    QStringList filters = {"*.png", "*.jpg", "*.bmp"};
+    QStringList filters = {"*.png", "*.jpg", "*.bmp", "*.webp"};
     for (auto fileName : dir.entryList(filters, QDir::Files | QDir::NoSymLinks)) {
         m_pictureSet.insert(dirPath + "/" + fileName);
     }
@@ -162,7 +178,7 @@ void FileCleanupWorker::scanVoiceByHtml(const QString &htmlCode)
     QRegExp rx("<div.+jsonkey.+>");
     rx.setMinimal(true); //最小匹配
     //匹配语音路径的正则表达式
-    QRegExp rxJson("(/\\S+)+/voicenote/[\\w\\-]+\\.mp3");
+    QRegExp rxJson(QString("(/\\S+)+/voicenote/[\\w\\-]+\\.(%1)").arg(VNoteRecordProfile::voiceSuffixes().join("|")));
     rxJson.setMinimal(false); //最大匹配
     QStringList list;
     int pos = 0;
@@ -192,9 +208,12 @@ void FileCleanupWorker::scanPictureByHtml(const QString &htmlCode)
     int pos = 0;
     //查找图片块
     while ((pos = rx.indexIn(htmlCode, pos)) != -1) {
-        //获取图片路径
-        if (rxPath.indexIn(rx.cap(0)) != -1) {
+        //获取图片路径，包括保存的原图路径
+        QString imgLabel = rx.cap(0);
+        int pathPos = 0;
+        while ((pathPos = rxPath.indexIn(imgLabel, pathPos)) != -1) {
             removePicturePathBySet(rxPath.cap(0));
+            pathPos += rxPath.matchedLength();
         }
         pos += rx.matchedLength();
     }
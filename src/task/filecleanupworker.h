@@ -9,6 +9,7 @@
 #include "vntask.h"
 #include "datatypedef.h"
 
+#include <QDateTime>
 #include <QSet>
 
 /**
@@ -54,6 +55,7 @@ private:
     VNOTE_ALL_NOTES_MAP *m_qspAllNotesMap {nullptr}; //所有笔记数据
     QSet<QString> m_pictureSet; //图片路径集合
     QSet<QString> m_voiceSet; //语音路径集合
+    QDateTime m_startTime; //创建任务的时间，之后生成的文件可能还未写入笔记，不清理
 };
 
 #endif // FILECLEANUPWORKER_H
@@ -0,0 +1,38 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "filesyncworker.h"
+
+#include <QFile>
+#include <QDebug>
+
+#include <unistd.h>
+
+/**
+ * @brief FileSyncWorker::FileSyncWorker
+ * @param path 文件路径
+ * @param parent
+ */
+FileSyncWorker::FileSyncWorker(const QString &path, QObject *parent)
+    : VNTask(parent)
+    , m_path(path)
+{
+}
+
+/**
+ * @brief FileSyncWorker::run
+ */
+void FileSyncWorker::run()
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << __FUNCTION__ << "open file failed:" << m_path << file.errorString();
+        return;
+    }
+    //只读打开同样可以将内核缓冲写入磁盘
+    if (0 != fsync(file.handle())) {
+        qWarning() << __FUNCTION__ << "sync file failed:" << m_path;
+    }
+}
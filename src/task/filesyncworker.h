@@ -0,0 +1,28 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FILESYNCWORKER_H
+#define FILESYNCWORKER_H
+
+#include "vntask.h"
+
+/**
+ * @brief The FileSyncWorker class
+ * 将已写完的文件同步到磁盘，用于录音过程中已完成的分段，避免在流线程中等待磁盘
+ */
+class FileSyncWorker : public VNTask
+{
+    Q_OBJECT
+public:
+    explicit FileSyncWorker(const QString &path, QObject *parent = nullptr);
+
+protected:
+    virtual void run() override;
+
+private:
+    QString m_path {""}; //需要同步的文件
+};
+
+#endif // FILESYNCWORKER_H
@@ -0,0 +1,140 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "imageinsertworker.h"
+#include "common/vnoteattachmentstore.h"
+#include "common/vnoteimagecache.h"
+
+#include <QBuffer>
+#include <QFileInfo>
+#include <QImageReader>
+
+#include <climits>
+
+/**
+ * @brief ImageInsertWorker::ImageInsertWorker
+ * @param pendingId 占位id
+ * @param srcPath 图片文件路径
+ * @param parent
+ */
+ImageInsertWorker::ImageInsertWorker(const QString &pendingId, const QString &srcPath, QObject *parent)
+    : VNTask(parent)
+    , m_pendingId(pendingId)
+    , m_srcPath(srcPath)
+{
+}
+
+/**
+ * @brief ImageInsertWorker::ImageInsertWorker
+ * @param pendingId 占位id
+ * @param image 剪贴板图片
+ * @param parent
+ */
+ImageInsertWorker::ImageInsertWorker(const QString &pendingId, const QImage &image, QObject *parent)
+    : VNTask(parent)
+    , m_pendingId(pendingId)
+    , m_image(image)
+{
+}
+
+/**
+ * @brief ImageInsertWorker::setPolicy
+ * @param policy 插入策略
+ */
+void ImageInsertWorker::setPolicy(const VNoteImagePolicy &policy)
+{
+    m_policy = policy;
+}
+
+/**
+ * @brief ImageInsertWorker::setThumbnailWidth
+ * @param width 缩略图宽度
+ */
+void ImageInsertWorker::setThumbnailWidth(int width)
+{
+    m_thumbnailWidth = width;
+}
+
+/**
+ * @brief ImageInsertWorker::saveImage
+ * @param image 图片
+ * @return 存储路径
+ */
+QString ImageInsertWorker::saveImage(const QImage &image)
+{
+    VNoteImagePolicy::Format format = VNoteImagePolicy::Png;
+    QByteArray data = m_policy.encode(image, format);
+    if (data.isEmpty()) {
+        return QString();
+    }
+
+    //文件未缩小且重新编码后没有变小时保持原样
+    if (!m_srcPath.isEmpty() && image.size() == QImageReader(m_srcPath).size()
+            && data.size() >= QFileInfo(m_srcPath).size()) {
+        return VNoteAttachmentStore::importFile(m_srcPath, VNoteAttachmentStore::imageDir());
+    }
+    return VNoteAttachmentStore::importData(data, VNoteAttachmentStore::imageDir(), VNoteImagePolicy::suffix(format));
+}
+
+/**
+ * @brief ImageInsertWorker::saveOriginal
+ * @return 原图存储路径
+ */
+QString ImageInsertWorker::saveOriginal()
+{
+    if (!m_srcPath.isEmpty()) {
+        return VNoteAttachmentStore::importFile(m_srcPath, VNoteAttachmentStore::imageDir());
+    }
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    if (!m_image.save(&buffer, "png")) {
+        return QString();
+    }
+    return VNoteAttachmentStore::importData(data, VNoteAttachmentStore::imageDir(), "png");
+}
+
+/**
+ * @brief ImageInsertWorker::run
+ */
+void ImageInsertWorker::run()
+{
+    QString path;
+    QString originalPath;
+    bool transcoded = true;
+
+    if (!m_image.isNull()) {
+        path = saveImage(m_policy.capSize(m_image));
+    } else {
+        QSize size = QImageReader(m_srcPath).size();
+        if (m_policy.needTranscode(m_srcPath, size)) {
+            //按最大尺寸解码后重新编码
+            QSize maxSize = m_policy.maxSize > 0 ? QSize(m_policy.maxSize, m_policy.maxSize) : QSize();
+            QImage image = VNoteImageCache::loadScaled(m_srcPath, maxSize);
+            if (!image.isNull()) {
+                path = saveImage(image);
+            }
+        } else {
+            path = VNoteAttachmentStore::importFile(m_srcPath, VNoteAttachmentStore::imageDir());
+            transcoded = false;
+        }
+    }
+
+    //图片经过重新编码时按需保存原图
+    if (!path.isEmpty() && transcoded && m_policy.keepOriginal) {
+        originalPath = saveOriginal();
+        if (originalPath == path) {
+            originalPath.clear();
+        }
+    }
+
+    //预先生成编辑区使用的缩略图
+    if (!path.isEmpty() && m_thumbnailWidth > 0) {
+        VNoteImageCache::loadScaled(path, QSize(m_thumbnailWidth, INT_MAX));
+    }
+
+    emit imageInserted(m_pendingId, path, originalPath);
+}
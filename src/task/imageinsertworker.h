@@ -0,0 +1,57 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef IMAGEINSERTWORKER_H
+#define IMAGEINSERTWORKER_H
+
+#include "vntask.h"
+#include "common/vnoteimagepolicy.h"
+
+#include <QImage>
+
+/**
+ * @brief The ImageInsertWorker class
+ * 插入图片处理线程，按插入策略缩小、重新编码图片，存入附件目录并预先生成缩略图
+ */
+class ImageInsertWorker : public VNTask
+{
+    Q_OBJECT
+public:
+    //插入图片文件
+    ImageInsertWorker(const QString &pendingId, const QString &srcPath, QObject *parent = nullptr);
+    //插入剪贴板图片
+    ImageInsertWorker(const QString &pendingId, const QImage &image, QObject *parent = nullptr);
+
+    //设置插入策略
+    void setPolicy(const VNoteImagePolicy &policy);
+    //设置编辑区缩略图宽度，小于等于0时不生成缩略图
+    void setThumbnailWidth(int width);
+
+signals:
+    /**
+     * @brief 图片处理完成
+     * @param pendingId 占位id
+     * @param path 图片存储路径，失败时为空
+     * @param originalPath 重新编码时保存的原图路径，未保存时为空
+     */
+    void imageInserted(const QString &pendingId, const QString &path, const QString &originalPath);
+
+protected:
+    virtual void run() override;
+
+private:
+    //按策略编码图片并保存，返回存储路径
+    QString saveImage(const QImage &image);
+    //保存原图，返回存储路径
+    QString saveOriginal();
+
+    QString m_pendingId {""}; //占位id
+    QString m_srcPath {""}; //图片文件路径
+    QImage m_image; //剪贴板图片
+    VNoteImagePolicy m_policy; //插入策略
+    int m_thumbnailWidth {0}; //编辑区缩略图宽度
+};
+
+#endif // IMAGEINSERTWORKER_H
@@ -0,0 +1,29 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "imageloadworker.h"
+#include "common/vnoteimagecache.h"
+
+/**
+ * @brief ImageLoadWorker::ImageLoadWorker
+ * @param path 图片路径
+ * @param maxSize 最大显示尺寸
+ * @param parent
+ */
+ImageLoadWorker::ImageLoadWorker(const QString &path, const QSize &maxSize, QObject *parent)
+    : VNTask(parent)
+    , m_path(path)
+    , m_maxSize(maxSize)
+{
+}
+
+/**
+ * @brief ImageLoadWorker::run
+ */
+void ImageLoadWorker::run()
+{
+    QImage image = VNoteImageCache::loadScaled(m_path, m_maxSize);
+    emit imageLoaded(m_path, m_maxSize, image);
+}
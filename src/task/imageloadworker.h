@@ -0,0 +1,41 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef IMAGELOADWORKER_H
+#define IMAGELOADWORKER_H
+
+#include "vntask.h"
+
+#include <QImage>
+#include <QSize>
+
+/**
+ * @brief The ImageLoadWorker class
+ * 图片解码线程，按最大显示尺寸解码图片，优先使用磁盘缩略图缓存
+ */
+class ImageLoadWorker : public VNTask
+{
+    Q_OBJECT
+public:
+    ImageLoadWorker(const QString &path, const QSize &maxSize, QObject *parent = nullptr);
+
+signals:
+    /**
+     * @brief 图片解码完成
+     * @param path 图片路径
+     * @param maxSize 最大显示尺寸
+     * @param image 图片，失败时为空
+     */
+    void imageLoaded(const QString &path, const QSize &maxSize, const QImage &image);
+
+protected:
+    virtual void run() override;
+
+private:
+    QString m_path {""}; //图片路径
+    QSize m_maxSize; //最大显示尺寸
+};
+
+#endif // IMAGELOADWORKER_H
@@ -0,0 +1,64 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "journalwriteworker.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @brief JournalWriteWorker::JournalWriteWorker
+ * @param op 日志操作
+ * @param path 日志文件路径
+ * @param record 追加的记录
+ * @param parent
+ */
+JournalWriteWorker::JournalWriteWorker(Operation op, const QString &path, const QByteArray &record, QObject *parent)
+    : VNTask(parent)
+    , m_op(op)
+    , m_path(path)
+    , m_record(record)
+{
+}
+
+/**
+ * @brief JournalWriteWorker::run
+ */
+void JournalWriteWorker::run()
+{
+    if (Remove == m_op) {
+        if (QFile::exists(m_path) && !QFile::remove(m_path)) {
+            qWarning() << __FUNCTION__ << "remove journal failed:" << m_path;
+        }
+        return;
+    }
+
+    bool created = !QFile::exists(m_path);
+    QFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << __FUNCTION__ << "open journal failed:" << m_path << file.errorString();
+        return;
+    }
+    //一条记录一行，记录本身为紧凑json不含换行
+    file.write(m_record);
+    file.write("\n");
+    //合并到数据库前日志是唯一的完整副本，写入磁盘后才算保存
+    if (!file.flush() || 0 != fsync(file.handle())) {
+        qWarning() << __FUNCTION__ << "sync journal failed:" << m_path << file.errorString();
+        return;
+    }
+    //新建的日志文件还需要同步目录项
+    if (created) {
+        int dirFd = ::open(QFile::encodeName(QFileInfo(m_path).absolutePath()).constData(), O_RDONLY | O_DIRECTORY);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            ::close(dirFd);
+        }
+    }
+}
@@ -0,0 +1,38 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef JOURNALWRITEWORKER_H
+#define JOURNALWRITEWORKER_H
+
+#include "vntask.h"
+
+#include <QByteArray>
+
+/**
+ * @brief The JournalWriteWorker class
+ * 笔记编辑日志读写线程，追加增量记录或删除已合并的日志文件
+ */
+class JournalWriteWorker : public VNTask
+{
+    Q_OBJECT
+public:
+    //日志操作
+    enum Operation {
+        Append = 0, //追加记录
+        Remove, //删除日志
+    };
+
+    JournalWriteWorker(Operation op, const QString &path, const QByteArray &record = QByteArray(), QObject *parent = nullptr);
+
+protected:
+    virtual void run() override;
+
+private:
+    Operation m_op {Append};
+    QString m_path {""}; //日志文件路径
+    QByteArray m_record; //追加的记录，一行一条
+};
+
+#endif // JOURNALWRITEWORKER_H
@@ -0,0 +1,35 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "recordfinishworker.h"
+#include "common/vnoterecordsession.h"
+#include "common/vnoteattachmentstore.h"
+#include "common/vnotepeakfile.h"
+
+/**
+ * @brief RecordFinishWorker::RecordFinishWorker
+ * @param outputPath 录音文件路径
+ * @param parent
+ */
+RecordFinishWorker::RecordFinishWorker(const QString &outputPath, QObject *parent)
+    : VNTask(parent)
+    , m_outputPath(outputPath)
+{
+}
+
+/**
+ * @brief RecordFinishWorker::run
+ */
+void RecordFinishWorker::run()
+{
+    if (!VNoteRecordSession::finish(m_outputPath)) {
+        emit recordFinished(m_outputPath, QString(), false);
+        return;
+    }
+    //录音文件按内容哈希命名存入附件存储，峰值文件随之改名
+    QString storedPath = VNoteAttachmentStore::adoptFile(m_outputPath);
+    VNotePeakFile::movePeakFile(m_outputPath, storedPath);
+    emit recordFinished(m_outputPath, storedPath, true);
+}
@@ -0,0 +1,38 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RECORDFINISHWORKER_H
+#define RECORDFINISHWORKER_H
+
+#include "vntask.h"
+
+/**
+ * @brief The RecordFinishWorker class
+ * 结束录音会话，合并分段并写入磁盘，再按内容哈希存入附件存储，
+ * 长录音合并和计算哈希耗时较长，不在界面线程执行
+ */
+class RecordFinishWorker : public VNTask
+{
+    Q_OBJECT
+public:
+    explicit RecordFinishWorker(const QString &outputPath, QObject *parent = nullptr);
+
+signals:
+    /**
+     * @brief 录音会话结束
+     * @param outputPath 录音文件路径
+     * @param storedPath 存入附件存储后的路径，失败时为空
+     * @param success 合并失败时保留会话，下次启动时恢复
+     */
+    void recordFinished(const QString &outputPath, const QString &storedPath, bool success);
+
+protected:
+    virtual void run() override;
+
+private:
+    QString m_outputPath {""}; //录音文件路径
+};
+
+#endif // RECORDFINISHWORKER_H
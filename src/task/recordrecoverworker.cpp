@@ -0,0 +1,32 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "recordrecoverworker.h"
+#include "common/vnoterecordsession.h"
+#include "common/vnoteattachmentstore.h"
+
+/**
+ * @brief RecordRecoverWorker::RecordRecoverWorker
+ * @param noteId 笔记id
+ * @param parent
+ */
+RecordRecoverWorker::RecordRecoverWorker(qint32 noteId, QObject *parent)
+    : VNTask(parent)
+    , m_noteId(noteId)
+{
+}
+
+/**
+ * @brief RecordRecoverWorker::run
+ */
+void RecordRecoverWorker::run()
+{
+    for (const VNoteRecordSession::Recovered &voice : VNoteRecordSession::finishRecovered(m_noteId)) {
+        //与正常结束的录音一样按内容哈希存储，重复合并时得到同一文件
+        QString storedPath = VNoteAttachmentStore::adoptFile(voice.path);
+        emit voiceRecovered(m_noteId, voice.path, storedPath, voice.duration, voice.createTime);
+    }
+    emit recoverFinished(m_noteId);
+}
@@ -0,0 +1,45 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef RECORDRECOVERWORKER_H
+#define RECORDRECOVERWORKER_H
+
+#include "vntask.h"
+
+#include <QDateTime>
+
+/**
+ * @brief The RecordRecoverWorker class
+ * 合并笔记中异常退出遗留的录音并存入附件存储，长录音合并和计算哈希耗时较长，不在界面线程执行。
+ * 会话在录音插入笔记后才删除，插入前切换了笔记时下次打开再恢复
+ */
+class RecordRecoverWorker : public VNTask
+{
+    Q_OBJECT
+public:
+    explicit RecordRecoverWorker(qint32 noteId, QObject *parent = nullptr);
+
+signals:
+    /**
+     * @brief 一个录音合并完成
+     * @param noteId 所属笔记
+     * @param outputPath 录音会话的输出路径，插入笔记后用于删除会话
+     * @param storedPath 存入附件存储后的路径
+     * @param duration 录音时长，单位毫秒
+     * @param createTime 录音开始时间
+     */
+    void voiceRecovered(qint32 noteId, const QString &outputPath, const QString &storedPath,
+                        qint64 duration, const QDateTime &createTime);
+    //笔记的所有录音处理完成
+    void recoverFinished(qint32 noteId);
+
+protected:
+    virtual void run() override;
+
+private:
+    qint32 m_noteId {-1}; //所属笔记
+};
+
+#endif // RECORDRECOVERWORKER_H
@@ -0,0 +1,50 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "textextractworker.h"
+#include "common/vnotesearchindex.h"
+
+#include <QThread>
+#include <QDebug>
+
+/**
+ * @brief TextExtractWorker::TextExtractWorker
+ * @param index 搜索索引
+ * @param parent
+ */
+TextExtractWorker::TextExtractWorker(VNoteSearchIndex *index, QObject *parent)
+    : VNTask(parent)
+    , m_index(index)
+{
+}
+
+/**
+ * @brief TextExtractWorker::run
+ * 分批取出待提取附件，直到队列为空
+ */
+void TextExtractWorker::run()
+{
+    if (nullptr == m_index) {
+        return;
+    }
+
+    //后台任务不与界面线程竞争
+    QThread::currentThread()->setPriority(QThread::LowestPriority);
+
+    int count = 0;
+    QList<VNoteExtractItem> batch;
+    while (!(batch = m_index->takeBatch(BatchSize)).isEmpty()) {
+        for (const VNoteExtractItem &item : batch) {
+            m_index->setExtractedText(item, m_index->extract(item));
+            count++;
+        }
+        //批次之间让出时间片
+        QThread::msleep(20);
+    }
+
+    m_index->saveCache();
+    qDebug() << __FUNCTION__ << "extract items:" << count;
+    emit extractFinished(count);
+}
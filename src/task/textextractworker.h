@@ -0,0 +1,39 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TEXTEXTRACTWORKER_H
+#define TEXTEXTRACTWORKER_H
+
+#include "vntask.h"
+
+class VNoteSearchIndex;
+
+/**
+ * @brief The TextExtractWorker class
+ * 附件文本提取线程，以最低优先级分批处理搜索索引中的待提取队列
+ */
+class TextExtractWorker : public VNTask
+{
+    Q_OBJECT
+public:
+    explicit TextExtractWorker(VNoteSearchIndex *index, QObject *parent = nullptr);
+
+    //每批处理的附件数
+    enum {
+        BatchSize = 8,
+    };
+
+signals:
+    //队列处理完成，count为提取的附件数
+    void extractFinished(int count);
+
+protected:
+    virtual void run() override;
+
+private:
+    VNoteSearchIndex *m_index {nullptr};
+};
+
+#endif // TEXTEXTRACTWORKER_H
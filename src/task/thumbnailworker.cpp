@@ -0,0 +1,59 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "thumbnailworker.h"
+#include "common/vnoteimagecache.h"
+
+#include <QBuffer>
+#include <climits>
+
+/**
+ * @brief ThumbnailWorker::ThumbnailWorker
+ * @param requestId 请求id
+ * @param path 原图路径
+ * @param width 显示宽度
+ * @param parent
+ */
+ThumbnailWorker::ThumbnailWorker(quint64 requestId, const QString &path, int width, QObject *parent)
+    : VNTask(parent)
+    , m_requestId(requestId)
+    , m_path(path)
+    , m_width(width)
+{
+}
+
+/**
+ * @brief ThumbnailWorker::loadScaled
+ * 通过图片缓存服务解码，缩小后的图片使用磁盘缓存
+ * @param path 图片路径
+ * @param maxWidth 最大宽度
+ * @return 图片，失败时为空
+ */
+QImage ThumbnailWorker::loadScaled(const QString &path, int maxWidth)
+{
+    return VNoteImageCache::loadScaled(path, maxWidth > 0 ? QSize(maxWidth, INT_MAX) : QSize());
+}
+
+/**
+ * @brief ThumbnailWorker::run
+ */
+void ThumbnailWorker::run()
+{
+    QByteArray data;
+    QByteArray mimeType;
+    QImage image = loadScaled(m_path, m_width);
+    if (!image.isNull()) {
+        //有透明通道时使用png，否则使用jpg减小体积
+        const char *format = image.hasAlphaChannel() ? "png" : "jpg";
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        if (image.save(&buffer, format, 90)) {
+            mimeType = QByteArray("image/") + (image.hasAlphaChannel() ? "png" : "jpeg");
+        } else {
+            data.clear();
+        }
+    }
+    emit thumbnailReady(m_requestId, data, mimeType);
+}
@@ -0,0 +1,44 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef THUMBNAILWORKER_H
+#define THUMBNAILWORKER_H
+
+#include "vntask.h"
+
+#include <QImage>
+
+/**
+ * @brief The ThumbnailWorker class
+ * 缩略图生成线程，按显示宽度解码图片并编码为web端可用的数据
+ */
+class ThumbnailWorker : public VNTask
+{
+    Q_OBJECT
+public:
+    ThumbnailWorker(quint64 requestId, const QString &path, int width, QObject *parent = nullptr);
+
+    //按最大宽度解码图片，只缩小不放大
+    static QImage loadScaled(const QString &path, int maxWidth);
+
+signals:
+    /**
+     * @brief 缩略图生成完成
+     * @param requestId 请求id
+     * @param data 图片数据，失败时为空
+     * @param mimeType 图片类型
+     */
+    void thumbnailReady(quint64 requestId, const QByteArray &data, const QByteArray &mimeType);
+
+protected:
+    virtual void run() override;
+
+private:
+    quint64 m_requestId {0};
+    QString m_path {""}; //原图路径
+    int m_width {0}; //显示宽度
+};
+
+#endif // THUMBNAILWORKER_H
@@ -27,6 +27,12 @@
 #include "common/setting.h"
 #include "common/performancemonitor.h"
 #include "common/jscontent.h"
+#include "common/vnotesearchindex.h"
+#include "common/vnotejournal.h"
+#include "common/vnoteimagecache.h"
+#include "common/vnoterecordsession.h"
+#include "common/vnoteasrqueue.h"
+#include "common/vlcpalyer.h"
 
 #include "db/vnotefolderoper.h"
 #include "db/vnoteitemoper.h"
@@ -154,6 +160,8 @@ void VNoteMainWindow::initConnections()
             this, &VNoteMainWindow::onStartRecord);
     connect(m_recordBar, &VNoteRecordBar::sigFinshRecord,
             this, &VNoteMainWindow::onFinshRecord);
+    connect(m_recordBar, &VNoteRecordBar::sigRecordFailed,
+            this, &VNoteMainWindow::onRecordFailed);
     connect(m_recordBar, &VNoteRecordBar::sigPlayVoice,
             this, &VNoteMainWindow::onPlayPlugVoicePlay);
     connect(m_recordBar, &VNoteRecordBar::sigPauseVoice,
@@ -572,8 +580,15 @@ void VNoteMainWindow::initA2TManager()
     m_a2tManager = new VNoteA2TManager(this);
 
     connect(m_richTextEdit, &WebRichTextEditor::asrStart, this, &VNoteMainWindow::onA2TStart);
+    connect(m_richTextEdit, &WebRichTextEditor::playAllVoices, this, &VNoteMainWindow::onWebVoicePlayAll);
     connect(m_a2tManager, &VNoteA2TManager::asrError, this, &VNoteMainWindow::onA2TError);
     connect(m_a2tManager, &VNoteA2TManager::asrSuccess, this, &VNoteMainWindow::onA2TSuccess);
+
+    //批量转写使用独立的转写通道，不影响单条语音转写
+    VNoteAsrQueue *asrQueue = VNoteAsrQueue::instance();
+    connect(asrQueue, &VNoteAsrQueue::jobFinished, this, &VNoteMainWindow::onAsrJobFinished);
+    connect(asrQueue, &VNoteAsrQueue::progressChanged, this, &VNoteMainWindow::onAsrQueueProgress);
+    connect(asrQueue, &VNoteAsrQueue::queueFinished, this, &VNoteMainWindow::onAsrQueueFinished);
 }
 
 /**
@@ -630,6 +645,8 @@ void VNoteMainWindow::initDelayWork()
         ActionManager::Instance()->visibleAiActions(isVailid);
     }
     stateOperation->operState(OpsStateInterface::StateAISrvAvailable, isVailid);
+    //清理超出上限的图片缓存
+    VNoteImageCache::trimDiskCache();
 }
 
 /**
@@ -657,6 +674,13 @@ void VNoteMainWindow::onVNoteFoldersLoaded()
     }
 #endif
 
+    //恢复异常退出时未合并到数据库的编辑内容
+    VNoteJournal::instance()->recover();
+    //检查异常退出时遗留的录音分段，打开所属笔记时插入
+    VNoteRecordSession::recover();
+    //继续上次退出时未完成的批量转写
+    VNoteAsrQueue::instance()->restore();
+
     //If have folders show note view,else show
     //default home page
     if (loadNotepads() > 0) {
@@ -674,6 +698,9 @@ void VNoteMainWindow::onVNoteFoldersLoaded()
     pFileCleanupWorker->setAutoDelete(true);
     pFileCleanupWorker->setObjectName("FileCleanupWorker");
     QThreadPool::globalInstance()->start(pFileCleanupWorker);
+
+    //后台提取附件文本，用于搜索语音转写及图片文字
+    VNoteSearchIndex::instance()->scheduleAllNotes(VNoteDataManager::instance()->getAllNotesInFolder());
 }
 
 /**
@@ -691,10 +718,10 @@ void VNoteMainWindow::onVNoteSearch()
                 m_richTextEdit->searchText(m_searchKey);
             } else {
                 m_searchKey = text;
-                //重新搜索之前先更新笔记内容
-                m_richTextEdit->updateNote();
-                //重新搜索
-                loadSearchNotes(m_searchKey);
+                //重新搜索之前先更新笔记内容，保存完成后重新搜索
+                m_richTextEdit->updateNote([this] {
+                    loadSearchNotes(m_searchKey);
+                });
             }
         } else {
             setSpecialStatus(SearchEnd);
@@ -807,7 +834,11 @@ void VNoteMainWindow::initEmptyFoldersView()
  */
 void VNoteMainWindow::onStartRecord(const QString &path)
 {
-    Q_UNUSED(path)
+    //记录录音所属笔记，异常退出后恢复到该笔记
+    VNoteItem *note = m_middleView->getCurrVNotedata();
+    if (nullptr != note) {
+        VNoteRecordSession::setNoteId(path, note->noteId);
+    }
     setSpecialStatus(RecordStart);
     //Hold shutdown locker
     holdHaltLock();
@@ -820,8 +851,9 @@ void VNoteMainWindow::onStartRecord(const QString &path)
  */
 void VNoteMainWindow::onFinshRecord(const QString &voicePath, qint64 voiceSize)
 {
+    //录音线程已将文件存入附件存储
     if (voiceSize >= 1000) {
-        m_richTextEdit->insertVoiceItem(voicePath, voiceSize);
+        m_richTextEdit->insertVoiceItem(voicePath, voiceSize, m_recordBar->speechSegments());
     }
     setSpecialStatus(RecordEnd);
 
@@ -834,6 +866,22 @@ void VNoteMainWindow::onFinshRecord(const QString &voicePath, qint64 voiceSize)
     }
 }
 
+/**
+ * @brief VNoteMainWindow::onRecordFailed
+ * @param voicePath 录音文件路径
+ * @param recoverable 录音分段已保留，下次启动时恢复
+ */
+void VNoteMainWindow::onRecordFailed(const QString &voicePath, bool recoverable)
+{
+    if (recoverable) {
+        showAsrErrMessage(DApplication::translate(
+                              "VNoteErrorMessage",
+                              "Failed to save the recording, it will be restored next time you start the app"));
+    }
+    //与录音完成一致，恢复状态并释放关机锁
+    onFinshRecord(voicePath, 0);
+}
+
 /**
  * @brief VNoteMainWindow::onA2TStart
  * @param voiceBlock 语音数据
@@ -845,17 +893,17 @@ void VNoteMainWindow::onA2TStart(const VNVoiceBlock *voiceBlock)
     if (nullptr == m_voiceBlock) {
         return;
     }
-    //超过20分钟的语音不支持转文字
-    if (m_voiceBlock->voiceSize > MAX_A2T_AUDIO_LEN_MS) {
-        VNoteMessageDialog audioOutLimit(
-            VNoteMessageDialog::AsrTimeLimit, this);
-        audioOutLimit.exec();
-    } else {
-        setSpecialStatus(VoiceToTextStart); //更新状态
-        QTimer::singleShot(0, this, [this]() {
-            m_a2tManager->startAsr(m_voiceBlock->voicePath, m_voiceBlock->voiceSize); //开始转文字
-        });
+    //批量转写中的语音取消排队的任务，正在转写时等待批量转写的结果
+    if (!VNoteAsrQueue::instance()->cancel(m_voiceBlock->voicePath)) {
+        qInfo() << __FUNCTION__ << "voice is converting in queue:" << m_voiceBlock->voicePath;
+        m_voiceBlock = nullptr;
+        return;
     }
+    //长录音由转写模块在静音处分段转写，不再限制时长
+    setSpecialStatus(VoiceToTextStart); //更新状态
+    QTimer::singleShot(0, this, [this]() {
+        m_a2tManager->startAsr(m_voiceBlock->voicePath, m_voiceBlock->voiceSize); //开始转文字
+    });
 }
 
 /**
@@ -891,6 +939,70 @@ void VNoteMainWindow::onA2TSuccess(const QString &text)
     setSpecialStatus(VoiceToTextEnd); //更新状态
 }
 
+/**
+ * @brief VNoteMainWindow::onAsrJobFinished
+ * 批量转写的结果写入所属笔记，当前显示的笔记由web端插入
+ * @param job 转写任务
+ * @param text 转写后的文本
+ */
+void VNoteMainWindow::onAsrJobFinished(const VNoteAsrJob &job, const QString &text)
+{
+    m_richTextEdit->setVoiceText(job.noteId, job.voicePath, text);
+}
+
+/**
+ * @brief VNoteMainWindow::onAsrQueueProgress
+ * @param finished 已结束的任务数
+ * @param total 任务总数
+ */
+void VNoteMainWindow::onAsrQueueProgress(int finished, int total)
+{
+    if (m_asrQueueMessage == nullptr) {
+        m_asrQueueMessage = new DFloatingMessage(DFloatingMessage::ResidentType, m_centerWidget);
+        m_asrQueueMessage->setIcon(QIcon::fromTheme("dialog-information"));
+        //关闭后本轮转写不再弹出，转写在后台继续
+        connect(m_asrQueueMessage, &DFloatingMessage::closeButtonClicked, this, [this]() {
+            m_asrQueueMessageClosed = true;
+            m_asrQueueMessage->setVisible(false);
+        });
+    }
+
+    if (m_asrQueueMessageClosed) {
+        return;
+    }
+
+    m_asrQueueMessage->setMessage(
+        DApplication::translate("VNoteMainWindow", "Converting voices to text: %1/%2").arg(finished).arg(total));
+    m_asrQueueMessage->setVisible(true);
+    m_asrQueueMessage->setMaximumWidth(m_centerWidget->width());
+    m_asrQueueMessage->adjustSize();
+
+    int xPos = (m_centerWidget->width() - m_asrQueueMessage->width()) / 2;
+    int yPos = m_centerWidget->height() - m_asrQueueMessage->height() - 5;
+    m_asrQueueMessage->move(xPos, yPos);
+}
+
+/**
+ * @brief VNoteMainWindow::onAsrQueueFinished
+ * @param succeeded 转写成功的任务数
+ * @param failed 转写失败的任务数
+ * @param deferred 网络不可用，下次启动时继续转写的任务数
+ */
+void VNoteMainWindow::onAsrQueueFinished(int succeeded, int failed, int deferred)
+{
+    Q_UNUSED(succeeded)
+    m_asrQueueMessageClosed = false;
+    if (m_asrQueueMessage != nullptr) {
+        m_asrQueueMessage->setVisible(false);
+    }
+
+    if (failed > 0) {
+        showAsrErrMessage(DApplication::translate("VNoteMainWindow", "%1 voice(s) failed to convert to text").arg(failed));
+    } else if (deferred > 0) {
+        showAsrErrMessage(DApplication::translate("VNoteMainWindow", "Network error, %1 voice(s) will be converted to text next time").arg(deferred));
+    }
+}
+
 /**
  * @brief VNoteMainWindow::onPreviewShortcut
  */
@@ -1128,6 +1240,15 @@ void VNoteMainWindow::onVNoteChange(const QModelIndex &previous)
     }
     //多选笔记时不更新详情页内容
     if (!m_middleView->isMultipleSelected()) {
+        //预加载列表中相邻的笔记，方向键切换时直接显示
+        QList<qint32> preloadIds;
+        for (int row : {index.row() - 1, index.row() + 1}) {
+            VNoteItem *note = static_cast<VNoteItem *>(StandardItemCommon::getStandardItemData(index.siblingAtRow(row)));
+            if (nullptr != note) {
+                preloadIds.append(note->noteId);
+            }
+        }
+        m_richTextEdit->setPreloadNotes(preloadIds);
         m_richTextEdit->initData(data, m_searchKey, m_rightViewHasFouse);
     }
     //没有数据，插入图片按钮禁用
@@ -1179,6 +1300,12 @@ void VNoteMainWindow::onMenuAction(QAction *action)
     case ActionManager::NoteTop:
         m_middleView->noteStickOnTop();
         break;
+    case ActionManager::NotebookVoiceToText:
+        transcribeVoices(true);
+        break;
+    case ActionManager::NoteVoiceToText:
+        transcribeVoices(false);
+        break;
     case ActionManager::NoteMove: {
         //删除前记录选中位置
         m_middleView->setNextSelection();
@@ -1233,6 +1360,7 @@ void VNoteMainWindow::onMenuAbout2Show()
             }
             if (stateOperation->isRecording()) {
                 ActionManager::Instance()->enableAction(ActionManager::NoteSaveVoice, false);
+                ActionManager::Instance()->enableAction(ActionManager::NoteVoiceToText, false);
             }
             ActionManager::Instance()->enableAction(ActionManager::NoteMove, false);
         }
@@ -1243,9 +1371,13 @@ void VNoteMainWindow::onMenuAbout2Show()
         if (1 == m_leftView->folderCount()) {
             ActionManager::Instance()->enableAction(ActionManager::NoteMove, false);
         }
+        if (!stateOperation->isAiSrvExist()) {
+            ActionManager::Instance()->enableAction(ActionManager::NoteVoiceToText, false);
+        }
         if (m_middleView->isMultipleSelected()) {
             if (!m_middleView->haveVoice()) {
                 ActionManager::Instance()->enableAction(ActionManager::NoteSaveVoice, false);
+                ActionManager::Instance()->enableAction(ActionManager::NoteVoiceToText, false);
             }
             //根据选中笔记是否有文本设置保存笔记二级菜单置灰状态
             ActionManager::Instance()->saveNoteContextMenu()->setEnabled(m_middleView->haveText());
@@ -1256,6 +1388,7 @@ void VNoteMainWindow::onMenuAbout2Show()
                 ActionManager::Instance()->saveNoteContextMenu()->setEnabled(currNoteData->haveText());
                 if (!currNoteData->haveVoice()) {
                     ActionManager::Instance()->enableAction(ActionManager::NoteSaveVoice, false);
+                    ActionManager::Instance()->enableAction(ActionManager::NoteVoiceToText, false);
                 }
                 if (currNoteData->isTop) {
                     topAction->setText(DApplication::translate("NotesContextMenu", "Unstick"));
@@ -1273,6 +1406,9 @@ void VNoteMainWindow::onMenuAbout2Show()
             ActionManager::Instance()->enableAction(ActionManager::NotebookAddNew, false);
             ActionManager::Instance()->enableAction(ActionManager::NotebookDelete, false);
         }
+        if (stateOperation->isRecording() || !stateOperation->isAiSrvExist()) {
+            ActionManager::Instance()->enableAction(ActionManager::NotebookVoiceToText, false);
+        }
     }
 }
 
@@ -1456,6 +1592,43 @@ void VNoteMainWindow::delNote()
     m_middleView->selectAfterRemoved();
 }
 
+/**
+ * @brief VNoteMainWindow::transcribeVoices
+ * 先同步编辑区内容，再从笔记数据中收集待转写的语音
+ * @param wholeNotebook true转写当前记事本所有笔记，false转写选中的笔记
+ */
+void VNoteMainWindow::transcribeVoices(bool wholeNotebook)
+{
+    QList<qint32> noteIds;
+    if (wholeNotebook) {
+        QModelIndex index = m_leftView->currentIndex();
+        if (StandardItemCommon::getStandardItemType(index) != StandardItemCommon::NOTEPADITEM) {
+            return;
+        }
+        VNoteFolder *folder = reinterpret_cast<VNoteFolder *>(StandardItemCommon::getStandardItemData(index));
+        VNOTE_ITEMS_MAP *notes = VNoteDataManager::instance()->getFolderNotes(folder->id);
+        if (notes) {
+            notes->lock.lockForRead();
+            for (auto it : notes->folderNotes) {
+                noteIds.append(it->noteId);
+            }
+            notes->lock.unlock();
+        }
+    } else {
+        for (VNoteItem *note : m_middleView->getCurrVNotedataList()) {
+            noteIds.append(note->noteId);
+        }
+    }
+
+    m_richTextEdit->updateNote([noteIds]() {
+        VNoteAsrJobs jobs;
+        for (qint32 noteId : noteIds) {
+            jobs.append(VNoteAsrQueue::jobsFromNote(VNoteDataManager::instance()->findNote(noteId)));
+        }
+        VNoteAsrQueue::instance()->enqueue(jobs);
+    });
+}
+
 /**
  * @brief VNoteMainWindow::loadNotes
  * @param folder
@@ -1498,15 +1671,31 @@ int VNoteMainWindow::loadSearchNotes(const QString &key)
     m_middleView->setSearchKey(key);
     VNOTE_ALL_NOTES_MAP *noteAll = VNoteDataManager::instance()->getAllNotesInFolder();
     if (noteAll) {
+        //相同关键字且数据未变化时直接使用缓存结果
+        int dataVersion = VNoteDataManager::instance()->dataVersion();
+        QVector<qint32> noteIds;
+        bool cached = m_searchCache.find(key, dataVersion, noteIds);
+        QSet<qint32> hitIds;
+        for (qint32 id : noteIds) {
+            hitIds.insert(id);
+        }
         noteAll->lock.lockForRead();
         for (auto &foldeNotes : noteAll->notes) {
             for (auto note : foldeNotes->folderNotes) {
-                if (note->search(key)) {
+                if (cached) {
+                    if (hitIds.contains(note->noteId)) {
+                        m_middleView->appendRow(note);
+                    }
+                } else if (note->search(key)) {
+                    noteIds.append(note->noteId);
                     m_middleView->appendRow(note);
                 }
             }
         }
         noteAll->lock.unlock();
+        if (!cached) {
+            m_searchCache.insert(key, dataVersion, noteIds);
+        }
         if (m_middleView->rowCount() == 0) {
             m_middleView->setVisibleEmptySearch(true);
             m_stackedRightMainWidget->setCurrentWidget(m_rightViewHolder);
@@ -1530,11 +1719,14 @@ int VNoteMainWindow::loadSearchNotes(const QString &key)
  */
 void VNoteMainWindow::onPlayPlugVoicePlay(VNVoiceBlock *voiceData)
 {
-    Q_UNUSED(voiceData)
     //设置播放状态
     if (!stateOperation->isPlaying()) {
         setSpecialStatus(PlayVoiceStart);
     }
+    //连续播放时切换到下一个语音，同步web前端当前语音
+    if (nullptr != voiceData) {
+        emit JsContent::instance()->callJsSetActiveVoice(voiceData->voicePath);
+    }
     //更新web前端语音播放状态
     emit JsContent::instance()->callJsSetPlayStatus(0);
 }
@@ -1821,6 +2013,9 @@ void VNoteMainWindow::onSystemDown(bool active)
     qInfo() << "System going down...";
 
     if (active) {
+        //休眠、关机前立即保存正在编辑的笔记，不等待自动保存
+        m_richTextEdit->flushNote();
+
         if (stateOperation->isRecording()) {
             m_recordBar->stopRecord();
 
@@ -1856,12 +2051,15 @@ void VNoteMainWindow::release()
     }
 
     VTextSpeechAndTrManager::onStopTextToSpeech();
-    m_richTextEdit->updateNote();
+    //程序退出，同步保存笔记内容
+    m_richTextEdit->flushNote();
 
     if (stateOperation->isVoice2Text()) {
         QScopedPointer<VNoteA2TManager> releaseA2TManger(m_a2tManager);
         releaseA2TManger->stopAsr();
     }
+    //释放播放引擎
+    VlcPalyer::releaseInstance();
 }
 
 /**
@@ -2376,6 +2574,43 @@ void VNoteMainWindow::onWebVoicePlay(const QVariant &json, bool bIsSame)
     m_recordBar->playVoice(m_currentPlayVoice.get(), bIsSame);
 }
 
+/**
+ * @brief 从指定语音开始连续播放笔记中的语音
+ * @param jsons :笔记中所有语音的json数据
+ * @param index :开始播放的语音
+ */
+void VNoteMainWindow::onWebVoicePlayAll(const QStringList &jsons, int index)
+{
+    //录音状态下不允许播放
+    if (stateOperation->isRecording()) {
+        qInfo() << "The recording cannot be played";
+        return;
+    }
+
+    QList<QSharedPointer<VNVoiceBlock>> voices;
+    int startIndex = -1;
+    MetaDataParser dataParser;
+    for (int i = 0; i < jsons.size(); i++) {
+        QSharedPointer<VNVoiceBlock> voice(new VNVoiceBlock);
+        //文件已不存在的语音不加入播放队列
+        if (!dataParser.parse(jsons.at(i), voice.get()) || !QFile::exists(voice->voicePath)) {
+            continue;
+        }
+        if (i >= index && startIndex < 0) {
+            startIndex = voices.size();
+        }
+        voices.append(voice);
+    }
+    if (startIndex < 0) {
+        return;
+    }
+
+    //暂停、继续等操作由播放窗口处理当前队列中的语音
+    m_currentPlayVoice.reset(new VNVoiceBlock);
+    dataParser.parse(jsons.at(index), m_currentPlayVoice.get());
+    m_recordBar->playVoices(voices, startIndex);
+}
+
 /**
  * @brief 富文本编辑器插入图片
  */
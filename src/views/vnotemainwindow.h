@@ -11,6 +11,7 @@
 #include "widgets/vnoteiconbutton.h"
 #include "widgets/vnotepushbutton.h"
 #include "common/vnoteitem.h"
+#include "common/vnotesearchcache.h"
 
 #include <DMainWindow>
 #include <DSearchEdit>
@@ -161,6 +162,8 @@ public slots:
     void onStartRecord(const QString &path);
     //结束录音
     void onFinshRecord(const QString &voicePath, qint64 voiceSize);
+    //录音保存失败
+    void onRecordFailed(const QString &voicePath, bool recoverable);
     //播放窗口播放事件处理
     void onPlayPlugVoicePlay(VNVoiceBlock *voiceData);
     //播放窗口暂停播放事件处理
@@ -177,6 +180,12 @@ public slots:
     void onA2TError(int error);
     //转写成功
     void onA2TSuccess(const QString &text);
+    //批量转写任务完成，写入所属笔记
+    void onAsrJobFinished(const VNoteAsrJob &job, const QString &text);
+    //批量转写进度改变
+    void onAsrQueueProgress(int finished, int total);
+    //批量转写全部结束
+    void onAsrQueueFinished(int succeeded, int failed, int deferred);
     //快捷键帮助
     void onPreviewShortcut();
     //初始化转写错误提示窗口
@@ -220,6 +229,8 @@ public slots:
     void onInsertImageToWebEditor();
     //响应web前端语音播放控制
     void onWebVoicePlay(const QVariant &json, bool bIsSame);
+    //从指定语音开始连续播放笔记中的语音
+    void onWebVoicePlayAll(const QStringList &jsons, int index);
     //当前编辑区内容搜索为空
     void onWebSearchEmpty();
 
@@ -243,6 +254,8 @@ private:
     void editNote();
     //删除记事项
     void delNote();
+    //批量转写记事本或选中笔记中的语音
+    void transcribeVoices(bool wholeNotebook);
     //初始化数据
     int loadNotes(VNoteFolder *folder);
     //根据搜索关键字加载数据
@@ -339,7 +352,10 @@ private:
     //*****************Shortcut keys end**********************
 
     QString m_searchKey;
+    VNoteSearchCache m_searchCache; //搜索结果缓存
     DFloatingMessage *m_asrErrMeassage {nullptr};
+    DFloatingMessage *m_asrQueueMessage {nullptr}; //批量转写进度提示
+    bool m_asrQueueMessageClosed {false}; //本轮批量转写中用户已关闭进度提示
     DFloatingMessage *m_pDeviceExceptionMsg {nullptr};
     DMenu *m_menuExtension {nullptr};
     //Login session manager
@@ -78,6 +78,7 @@ void VNoteRecordBar::initConnections()
     connect(m_recordBtn, &VNote2SIconButton::clicked, this, &VNoteRecordBar::onStartRecord);
     connect(m_recordPanel, SIGNAL(sigFinshRecord(const QString &, qint64)),
             this, SLOT(onFinshRecord(const QString &, qint64)));
+    connect(m_recordPanel, &VNoteRecordWidget::sigRecordFailed, this, &VNoteRecordBar::onRecordFailed);
     connect(m_playPanel, &VNotePlayWidget::sigWidgetClose,
             this, &VNoteRecordBar::onClosePlayWidget);
     connect(m_playPanel, SIGNAL(sigPlayVoice(VNVoiceBlock *)),
@@ -96,17 +97,46 @@ void VNoteRecordBar::initConnections()
  */
 bool VNoteRecordBar::eventFilter(QObject *o, QEvent *e)
 {
-    Q_UNUSED(o);
     //Let NoteItem lost focus when click
     //outside of Note
 
     if (e->type() == QEvent::MouseButtonPress) {
         setFocus(Qt::MouseFocusReason);
+        //只在按下时打开录音设备，悬停不采集
+        if (o == m_recordBtn) {
+            prepareRecord();
+        }
+    } else if (e->type() == QEvent::Enter && o == m_recordBtn) {
+        warmUpRecord();
     }
 
     return false;
 }
 
+/**
+ * @brief VNoteRecordBar::warmUpRecord
+ */
+void VNoteRecordBar::warmUpRecord()
+{
+    if (m_mainLayout->currentWidget() == m_recordBtnHover
+        && m_recordBtn->isEnabled()) {
+        m_recordPanel->warmUpRecord();
+    }
+}
+
+/**
+ * @brief VNoteRecordBar::prepareRecord
+ */
+void VNoteRecordBar::prepareRecord()
+{
+    if (m_mainLayout->currentWidget() == m_recordBtnHover
+        && m_recordBtn->isEnabled()) {
+        m_recordPanel->setAudioDevice(m_audioWatcher->getDeviceName(
+            static_cast<AudioWatcher::AudioMode>(m_currentMode)));
+        m_recordPanel->prepareRecord();
+    }
+}
+
 /**
  * @brief VNoteRecordBar::startRecord
  */
@@ -159,6 +189,17 @@ void VNoteRecordBar::onFinshRecord(const QString &voicePath, qint64 voiceSize)
     emit sigFinshRecord(voicePath, voiceSize);
 }
 
+/**
+ * @brief VNoteRecordBar::onRecordFailed
+ * @param voicePath 录音文件路径
+ * @param recoverable 下次启动时恢复
+ */
+void VNoteRecordBar::onRecordFailed(const QString &voicePath, bool recoverable)
+{
+    m_mainLayout->setCurrentWidget(m_recordBtnHover);
+    emit sigRecordFailed(voicePath, recoverable);
+}
+
 /**
  * @brief VNoteRecordBar::cancelRecord
  */
@@ -167,6 +208,15 @@ void VNoteRecordBar::stopRecord()
     m_recordPanel->stopRecord();
 }
 
+/**
+ * @brief VNoteRecordBar::speechSegments
+ * @return 录音文件中的语音段
+ */
+VNOTE_SPEECH_SEGMENTS VNoteRecordBar::speechSegments() const
+{
+    return m_recordPanel->speechSegments();
+}
+
 /**
  * @brief VNoteRecordBar::onClosePlayWidget
  * @param voiceData
@@ -190,6 +240,18 @@ void VNoteRecordBar::playVoice(VNVoiceBlock *voiceData, bool bIsSame)
     m_playPanel->playVoice(voiceData, bIsSame);
 }
 
+/**
+ * @brief VNoteRecordBar::playVoices
+ * @param voices 播放队列
+ * @param index 开始播放的语音
+ */
+void VNoteRecordBar::playVoices(const QList<QSharedPointer<VNVoiceBlock>> &voices, int index)
+{
+    setFocus();
+    m_mainLayout->setCurrentWidget(m_playPanel);
+    m_playPanel->playVoices(voices, index);
+}
+
 /**
  * @brief VNoteRecordBar::onAudioVolumeChange
  * @param mode
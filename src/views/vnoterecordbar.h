@@ -6,10 +6,13 @@
 #ifndef VNOTERECORDBAR_H
 #define VNOTERECORDBAR_H
 
+#include "common/datatypedef.h"
+
 #include <DFloatingMessage>
 
 #include <QWidget>
 #include <QStackedLayout>
+#include <QSharedPointer>
 
 DWIDGET_USE_NAMESPACE
 class AudioWatcher;
@@ -25,12 +28,16 @@ public:
     explicit VNoteRecordBar(QWidget *parent = nullptr);
     //停止录音
     void stopRecord();
+    //上一次录音的语音段
+    VNOTE_SPEECH_SEGMENTS speechSegments() const;
     /**
      * @brief 播放语音
      * @param voiceData :语音信息
      * @param bIsSame :此次播放的语音是否与上一次操作的语音相同
      */
     void playVoice(VNVoiceBlock *voiceData, bool bIsSame);
+    //从index开始连续播放语音
+    void playVoices(const QList<QSharedPointer<VNVoiceBlock>> &voices, int index);
     //停止播放
     void stopPlay();
 
@@ -45,11 +52,17 @@ private:
     void initConnections();
     //判断录音音量是否过低
     bool volumeToolow(const double &volume);
+    //鼠标移到录音按钮上时创建流水线，不打开录音设备
+    void warmUpRecord();
+    //按下录音按钮时预录，松开开始录音时补上按下期间的数据
+    void prepareRecord();
 
 signals:
     //录音信号
     void sigStartRecord(const QString &recordPath);
     void sigFinshRecord(const QString &voicePath, qint64 voiceSize);
+    //录音保存失败，recoverable为true时下次启动恢复
+    void sigRecordFailed(const QString &voicePath, bool recoverable);
     //播放信号
     void sigPlayVoice(VNVoiceBlock *voiceData);
     void sigPauseVoice(VNVoiceBlock *voiceData);
@@ -63,6 +76,8 @@ public slots:
     void onStartRecord();
     //结束录音
     void onFinshRecord(const QString &voicePath, qint64 voiceSize);
+    //录音保存失败
+    void onRecordFailed(const QString &voicePath, bool recoverable);
     //播放窗口关闭
     void onClosePlayWidget(VNVoiceBlock *voiceData);
     //设备音量改变
@@ -9,9 +9,18 @@
 #include "common/vnoteitem.h"
 #include "common/metadataparser.h"
 #include "common/vtextspeechandtrmanager.h"
+#include "common/vnotesearchindex.h"
+#include "common/vnotedatamanager.h"
+#include "common/vnotejournal.h"
+#include "common/vnoterecordsession.h"
+#include "common/vnoteautosavescheduler.h"
+#include "common/vnotethumbnailhandler.h"
 #include "dialog/imageviewerdialog.h"
 #include "common/setting.h"
+#include "common/performancemonitor.h"
+#include "common/vlcpalyer.h"
 #include "task/exportnoteworker.h"
+#include "task/recordrecoverworker.h"
 #include "dialog/vnotemessagedialog.h"
 
 #include "db/vnoteitemoper.h"
@@ -23,11 +32,19 @@
 #include <QMimeData>
 #include <QDragEnterEvent>
 #include <QWebEngineContextMenuData>
+#include <QWebEngineProfile>
 #include <QApplication>
 #include <QStandardPaths>
 #include <QThreadPool>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 static const char webPage[] = WEB_PATH "/index.html";
+//编辑日志达到该条数后合并写入数据库
+static const int journalCompactCount = 30;
+//切换笔记时获取之前笔记内容失败的重试次数
+static const int switchRetryCount = 2;
 
 WebRichTextEditor::WebRichTextEditor(QWidget *parent)
     : QWebEngineView(parent)
@@ -57,8 +74,16 @@ void WebRichTextEditor::initWebView()
     JsContent *content = JsContent::instance();
     channel->registerObject("webobj", content);
     page()->setWebChannel(channel);
+    //图片按显示尺寸从缩略图协议加载
+    page()->profile()->installUrlSchemeHandler(VNoteThumbnailHandler::scheme, new VNoteThumbnailHandler(this));
     QFileInfo info(webPage);
     //printf("%s \n", webPage);
+    PerformanceMonitor::webPageLoadStart();
+    connect(this, &QWebEngineView::loadFinished, this, [=](bool ok) {
+        if (ok) {
+            PerformanceMonitor::webPageLoadFinish();
+        }
+    });
     load(QUrl::fromLocalFile(info.absoluteFilePath()));
     page()->setBackgroundColor(DGuiApplicationHelper::instance()->applicationPalette().base().color());
 
@@ -73,6 +98,8 @@ void WebRichTextEditor::initWebView()
             this, &WebRichTextEditor::onThemeChanged);
 
     connect(content, &JsContent::getfontinfo, this, &WebRichTextEditor::onSetFontListInfo);
+    connect(content, &JsContent::searchFinish, this, &WebRichTextEditor::onSearchFinish);
+    connect(content, &JsContent::poolPageChanged, this, &WebRichTextEditor::onPoolPageChanged);
 
     if (nullptr != focusProxy()) {
         focusProxy()->installEventFilter(this);
@@ -156,9 +183,11 @@ void WebRichTextEditor::initRightMenu()
 
 void WebRichTextEditor::initUpdateTimer()
 {
-    m_updateTimer = new QTimer(this);
-    m_updateTimer->setInterval(1000);
-    connect(m_updateTimer, &QTimer::timeout, this, &WebRichTextEditor::updateNote);
+    //停止输入后保存，连续输入时限制最长未保存时间
+    m_autosave = new VNoteAutosaveScheduler(this);
+    connect(m_autosave, &VNoteAutosaveScheduler::saveRequested, this, [this] {
+        updateNote();
+    });
 }
 
 void WebRichTextEditor::initData(VNoteItem *data, const QString &reg, bool focus)
@@ -172,66 +201,321 @@ void WebRichTextEditor::initData(VNoteItem *data, const QString &reg, bool focus
     });
 }
 
-void WebRichTextEditor::insertVoiceItem(const QString &voicePath, qint64 voiceSize)
+void WebRichTextEditor::insertVoiceItem(const QString &voicePath, qint64 voiceSize,
+                                        const VNOTE_SPEECH_SEGMENTS &speechSegments)
+{
+    QString value = makeVoiceData(voicePath, voiceSize, QDateTime::currentDateTime(), speechSegments);
+    this->setFocus();
+    //关闭应用时，需要同步插入语音并进行后台更新
+    if (OpsStateInterface::instance()->isAppQuit()) {
+        JsContent::instance()->callJsSynchronous(page(), QString("insertVoiceItem('%1')").arg(value));
+        m_textChange = true;
+        update();
+        return;
+    }
+    emit JsContent::instance()->callJsInsertVoice(value);
+}
+
+QString WebRichTextEditor::makeVoiceData(const QString &voicePath, qint64 voiceSize, const QDateTime &createTime,
+                                         const VNOTE_SPEECH_SEGMENTS &speechSegments)
 {
     VNVoiceBlock data;
     data.ptrVoice->voiceSize = voiceSize;
     data.ptrVoice->voicePath = voicePath;
-    data.ptrVoice->createTime = QDateTime::currentDateTime();
+    data.ptrVoice->createTime = createTime;
+    data.ptrVoice->speechSegments = speechSegments;
     data.ptrVoice->voiceTitle = data.ptrVoice->createTime.toString("yyyyMMdd hh.mm.ss");
 
     MetaDataParser parse;
     QVariant value;
     parse.makeMetaData(&data, value);
-    this->setFocus();
-    //关闭应用时，需要同步插入语音并进行后台更新
-    if (OpsStateInterface::instance()->isAppQuit()) {
-        JsContent::instance()->callJsSynchronous(page(), QString("insertVoiceItem('%1')").arg(value.toString()));
-        m_textChange = true;
-        update();
+    return value.toString();
+}
+
+void WebRichTextEditor::insertRecoveredVoices()
+{
+    qint32 noteId = m_noteData->noteId;
+    if (m_recoveringNotes.contains(noteId) || !VNoteRecordSession::hasRecovered(noteId)) {
         return;
     }
-    emit JsContent::instance()->callJsInsertVoice(value.toString());
+
+    m_recoveringNotes.insert(noteId);
+    RecordRecoverWorker *worker = new RecordRecoverWorker(noteId);
+    worker->setAutoDelete(true);
+    worker->setObjectName("RecordRecoverWorker");
+    connect(worker, &RecordRecoverWorker::voiceRecovered, this, &WebRichTextEditor::onVoiceRecovered, Qt::QueuedConnection);
+    connect(worker, &RecordRecoverWorker::recoverFinished, this, [this](qint32 id) {
+        m_recoveringNotes.remove(id);
+    }, Qt::QueuedConnection);
+    QThreadPool::globalInstance()->start(worker);
 }
 
-void WebRichTextEditor::updateNote()
+void WebRichTextEditor::onVoiceRecovered(qint32 noteId, const QString &outputPath, const QString &storedPath,
+                                         qint64 duration, const QDateTime &createTime)
 {
-    if (m_noteData) {
-        if (m_textChange) {
-            QVariant result = JsContent::instance()->callJsSynchronous(page(), QString("getHtml()"));
-            if (result.isValid()) {
-                m_noteData->htmlCode = result.toString();
-                VNoteItemOper noteOps(m_noteData);
-                if (!noteOps.updateNote()) {
-                    qInfo() << "Save note error";
-                }
-            }
+    //合并期间切换了笔记时保留会话，下次打开该笔记时再插入
+    if (nullptr == m_noteData || m_noteData->noteId != noteId) {
+        return;
+    }
+    emit JsContent::instance()->callJsAppendVoice(makeVoiceData(storedPath, duration, createTime));
+    VNoteRecordSession::discard(outputPath);
+}
+
+void WebRichTextEditor::prefetchVoices()
+{
+    QStringList paths;
+    MetaDataParser parse;
+    for (const QString &json : m_noteData->getVoiceJsons()) {
+        VNVoiceBlock voice;
+        if (parse.parse(json, &voice) && !voice.voicePath.isEmpty()) {
+            paths.append(voice.voicePath);
+        }
+        if (paths.size() >= VlcPalyer::MaxPrefetch) {
+            break;
+        }
+    }
+    if (!paths.isEmpty()) {
+        VlcPalyer::instance()->prefetch(paths);
+    }
+}
+
+void WebRichTextEditor::updateNote(const std::function<void()> &callback)
+{
+    if (callback) {
+        m_updateCallbacks.append(callback);
+    }
+    //已有未完成的请求，完成后统一回调
+    if (m_updatePending) {
+        return;
+    }
+
+    if (nullptr == m_noteData || !m_textChange) {
+        m_updateSucceeded = true;
+        runUpdateCallbacks();
+        return;
+    }
+
+    m_textChange = false;
+    m_updatePending = true;
+    m_autosave->cancel();
+    m_autosave->saveStarted();
+    //记录笔记id，结果返回时笔记可能已被删除或切换
+    qint32 noteId = m_noteData->noteId;
+    if (m_blockNoteId != noteId) {
+        //开始同步新的笔记，先合并之前笔记的日志
+        compactNote();
+        resetBlocks(noteId);
+    }
+    //只获取上次同步后变化的顶层块，版本号不一致时web端返回全量
+    JsContent::instance()->callJsAsync(page(), QString("getDelta(%1)").arg(m_blockVersion), [ = ](const QVariant & result) {
+        m_updatePending = false;
+        m_autosave->saveFinished();
+        m_updateSucceeded = applyNoteDelta(noteId, result);
+        if (!m_updateSucceeded && nullptr != m_noteData && m_noteData->noteId == noteId) {
+            //获取失败，稍后重试
+            m_textChange = true;
+        }
+        if (m_textChange && nullptr != m_noteData) {
+            //获取失败或获取期间又有修改，请求期间到达的定时保存已被忽略，需重新安排
+            m_autosave->markDirty();
+        }
+        runUpdateCallbacks();
+    });
+}
+
+void WebRichTextEditor::flushNote()
+{
+    m_autosave->cancel();
+    //先等待插入的图片处理完成，web端替换占位后再获取内容
+    bool imageInserted = JsContent::instance()->waitForImages();
+    if (nullptr != m_noteData && (m_textChange || m_updatePending || imageInserted)) {
+        //程序退出或系统休眠前事件循环可能无法继续执行，异步结果无法返回，需同步获取
+        QVariant result = JsContent::instance()->callJsSynchronous(page(), QString("getHtml()"));
+        if (result.isValid() && saveNoteHtml(m_noteData, result.toString())) {
             m_textChange = false;
+            VNoteJournal::instance()->remove(m_noteData->noteId);
+            if (m_blockNoteId == m_noteData->noteId) {
+                m_journalCount = 0;
+            }
         }
     }
+    //合并其余未写入数据库的日志
+    compactNote();
+    VNoteJournal::instance()->flushCompaction();
+    VNoteJournal::instance()->waitForDone();
+}
+
+void WebRichTextEditor::setVoiceText(qint32 noteId, const QString &voicePath, const QString &text)
+{
+    //当前笔记的内容以web端为准，插入后随编辑内容一起保存
+    if (nullptr != m_noteData && m_noteData->noteId == noteId) {
+        emit JsContent::instance()->callJsSetVoiceTextByPath(voicePath, text);
+        return;
+    }
+
+    VNoteItem *note = VNoteDataManager::instance()->findNote(noteId);
+    if (nullptr == note || !note->setVoiceText(voicePath, text)) {
+        return;
+    }
+    //内容版本改变，web端缓存的旧页面不会再使用
+    if (VNoteItemOper::updateNotes(QList<VNoteItem *>() << note)) {
+        VNoteSearchIndex::instance()->scheduleNote(note);
+    } else {
+        qWarning() << __FUNCTION__ << "save voice text failed:" << noteId;
+    }
+}
+
+bool WebRichTextEditor::applyNoteDelta(qint32 noteId, const QVariant &result)
+{
+    VNoteItem *note = VNoteDataManager::instance()->findNote(noteId);
+    QJsonObject delta = QJsonDocument::fromJson(result.toString().toUtf8()).object();
+    if (nullptr == note || noteId != m_blockNoteId || delta.isEmpty()) {
+        return false;
+    }
+
+    bool reset = delta.value("reset").toBool();
+    if ((!reset && delta.value("version").toInt() != m_blockVersion + 1)
+            || !VNoteJournal::applyDelta(m_blocks, delta)) {
+        //与web端不一致，下次获取全量
+        m_blockVersion = -1;
+        return false;
+    }
+    m_blockVersion = delta.value("version").toInt();
+
+    //内容没有变化
+    if (!reset && 0 == delta.value("remove").toInt() && delta.value("blocks").toArray().isEmpty()) {
+        return true;
+    }
+
+    note->htmlCode = m_blocks.join("");
+    //日志为空时写入全量内容，作为恢复的基础
+    if (!VNoteJournal::instance()->hasJournal(noteId)) {
+        delta.insert("reset", true);
+        delta.insert("blocks", QJsonArray::fromStringList(m_blocks));
+    }
+    VNoteJournal::instance()->append(noteId, delta);
+    VNoteDataManager::instance()->increaseDataVersion();
+
+    if (++m_journalCount >= journalCompactCount) {
+        compactNote();
+    } else {
+        //更新附件搜索索引
+        VNoteSearchIndex::instance()->scheduleNote(note, VNoteSearchIndex::High);
+    }
+    return true;
+}
+
+void WebRichTextEditor::compactNote()
+{
+    if (m_journalCount <= 0) {
+        return;
+    }
+    //笔记内容已在内存中更新，由日志合并写入数据库，多个笔记合并为一次事务
+    VNoteJournal::instance()->compact(m_blockNoteId);
+    m_journalCount = 0;
+}
+
+void WebRichTextEditor::resetBlocks(qint32 noteId)
+{
+    m_blocks.clear();
+    m_blockVersion = -1;
+    m_blockNoteId = noteId;
+    m_journalCount = 0;
+}
+
+bool WebRichTextEditor::saveNoteHtml(VNoteItem *note, const QString &html)
+{
+    if (nullptr == note) {
+        return false;
+    }
+    note->htmlCode = html;
+    VNoteItemOper noteOps(note);
+    if (!noteOps.updateNote()) {
+        qInfo() << "Save note error";
+        return false;
+    }
+    //更新附件搜索索引
+    VNoteSearchIndex::instance()->scheduleNote(note, VNoteSearchIndex::High);
+    return true;
+}
+
+void WebRichTextEditor::runUpdateCallbacks()
+{
+    QList<std::function<void()>> callbacks;
+    callbacks.swap(m_updateCallbacks);
+    for (auto &callback : callbacks) {
+        callback();
+    }
 }
 
 void WebRichTextEditor::searchText(const QString &searchKey)
 {
-    findText(searchKey, QWebEnginePage::FindFlags(), [ = ](const bool & result) {
-        if (result == false) {
+    //先同步编辑内容，由笔记数据判断是否仍包含关键字（包括标题及附件文本）
+    updateNote([ = ] {
+        if (nullptr == m_noteData || !m_noteData->search(searchKey))
+        {
             emit currentSearchEmpty();
+            return;
+        }
+
+        //关键字已高亮时只定位到下一个，不重新查找
+        if (searchKey == m_highlightKey && m_searchHitCount > 0)
+        {
+            emit JsContent::instance()->callJsSearchNext(true);
+        } else {
+            highlightSearchText(searchKey);
         }
     });
 }
 
+void WebRichTextEditor::highlightSearchText(const QString &key)
+{
+    m_highlightKey = key;
+    m_searchHitCount = 0;
+    if (key.isEmpty()) {
+        emit JsContent::instance()->callJsClearSearch();
+    } else {
+        emit JsContent::instance()->callJsSearchText(key);
+    }
+}
+
+void WebRichTextEditor::onSearchFinish(int count)
+{
+    m_searchHitCount = count;
+}
+
+void WebRichTextEditor::onPoolPageChanged(int noteId, const QString &html)
+{
+    //当前笔记的内容以web端为准，随编辑内容一起保存
+    if (nullptr != m_noteData && m_noteData->noteId == noteId) {
+        return;
+    }
+    VNoteItem *note = VNoteDataManager::instance()->findNote(noteId);
+    if (nullptr != note && !saveNoteHtml(note, html)) {
+        qWarning() << __FUNCTION__ << "save pooled note failed:" << noteId;
+    }
+}
+
 void WebRichTextEditor::unboundCurrentNoteData()
 {
-    //停止更新定时器
-    m_updateTimer->stop();
-    //手动更新
-    updateNote();
+    //取消未完成的笔记切换
+    m_switchNote = nullptr;
+    //取消待执行的自动保存
+    m_autosave->cancel();
+    //手动更新，并将日志立即合并写入数据库
+    updateNote([this] {
+        compactNote();
+        VNoteJournal::instance()->flushCompaction();
+    });
     //绑定数据设置为空
     m_noteData = nullptr;
 }
 
 void WebRichTextEditor::onTextChange()
 {
+    //内容变化后高亮位置可能失效，下次搜索重新高亮
+    m_highlightKey.clear();
+    m_autosave->markDirty();
     if (!m_textChange) {
         m_textChange = true;
         //更新修改时间
@@ -259,7 +543,11 @@ void WebRichTextEditor::onSetDataFinsh()
     }
     //只有编辑区内容加载完成才能搜索
     if (!m_searchKey.isEmpty()) {
-        findText(m_searchKey);
+        highlightSearchText(m_searchKey);
+    }
+    if (nullptr != m_noteData) {
+        insertRecoveredVoices();
+        prefetchVoices();
     }
 }
 
@@ -350,6 +638,8 @@ void WebRichTextEditor::showVoiceMenu(const QPoint &pos)
 
     //如果当前有语音处于转换状态就将语音转文字选项置灰
     ActionManager::Instance()->enableAction(ActionManager::VoiceToText, !OpsStateInterface::instance()->isVoice2Text());
+    //录音时不能播放
+    ActionManager::Instance()->enableAction(ActionManager::VoicePlayAll, !OpsStateInterface::instance()->isRecording());
     m_voiceRightMenu->popup(pos);
 }
 
@@ -365,6 +655,25 @@ void WebRichTextEditor::onMenuActionClicked(QAction *action)
         //通知主窗口进行转写服务
         emit asrStart(m_voiceBlock.get());
         break;
+    case ActionManager::VoicePlayAll: {
+        //同步编辑区内容后按笔记中的顺序取出所有语音
+        QString voicePath = m_voiceBlock->voicePath;
+        updateNote([this, voicePath] {
+            if (nullptr == m_noteData) {
+                return;
+            }
+            QStringList jsons = m_noteData->getVoiceJsons();
+            MetaDataParser dataParser;
+            for (int i = 0; i < jsons.size(); i++) {
+                VNVoiceBlock voice;
+                if (dataParser.parse(jsons.at(i), &voice) && voice.voicePath == voicePath) {
+                    emit playAllVoices(jsons, i);
+                    break;
+                }
+            }
+        });
+        break;
+    }
     case ActionManager::VoiceDelete:
     case ActionManager::PictureDelete:
     case ActionManager::TxtDelete:
@@ -393,8 +702,10 @@ void WebRichTextEditor::onMenuActionClicked(QAction *action)
     case ActionManager::VoicePaste:
     case ActionManager::PicturePaste:
     case ActionManager::TxtPaste:
-        //粘贴事件，从剪贴板获取数据
-        onPaste(isVoicePaste());
+        //粘贴事件，从剪贴板获取数据，异步获取是否为语音粘贴
+        JsContent::instance()->callJsAsync(page(), "returnCopyFlag()", [ = ](const QVariant & result) {
+            onPaste(result.toBool());
+        });
         break;
     case ActionManager::PictureView:
         //查看图片
@@ -674,6 +985,7 @@ void WebRichTextEditor::onHideEditToolbar()
  */
 void WebRichTextEditor::onLoadFinsh()
 {
+    PerformanceMonitor::webEditorReady();
     //再次设置笔记内容
     if (m_noteData && !m_loadFinshSign) {
         if (m_noteData->htmlCode.isEmpty()) {
@@ -701,36 +1013,110 @@ void WebRichTextEditor::setData(VNoteItem *data, const QString &reg)
         return;
     }
     this->setVisible(true);
-    //清除选中需重新加载，解决匹配字符显示灰色问题
-    bool reSet = !m_searchKey.isEmpty() && reg.isEmpty();
     m_searchKey = reg;
-    if (m_noteData != data || reSet) { //笔记切换或清除搜索结果时设置笔记内容
-        m_updateTimer->stop();
-        updateNote();
+    if (m_noteData != data) { //笔记切换时设置笔记内容，加载完成后再高亮
+        switchNote(data, switchRetryCount);
+    } else {
+        //重新选中当前笔记时取消未完成的切换
+        m_switchNote = nullptr;
+        if (reg != m_highlightKey) { //笔记相同时只更新高亮，清除搜索时去除高亮
+            highlightSearchText(reg);
+        }
+        sendPreloadNotes();
+    }
+}
+
+void WebRichTextEditor::switchNote(VNoteItem *data, int retry)
+{
+    m_switchNote = data;
+    //之前笔记的内容取回后再设置新内容，保证取到的是之前笔记的内容
+    updateNote([ = ] {
+        if (m_switchNote != data) {
+            //已切换到其他笔记或已解绑
+            return;
+        }
+        if (!m_updateSucceeded && retry > 0 && nullptr != m_noteData) {
+            //获取失败时web端仍是之前的笔记，重新获取后再切换，避免之前笔记的修改丢失
+            switchNote(data, retry - 1);
+            return;
+        }
+        m_switchNote = nullptr;
+        qint32 oldId = (nullptr != m_noteData) ? m_noteData->noteId : -1;
         m_noteData = data;
-        if (m_loadFinshSign) {
-            if (data->htmlCode.isEmpty()) {
-                emit JsContent::instance()->callJsInitData(data->metaDataRef().toString());
-            } else {
-                emit JsContent::instance()->callJsSetHtml(data->htmlCode);
-            }
+        m_highlightKey.clear();
+        //之前笔记的日志立即合并写入数据库，只有日志条数达到上限时才延后合并
+        compactNote();
+        VNoteJournal::instance()->flushCompaction();
+        showNote(oldId);
+    });
+}
+
+void WebRichTextEditor::showNote(qint32 oldId)
+{
+    if (!m_loadFinshSign || nullptr == m_noteData) {
+        return;
+    }
+
+    if (m_noteData->htmlCode.isEmpty()) {
+        emit JsContent::instance()->callJsInitData(m_noteData->metaDataRef().toString());
+    } else {
+        //之前笔记的内容已同步时才放入web端缓存，保证缓存与笔记数据一致
+        VNoteItem *oldNote = (oldId >= 0 && m_updateSucceeded) ? VNoteDataManager::instance()->findNote(oldId) : nullptr;
+        QString oldRev;
+        if (nullptr == oldNote || oldNote->htmlCode.isEmpty()) {
+            oldId = -1;
+        } else {
+            oldRev = pageRevision(oldNote);
+            m_preloadRevs.insert(oldId, oldRev);
         }
-        m_updateTimer->start();
-    } else { //笔记相同时执行搜索
-        findText(reg);
+        emit JsContent::instance()->callJsSwitchNote(oldId, oldRev, m_noteData->noteId,
+                                                     pageRevision(m_noteData), m_noteData->htmlCode);
     }
+    sendPreloadNotes();
 }
 
-bool WebRichTextEditor::isVoicePaste()
+void WebRichTextEditor::setPreloadNotes(const QList<qint32> &noteIds)
 {
-    //调用web前端接口
-    return JsContent::instance()->callJsSynchronous(page(), "returnCopyFlag()").toBool();
+    m_preloadIds = noteIds;
+}
+
+void WebRichTextEditor::sendPreloadNotes()
+{
+    if (!m_loadFinshSign) {
+        return;
+    }
+
+    //web端按版本去重，这里只过滤上次已发送的笔记，减少传输
+    QHash<qint32, QString> revs;
+    for (qint32 noteId : m_preloadIds) {
+        VNoteItem *note = VNoteDataManager::instance()->findNote(noteId);
+        if (nullptr == note || note == m_noteData || note->htmlCode.isEmpty()) {
+            continue;
+        }
+        QString rev = pageRevision(note);
+        if (m_preloadRevs.value(noteId) != rev) {
+            emit JsContent::instance()->callJsPreloadNote(noteId, rev, note->htmlCode);
+        }
+        revs.insert(noteId, rev);
+    }
+    m_preloadRevs = revs;
+}
+
+QString WebRichTextEditor::pageRevision(const VNoteItem *note)
+{
+    return QString("%1-%2").arg(note->htmlCode.size()).arg(qHash(note->htmlCode));
 }
 
 void WebRichTextEditor::shortcutPopupMenu()
 {
-    //同步获取菜单类型与参数
-    QMap<QString, QVariant> param = JsContent::instance()->callJsSynchronous(page(), "isRangeVoice()").toMap();
+    //异步获取菜单类型与参数
+    JsContent::instance()->callJsAsync(page(), "isRangeVoice()", [ = ](const QVariant & result) {
+        showShortcutPopupMenu(result.toMap());
+    });
+}
+
+void WebRichTextEditor::showShortcutPopupMenu(const QMap<QString, QVariant> &param)
+{
     if (2 == param.size()) {
         m_menuType = static_cast<Menu>(param["flag"].toInt());
         m_menuJson = param["info"];
@@ -753,14 +1139,8 @@ void WebRichTextEditor::shortcutPopupMenu()
 void WebRichTextEditor::clearJSContent()
 {
     if (this->isVisible()) {
-        connect(JsContent::instance(), &JsContent::setDataFinsh, this, &WebRichTextEditor::onSetDataFinsh);
+        //页面内容异步清空，不再开启局部事件循环等待刷新
         emit JsContent::instance()->callJsSetHtml("");
-
-        // 开启100ms事件循环，保证js页面内容被刷新
-        QEventLoop eveLoop;
-        QTimer::singleShot(100, &eveLoop, SLOT(quit()));
-        eveLoop.exec();
-        disconnect(JsContent::instance(), &JsContent::setDataFinsh, this, &WebRichTextEditor::onSetDataFinsh);
     }
 }
 
@@ -15,6 +15,8 @@
 #include <QtDBus>
 #include <QDBusInterface>
 
+#include <functional>
+
 //获取字号接口
 #ifdef OS_BUILD_V23
 #define DEEPIN_DAEMON_APPEARANCE_SERVICE          "org.deepin.dde.Appearance1"
@@ -29,6 +31,7 @@
 struct VNoteItem;
 class VNoteRightMenu;
 class ImageViewerDialog;
+class VNoteAutosaveScheduler;
 class WebRichTextEditor : public QWebEngineView
 {
     Q_OBJECT
@@ -54,12 +57,31 @@ public:
      * @brief 插入语音
      * @param voicePath：语音路径
      * @param voiceSize: 语音时长，单位毫秒
+     * @param speechSegments: 录音时检测的语音段
+     */
+    void insertVoiceItem(const QString &voicePath, qint64 voiceSize,
+                         const VNOTE_SPEECH_SEGMENTS &speechSegments = VNOTE_SPEECH_SEGMENTS());
+    /**
+     * @brief 更新编辑区内容，异步获取web前端内容后保存
+     * @param callback 保存完成（或无需保存）后的回调
+     */
+    void updateNote(const std::function<void()> &callback = nullptr);
+    /**
+     * @brief 同步保存编辑区内容并写入数据库，用于程序退出、系统休眠
+     */
+    void flushNote();
+    /**
+     * @brief 设置语音的转写文本，笔记在编辑区显示时由web端插入
+     * @param noteId 语音所属笔记
+     * @param voicePath 语音文件路径
+     * @param text 转写文本
      */
-    void insertVoiceItem(const QString &voicePath, qint64 voiceSize);
+    void setVoiceText(qint32 noteId, const QString &voicePath, const QString &text);
     /**
-     * @brief 更新编辑区内容
+     * @brief 设置需要预加载的笔记，笔记切换完成后在web端后台生成内容
+     * @param noteIds 笔记id，一般为笔记列表中相邻的笔记
      */
-    void updateNote();
+    void setPreloadNotes(const QList<qint32> &noteIds);
     /**
      * @brief 搜索当前笔记
      * @param searchKey : 搜索关键字
@@ -87,6 +109,13 @@ signals:
      */
     void asrStart(const VNVoiceBlock *voiceBlock);
 
+    /**
+     * @brief 从指定语音开始连续播放笔记中的语音
+     * @param jsons 笔记中所有语音的json数据
+     * @param index 开始播放的语音
+     */
+    void playAllVoices(const QStringList &jsons, int index);
+
     /**
      * @brief 当前编辑区搜索内容为空
      */
@@ -157,6 +186,28 @@ public slots:
      */
     void onSetFontListInfo();
 
+    /**
+     * @brief web前端搜索高亮完成
+     * @param count 匹配数量
+     */
+    void onSearchFinish(int count);
+    /**
+     * @brief 保存页面缓存池中变化的笔记
+     * @param noteId 笔记id
+     * @param html 笔记内容
+     */
+    void onPoolPageChanged(int noteId, const QString &html);
+    /**
+     * @brief 异常退出遗留的录音合并完成，插入到仍在显示的笔记末尾
+     * @param noteId 所属笔记
+     * @param outputPath 录音会话的输出路径
+     * @param storedPath 录音文件路径
+     * @param duration 录音时长，单位毫秒
+     * @param createTime 录音时间
+     */
+    void onVoiceRecovered(qint32 noteId, const QString &outputPath, const QString &storedPath,
+                          qint64 duration, const QDateTime &createTime);
+
 protected:
     void contextMenuEvent(QContextMenuEvent *e) override;
     //拖拽事件
@@ -172,9 +223,26 @@ private:
      * @brief 初始化字体列表信息
      */
     void initFontsInformation();
+    /**
+     * @brief 生成语音块的json数据
+     * @param voicePath：语音路径
+     * @param voiceSize: 语音时长，单位毫秒
+     * @param createTime: 录音时间
+     * @param speechSegments: 语音段
+     */
+    QString makeVoiceData(const QString &voicePath, qint64 voiceSize, const QDateTime &createTime,
+                          const VNOTE_SPEECH_SEGMENTS &speechSegments = VNOTE_SPEECH_SEGMENTS());
+    /**
+     * @brief 在后台合并异常退出时遗留的录音，完成后插入笔记末尾
+     */
+    void insertRecoveredVoices();
+    /**
+     * @brief 预先解析笔记中的语音，点击播放时不需要再打开文件
+     */
+    void prefetchVoices();
 
     /**
-     * @brief 初始化数据更新定时器
+     * @brief 初始化自动保存调度
      */
     void initUpdateTimer();
     /**
@@ -218,16 +286,83 @@ private:
     void setData(VNoteItem *data, const QString &reg);
 
     /**
-     * @brief 判断是否为语音粘贴
-     * @return
+     * @brief 保存笔记内容到数据库
+     * @param note 笔记数据
+     * @param html 笔记内容
+     * @return 保存成功返回true
+     */
+    bool saveNoteHtml(VNoteItem *note, const QString &html);
+    /**
+     * @brief 应用web端返回的增量，更新笔记内容并追加编辑日志
+     * @param noteId 请求时的笔记id
+     * @param result web端返回的增量json
+     * @return 应用成功返回true
+     */
+    bool applyNoteDelta(qint32 noteId, const QVariant &result);
+    /**
+     * @brief 请求将已同步的内容合并写入数据库，写入后删除编辑日志
+     */
+    void compactNote();
+    /**
+     * @brief 重置已同步的顶层块
+     * @param noteId 开始同步的笔记id
+     */
+    void resetBlocks(qint32 noteId);
+    /**
+     * @brief 执行保存完成后的回调
+     */
+    void runUpdateCallbacks();
+    /**
+     * @brief 根据web前端返回的参数显示快捷键菜单
+     * @param param 菜单类型与参数
+     */
+    void showShortcutPopupMenu(const QMap<QString, QVariant> &param);
+
+    /**
+     * @brief 取回之前笔记的内容后切换到新笔记，获取失败时先重试
+     * @param data 新笔记
+     * @param retry 剩余重试次数，用完后不再等待直接切换
+     */
+    void switchNote(VNoteItem *data, int retry);
+    /**
+     * @brief 在web端显示笔记内容
+     * @param oldId 切换前的笔记id，为-1时不缓存当前内容
+     */
+    void showNote(qint32 oldId);
+    /**
+     * @brief 发送预加载的笔记
+     */
+    void sendPreloadNotes();
+    /**
+     * @brief 笔记内容版本，用于校验web端缓存的内容是否过期
+     * @param note 笔记数据
+     * @return 版本字符串
+     */
+    static QString pageRevision(const VNoteItem *note);
+    /**
+     * @brief 在web前端高亮关键字，不重新设置编辑区内容
+     * @param key 搜索关键字，为空时清除高亮
      */
-    bool isVoicePaste();
+    void highlightSearchText(const QString &key);
 
 private:
     VNoteItem *m_noteData {nullptr};
-    QTimer *m_updateTimer {nullptr};
+    VNoteItem *m_switchNote {nullptr}; //等待切换到的笔记
+    VNoteAutosaveScheduler *m_autosave {nullptr}; //自动保存调度
     bool m_textChange {false};
+    bool m_updatePending {false}; //是否有未返回的内容获取请求
+    bool m_updateSucceeded {true}; //最近一次内容获取是否成功
+    QList<std::function<void()>> m_updateCallbacks; //保存完成后的回调
+    QStringList m_blocks; //已同步的编辑区顶层块，拼接后为笔记内容
+    int m_blockVersion {-1}; //已同步的版本号，-1时web端返回全量
+    qint32 m_blockNoteId {-1}; //已同步块所属的笔记id
+    int m_journalCount {0}; //未合并到数据库的日志条数
+    QList<qint32> m_preloadIds; //待预加载的笔记
+    QSet<qint32> m_recoveringNotes; //正在合并遗留录音的笔记
+    QHash<qint32, QString> m_preloadRevs; //上次预加载的笔记内容版本
     QString m_searchKey {""};
+    QString m_highlightKey {""}; //编辑区已高亮的关键字
+    int m_searchHitCount {0}; //编辑区高亮数量
     Menu m_menuType = MaxMenu;
     QVariant m_menuJson = {};
     ImageViewerDialog *imgView {nullptr}; //
@@ -5,16 +5,29 @@
 
 #include "vnoteplaywidget.h"
 #include "vnote2siconbutton.h"
+#include "vnvoicewaveform.h"
 #include "common/vnoteitem.h"
 #include "common/utils.h"
+#include "common/vnotevoiceactivity.h"
+#include "common/setting.h"
+#include "globaldef.h"
 
 #include <DDialogCloseButton>
 #include <DFontSizeManager>
 #include <DFloatingWidget>
 #include <DBlurEffectWidget>
 #include <QGridLayout>
+#include <QActionGroup>
 #include <QDebug>
 
+#ifdef MPV_PLAYENGINE
+static const qint64 engineUnit = 1000; //播放位置单位为秒
+#else
+static const qint64 engineUnit = 1; //播放位置单位为毫秒
+#endif
+static const int queuePrefetch = 2; //连续播放时预先解析的后续语音数
+static const double playSpeeds[] = {1.0, 1.25, 1.5, 2.0, 2.5, 3.0}; //可选的播放倍速
+
 /**
  * @brief VNotePlayWidget::VNotePlayWidget
  * @param parent
@@ -25,6 +38,7 @@ VNotePlayWidget::VNotePlayWidget(QWidget *parent)
     //setFixedHeight(76);
     initUI();
     initPlayer();
+    initSpeedMenu();
     initConnection();
 }
 
@@ -47,7 +61,7 @@ void VNotePlayWidget::initUI()
     m_timeLab->setText("00:00/00:00");
     m_timeLab->setFixedHeight(15);
 
-    m_sliderHover = new DFrame(this);
+    m_sliderHover = new VNVoiceWaveform(this);
     DPalette pa = DApplicationHelper::instance()->palette(m_sliderHover);
     QColor splitColor(0,0,0,13);
     pa.setColor(DPalette::Base, splitColor);
@@ -70,6 +84,13 @@ void VNotePlayWidget::initUI()
     t_blurAreaLayout->addWidget(m_slider, 0, Qt::AlignVCenter);
     m_sliderHover->setLayout(t_blurAreaLayout);
 
+    m_speedBtn = new DPushButton(this);
+    QFont speedBtnFont;
+    speedBtnFont.setPixelSize(12);
+    m_speedBtn->setFont(speedBtnFont);
+    m_speedBtn->setFixedSize(QSize(48, 24));
+    m_speedBtn->setFlat(true);
+
     m_closeBtn = new DIconButton(this);
     m_closeBtn->setIcon(Utils::loadSVG("clear.svg", true));
     m_closeBtn->setIconSize(QSize(22, 22));
@@ -95,6 +116,7 @@ void VNotePlayWidget::initUI()
     mainLayout->setSpacing(20);
     mainLayout->addWidget(m_playerBtn, 0, Qt::AlignVCenter);
     mainLayout->addLayout(sliderLayout);
+    mainLayout->addWidget(m_speedBtn, 0, Qt::AlignVCenter);
     mainLayout->addWidget(m_closeBtn, 0, Qt::AlignVCenter);
     this->setLayout(mainLayout);
     m_sliderHover->installEventFilter(this);
@@ -106,7 +128,35 @@ void VNotePlayWidget::initUI()
  */
 void VNotePlayWidget::initPlayer()
 {
-    m_player = new VlcPalyer(this);
+    //播放引擎全局共用，切换语音时不重新创建
+    m_player = VlcPalyer::instance();
+}
+
+/**
+ * @brief VNotePlayWidget::initSpeedMenu
+ */
+void VNotePlayWidget::initSpeedMenu()
+{
+    m_speedMenu = new DMenu(this);
+    QActionGroup *speedGroup = new QActionGroup(m_speedMenu);
+    double speed = setting::instance()->getOption(VNOTE_PLAY_SPEED).toDouble();
+    QAction *checkedAction = nullptr;
+    for (double value : playSpeeds) {
+        QAction *action = m_speedMenu->addAction(QString("%1x").arg(value));
+        action->setCheckable(true);
+        action->setData(value);
+        speedGroup->addAction(action);
+        if (qFuzzyCompare(value, speed)) {
+            checkedAction = action;
+        }
+    }
+    //配置中的倍速无效时使用正常速度
+    if (nullptr == checkedAction) {
+        checkedAction = speedGroup->actions().first();
+    }
+    checkedAction->setChecked(true);
+    m_speedBtn->setText(checkedAction->text());
+    m_player->setRate(checkedAction->data().toDouble());
 }
 
 /**
@@ -119,7 +169,7 @@ void VNotePlayWidget::initConnection()
     connect(m_player, &VlcPalyer::durationChanged,
             this, &VNotePlayWidget::onDurationChanged, Qt::QueuedConnection);
     connect(m_player, &VlcPalyer::playEnd,
-            this, &VNotePlayWidget::onCloseBtnClicked, Qt::QueuedConnection);
+            this, &VNotePlayWidget::onPlayEnd, Qt::QueuedConnection);
 
     connect(m_playerBtn, &DIconButton::clicked,
             this, &VNotePlayWidget::onPlayerBtnClicked);
@@ -127,6 +177,14 @@ void VNotePlayWidget::initConnection()
     connect(m_closeBtn, &DIconButton::clicked,
             this, &VNotePlayWidget::onCloseBtnClicked);
 
+    connect(m_speedBtn, &DPushButton::clicked, this, [this] {
+        //菜单显示在按钮上方
+        QPoint pos = m_speedBtn->mapToGlobal(QPoint(0, 0));
+        m_speedMenu->exec(QPoint(pos.x(), pos.y() - m_speedMenu->sizeHint().height()));
+    });
+    connect(m_speedMenu, &DMenu::triggered,
+            this, &VNotePlayWidget::onSpeedChanged);
+
     connect(m_slider, &DSlider::sliderPressed,
             this, &VNotePlayWidget::onSliderPressed);
     connect(m_slider, &DSlider::sliderReleased,
@@ -142,8 +200,33 @@ void VNotePlayWidget::initConnection()
 void VNotePlayWidget::onVoicePlayPosChange(qint64 pos)
 {
     if (m_sliderReleased == true) {
-        onSliderMove(static_cast<int>(pos));
+        onSliderMove(static_cast<int>(queueOffset() + pos));
+        skipSilence(pos);
+    }
+}
+
+/**
+ * @brief VNotePlayWidget::skipSilence
+ * 按录音时检测的语音段跳过较长的静音，没有语音段的录音不跳转
+ * @param pos 播放位置
+ */
+void VNotePlayWidget::skipSilence(qint64 pos)
+{
+    if (!m_skipSilence || nullptr == m_voiceBlock || m_player->getState() != VlcPalyer::Playing) {
+        return;
+    }
+#ifdef MPV_PLAYENGINE
+    //位置单位为秒，跳转后仍可能在同一秒内，避免重复跳转
+    qint64 target = VNoteVoiceActivity::skipSilence(m_voiceBlock->speechSegments, pos * 1000);
+    if (target / 1000 > pos) {
+        m_player->setPosition(target / 1000);
+    }
+#else
+    qint64 target = VNoteVoiceActivity::skipSilence(m_voiceBlock->speechSegments, pos);
+    if (target >= 0) {
+        m_player->setPosition(target);
     }
+#endif
 }
 
 /**
@@ -153,9 +236,43 @@ void VNotePlayWidget::onCloseBtnClicked()
 {
     qDebug() << "Click close button!";
     m_slider->setValue(0);
+    m_sliderHover->setProgress(0);
     m_player->stop();
     m_sliderReleased = true;
     emit sigWidgetClose(m_voiceBlock);
+    //队列中的语音随队列释放
+    if (!m_queue.isEmpty()) {
+        m_voiceBlock = nullptr;
+        clearQueue();
+    }
+}
+
+/**
+ * @brief VNotePlayWidget::onSpeedChanged
+ * 倍速对所有语音生效，下次启动继续使用
+ * @param action 选择的倍速
+ */
+void VNotePlayWidget::onSpeedChanged(QAction *action)
+{
+    double speed = action->data().toDouble();
+    m_player->setRate(speed);
+    m_speedBtn->setText(action->text());
+    setting::instance()->setOption(VNOTE_PLAY_SPEED, speed);
+}
+
+/**
+ * @brief VNotePlayWidget::onPlayEnd
+ */
+void VNotePlayWidget::onPlayEnd()
+{
+    //下一个语音已预先解析，不关闭播放窗口直接切换
+    if (!m_queue.isEmpty() && m_queueIndex + 1 < m_queue.size()) {
+        m_queueIndex++;
+        m_pendingSeek = -1;
+        startVoice(m_queue.at(m_queueIndex).get());
+        return;
+    }
+    onCloseBtnClicked();
 }
 
 /**
@@ -179,12 +296,64 @@ void VNotePlayWidget::onSliderReleased()
             onCloseBtnClicked();
         } else {
             if (m_player->getState() == VlcPalyer::Playing) {
-                m_player->setPosition(pos);
+                seekTo(pos);
             }
         }
     }
 }
 
+/**
+ * @brief VNotePlayWidget::seekTo
+ * @param pos 进度条位置
+ */
+void VNotePlayWidget::seekTo(qint64 pos)
+{
+    if (m_queue.isEmpty()) {
+        m_player->setPosition(pos);
+        return;
+    }
+
+    int index = m_queue.size() - 1;
+    for (int i = 0; i < m_queue.size(); i++) {
+        if (pos * engineUnit < m_queueOffsets.at(i + 1)) {
+            index = i;
+            break;
+        }
+    }
+    qint64 localPos = pos - m_queueOffsets.at(index) / engineUnit;
+    if (index == m_queueIndex) {
+        m_player->setPosition(localPos);
+    } else {
+        //切换语音后需要等待文件加载完成才能跳转
+        m_queueIndex = index;
+        m_pendingSeek = localPos > 0 ? localPos : -1;
+        startVoice(m_queue.at(index).get());
+    }
+}
+
+/**
+ * @brief VNotePlayWidget::queueOffset
+ * @return 当前语音的起始位置，未连续播放时为0
+ */
+qint64 VNotePlayWidget::queueOffset() const
+{
+    if (m_queue.isEmpty()) {
+        return 0;
+    }
+    return m_queueOffsets.at(m_queueIndex) / engineUnit;
+}
+
+/**
+ * @brief VNotePlayWidget::clearQueue
+ */
+void VNotePlayWidget::clearQueue()
+{
+    m_queue.clear();
+    m_queueOffsets.clear();
+    m_queueIndex = -1;
+    m_pendingSeek = -1;
+}
+
 /**
  * @brief VNotePlayWidget::onSliderMove
  * @param pos
@@ -192,18 +361,20 @@ void VNotePlayWidget::onSliderReleased()
 void VNotePlayWidget::onSliderMove(int pos)
 {
     if (m_voiceBlock) {
-#ifdef MPV_PLAYENGINE
-        qint64 tmpPos = pos*1000 > m_voiceBlock->voiceSize ? m_voiceBlock->voiceSize : pos*1000;
-#else
-        qint64 tmpPos = pos > m_voiceBlock->voiceSize ? m_voiceBlock->voiceSize : pos;
-#endif
-        m_timeLab->setText(Utils::formatMillisecond(tmpPos, 0) + "/" + Utils::formatMillisecond(m_voiceBlock->voiceSize));
+        //连续播放时显示所有语音的总时长
+        qint64 duration = m_queue.isEmpty() ? m_voiceBlock->voiceSize : m_queueOffsets.last();
+        qint64 tmpPos = pos * engineUnit > duration ? duration : pos * engineUnit;
+        m_timeLab->setText(Utils::formatMillisecond(tmpPos, 0) + "/" + Utils::formatMillisecond(duration));
         //qDebug() << "Current play time: " << m_timeLab->text();
     }
 
     if (m_sliderReleased == true) {
         m_slider->setValue(pos);
     }
+    //拖动时波形同步显示拖动位置
+    if (m_slider->maximum() > 0) {
+        m_sliderHover->setProgress(static_cast<qreal>(pos) / m_slider->maximum());
+    }
 }
 
 /**
@@ -222,7 +393,7 @@ bool VNotePlayWidget::eventFilter(QObject *o, QEvent *e)
                 pos = 0;
             }
             if (m_player->getState() == VlcPalyer::Playing) {
-                m_player->setPosition(pos);
+                seekTo(pos);
             } else {
                 onSliderMove(pos);
             }
@@ -232,7 +403,7 @@ bool VNotePlayWidget::eventFilter(QObject *o, QEvent *e)
                 pos = m_slider->maximum();
             }
             if (m_player->getState() == VlcPalyer::Playing) {
-                m_player->setPosition(pos);
+                seekTo(pos);
             } else {
                 onSliderMove(pos);
             }
@@ -265,6 +436,15 @@ VlcPalyer::VlcState VNotePlayWidget::getPlayerStatus()
  */
 void VNotePlayWidget::onDurationChanged(qint64 duration)
 {
+    //文件已加载，可以跳转到切换语音前选择的位置
+    if (m_pendingSeek >= 0) {
+        m_player->setPosition(m_pendingSeek);
+        m_pendingSeek = -1;
+    }
+    //连续播放时进度条范围为所有语音的总时长
+    if (!m_queue.isEmpty()) {
+        return;
+    }
     if (duration && m_slider->maximum() != duration) {
         qInfo() << "Get total audio duration changed! (duration: " << duration<< ")";
         m_slider->setMaximum(static_cast<int>(duration));
@@ -292,16 +472,75 @@ void VNotePlayWidget::playVoice(VNVoiceBlock *voiceData, bool bIsSame)
         }
     } else if (nullptr != voiceData) { //与上一次语音不相同，重新播放语音
         qInfo() << "Different from the last voice, play the voice again";
-        m_slider->setValue(0);
+        //单独播放的语音结束连续播放
         m_voiceBlock = voiceData;
-        m_player->setChangePlayFile(true);
-        m_player->setFilePath(m_voiceBlock->voicePath);
-        m_nameLab->setText(voiceData->voiceTitle);
-        m_timeLab->setText(Utils::formatMillisecond(0, 0) + "/" + Utils::formatMillisecond(voiceData->voiceSize));
-        m_playerBtn->setIcon(Utils::loadSVG("pause_play.svg", true));
-        m_player->play();
-        emit sigPlayVoice(m_voiceBlock);
+        clearQueue();
+        startVoice(voiceData);
     } else {
         qInfo() << "paly voice param is error";
     }
 }
+
+/**
+ * @brief VNotePlayWidget::playVoices
+ * @param voices 播放队列
+ * @param index 开始播放的语音
+ */
+void VNotePlayWidget::playVoices(const QList<QSharedPointer<VNVoiceBlock>> &voices, int index)
+{
+    if (index < 0 || index >= voices.size()) {
+        qInfo() << "paly voices param is error";
+        return;
+    }
+
+    m_queue = voices;
+    m_queueOffsets.clear();
+    qint64 offset = 0;
+    for (const QSharedPointer<VNVoiceBlock> &voice : m_queue) {
+        m_queueOffsets.append(offset);
+        offset += voice->voiceSize;
+    }
+    m_queueOffsets.append(offset);
+    m_queueIndex = index;
+    m_pendingSeek = -1;
+    m_slider->setMaximum(static_cast<int>(offset / engineUnit));
+    startVoice(m_queue.at(index).get());
+}
+
+/**
+ * @brief VNotePlayWidget::startVoice
+ * 连续播放切换语音时不关闭播放窗口，进度条从当前语音的起始位置继续
+ * @param voiceData 语音
+ */
+void VNotePlayWidget::startVoice(VNVoiceBlock *voiceData)
+{
+    m_voiceBlock = voiceData;
+    m_skipSilence = VNoteVoiceActivity::SkipSilence == VNoteVoiceActivity::modeFromSettings();
+    m_player->setChangePlayFile(true);
+    m_player->setFilePath(m_voiceBlock->voicePath);
+    if (m_queue.isEmpty()) {
+        //已预先解析的语音直接设置进度条范围
+        qint64 duration = m_player->cachedDuration(m_voiceBlock->voicePath);
+        if (duration > 0) {
+            onDurationChanged(duration);
+        }
+        //峰值文件在录音时生成，不需要解码即可绘制波形
+        m_sliderHover->loadPeaks(m_voiceBlock->voicePath);
+        m_nameLab->setText(voiceData->voiceTitle);
+    } else {
+        //波形只对应单个语音，与总进度不一致，连续播放时不绘制
+        m_sliderHover->clear();
+        m_nameLab->setText(QString("%1 (%2/%3)").arg(voiceData->voiceTitle).arg(m_queueIndex + 1).arg(m_queue.size()));
+        //预先解析后续语音，当前语音结束时直接切换
+        QStringList paths;
+        for (int i = m_queueIndex + 1; i < m_queue.size() && paths.size() < queuePrefetch; i++) {
+            paths.append(m_queue.at(i)->voicePath);
+        }
+        m_player->prefetch(paths);
+    }
+    m_slider->setValue(static_cast<int>(queueOffset()));
+    onSliderMove(static_cast<int>(queueOffset()));
+    m_playerBtn->setIcon(Utils::loadSVG("pause_play.svg", true));
+    m_player->play();
+    emit sigPlayVoice(m_voiceBlock);
+}
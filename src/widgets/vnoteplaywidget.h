@@ -14,12 +14,18 @@
 #include <DIconButton>
 #include <DWidget>
 #include <DFrame>
+#include <DPushButton>
+#include <DMenu>
+
+#include <QSharedPointer>
+#include <QVector>
 
 DWIDGET_USE_NAMESPACE
 
 struct VNVoiceBlock;
 class VNoteIconButton;
 class VNote2SIconButton;
+class VNVoiceWaveform;
 
 class QPainter;
 class QWidget;
@@ -30,6 +36,8 @@ public:
     explicit VNotePlayWidget(QWidget *parent = nullptr);
     //播放
     void playVoice(VNVoiceBlock *voiceData, bool bIsSame);
+    //从index开始连续播放语音，进度条显示所有语音的总进度
+    void playVoices(const QList<QSharedPointer<VNVoiceBlock>> &voices, int index);
     //获取状态
     VlcPalyer::VlcState getPlayerStatus();
 signals:
@@ -51,6 +59,10 @@ public slots:
     void onCloseBtnClicked();
     //播放文件总时长改变
     void onDurationChanged(qint64 duration);
+    //当前语音播放结束，连续播放时切换到下一个语音
+    void onPlayEnd();
+    //选择播放倍速
+    void onSpeedChanged(QAction *action);
 
 protected:
     //事件过滤器
@@ -61,15 +73,34 @@ private:
     void initConnection();
     //初始化播放库
     void initPlayer();
+    //初始化倍速菜单，恢复上次使用的倍速
+    void initSpeedMenu();
+    //播放到静音时跳到下一个语音段
+    void skipSilence(qint64 pos);
+    //开始播放新的语音
+    void startVoice(VNVoiceBlock *voiceData);
+    //跳转到进度条位置，连续播放时可能切换语音
+    void seekTo(qint64 pos);
+    //当前语音在总进度中的起始位置，单位与播放位置一致
+    qint64 queueOffset() const;
+    //清空连续播放队列
+    void clearQueue();
     bool m_sliderReleased {true};
+    bool m_skipSilence {false}; //播放时跳过静音
     DLabel *m_timeLab {nullptr};
     DLabel *m_nameLab {nullptr};
     DSlider *m_slider {nullptr};
-    DFrame *m_sliderHover {nullptr};
+    VNVoiceWaveform *m_sliderHover {nullptr}; //进度条背景，绘制录音波形
     DIconButton *m_closeBtn {nullptr};
     VNVoiceBlock *m_voiceBlock {nullptr};
     VlcPalyer *m_player {nullptr};
     DIconButton *m_playerBtn {nullptr};
+    DPushButton *m_speedBtn {nullptr}; //倍速按钮，显示当前倍速
+    DMenu *m_speedMenu {nullptr};
+    QList<QSharedPointer<VNVoiceBlock>> m_queue; //连续播放队列
+    QVector<qint64> m_queueOffsets; //每个语音的起始时间，最后一项为总时长，单位毫秒
+    int m_queueIndex {-1}; //当前播放的语音在队列中的位置
+    qint64 m_pendingSeek {-1}; //切换语音后，加载完成时跳转的位置
 };
 
 #endif // VNOTEPLAYWIDGET_H
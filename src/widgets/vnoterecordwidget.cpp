@@ -5,13 +5,16 @@
 
 #include "vnoterecordwidget.h"
 #include "common/utils.h"
-#include <unistd.h>
+#include "common/vnoterecordsession.h"
+#include "common/performancemonitor.h"
+#include "task/recordfinishworker.h"
 
 #include <QGridLayout>
 #include <QHBoxLayout>
 #include <QStandardPaths>
 #include <QDir>
 #include <QDateTime>
+#include <QThreadPool>
 #include <QDebug>
 
 /**
@@ -75,8 +78,10 @@ void VNoteRecordWidget::initConnection()
 {
     connect(m_recordBtn, &VNote2SIconButton::clicked, this, &VNoteRecordWidget::onRecordBtnClicked);
     connect(m_finshBtn, &DFloatingButton::clicked, this, &VNoteRecordWidget::stopRecord);
-    connect(m_audioRecoder, SIGNAL(audioBufferProbed(const QAudioBuffer &)),
-            this, SLOT(onAudioBufferProbed(const QAudioBuffer &)));
+    connect(m_audioRecoder, &GstreamRecorder::audioLevelsProbed,
+            this, &VNoteRecordWidget::onAudioLevelsProbed);
+    connect(m_audioRecoder, &GstreamRecorder::recordStopped,
+            this, &VNoteRecordWidget::onRecordStopped);
     connect(DApplicationHelper::instance(), &DApplicationHelper::themeTypeChanged,
             this, &VNoteRecordWidget::onChangeTheme);
 }
@@ -99,14 +104,60 @@ void VNoteRecordWidget::initRecordPath()
  */
 void VNoteRecordWidget::stopRecord()
 {
+    if (m_finishing) {
+        return;
+    }
+    m_finishing = true;
+    //合并完成前不能继续录音
+    m_recordBtn->setEnabled(false);
+    m_finshBtn->setEnabled(false);
+    //数据写完后在onRecordStopped中继续
     m_audioRecoder->stopRecord();
-    QFile f(m_recordPath);
-    if (f.open(QIODevice::ReadWrite | QIODevice::Text)) {
-        f.flush(); //将用户缓存中的内容写入内核缓冲区
-        fsync(f.handle()); //将内核缓冲写入磁盘
-        f.close();
+}
+
+/**
+ * @brief VNoteRecordWidget::onRecordStopped
+ */
+void VNoteRecordWidget::onRecordStopped()
+{
+    if (!m_finishing) {
+        return;
+    }
+    //录音文件旁保存波形峰值，播放时不需要解码即可绘制波形
+    m_audioRecoder->savePeakFile(VNotePeakFile::peakPath(m_recordPath));
+    //后台合并录音分段，写入磁盘后才替换录音文件
+    qint64 voiceSize = m_recordMsec;
+    RecordFinishWorker *worker = new RecordFinishWorker(m_recordPath);
+    worker->setAutoDelete(true);
+    worker->setObjectName("RecordFinishWorker");
+    connect(worker, &RecordFinishWorker::recordFinished, this,
+            [ = ](const QString &outputPath, const QString &storedPath, bool success) {
+        onRecordFinished(success ? storedPath : outputPath, voiceSize, success);
+    }, Qt::QueuedConnection);
+    QThreadPool::globalInstance()->start(worker);
+}
+
+/**
+ * @brief VNoteRecordWidget::onRecordFinished
+ * @param voicePath 成功时为存储后的录音路径，失败时为录音会话的输出路径
+ * @param voiceSize 录音时长
+ * @param success 合并成功
+ */
+void VNoteRecordWidget::onRecordFinished(const QString &voicePath, qint64 voiceSize, bool success)
+{
+    m_finishing = false;
+    m_recordBtn->setEnabled(true);
+    m_finshBtn->setEnabled(true);
+    if (success) {
+        emit sigFinshRecord(voicePath, voiceSize);
+        return;
     }
-    emit sigFinshRecord(m_recordPath, m_recordMsec);
+    //没有录到数据时会话已删除，合并失败时保留会话
+    bool recoverable = QDir(VNoteRecordSession::sessionDir(voicePath)).exists();
+    if (recoverable) {
+        qCritical() << __FUNCTION__ << "finish record failed:" << voicePath;
+    }
+    emit sigRecordFailed(voicePath, recoverable);
 }
 
 void VNoteRecordWidget::onRecordBtnClicked()
@@ -119,21 +170,49 @@ void VNoteRecordWidget::onRecordBtnClicked()
     }
 }
 
+/**
+ * @brief VNoteRecordWidget::warmUpRecord
+ * 按当前设置的编码创建流水线，开始预录时不需要再创建
+ * @return true 成功
+ */
+bool VNoteRecordWidget::warmUpRecord()
+{
+    m_audioRecoder->setProfile(VNoteRecordProfile::fromSettings());
+    return m_audioRecoder->warmUp();
+}
+
+/**
+ * @brief VNoteRecordWidget::prepareRecord
+ * 按当前设置的编码创建流水线并打开设备，开始录音时补上预录的数据
+ * @return true 成功
+ */
+bool VNoteRecordWidget::prepareRecord()
+{
+    m_audioRecoder->setProfile(VNoteRecordProfile::fromSettings());
+    return m_audioRecoder->prepare();
+}
+
 /**
  * @brief VNoteRecordWidget::startRecord
  * @return true 成功
  */
 bool VNoteRecordWidget::startRecord()
 {
+    PerformanceMonitor::recordStart();
+    //每次录音按设置选择编码，编码器未安装时使用mp3
+    VNoteRecordProfile profile = m_audioRecoder->setProfile(VNoteRecordProfile::fromSettings());
+    m_audioRecoder->setSilenceMode(VNoteVoiceActivity::modeFromSettings());
     QString fileName = QDateTime::currentDateTime()
                            .toString("yyyyMMddhhmmss")
-                       + ".mp3";
+                       + "." + profile.suffix;
     initRecordPath();
     m_recordMsec = 0;
     m_recordPath = m_recordDir + fileName;
-    m_audioRecoder->setOutputFile(m_recordPath);
+    //录音按时长分段写入会话目录，停止时再合并
+    QString segmentLocation = VNoteRecordSession::begin(m_recordPath, profile.bitrate);
+    m_audioRecoder->setOutputFile(segmentLocation);
     m_timeLabel->setText("00:00");
-    bool ret = m_audioRecoder->startRecord();
+    bool ret = !segmentLocation.isEmpty() && m_audioRecoder->startRecord();
     if (!ret) {
         stopRecord();
     } else {
@@ -152,16 +231,25 @@ QString VNoteRecordWidget::getRecordPath() const
 }
 
 /**
- * @brief VNoteRecordWidget::onAudioBufferProbed
- * @param buffer
+ * @brief VNoteRecordWidget::speechSegments
+ * @return 录音文件中的语音段，单位毫秒
  */
-void VNoteRecordWidget::onAudioBufferProbed(const QAudioBuffer &buffer)
+VNOTE_SPEECH_SEGMENTS VNoteRecordWidget::speechSegments() const
 {
-    qint64 msec = buffer.startTime();
+    return m_audioRecoder->speechSegments();
+}
+
+/**
+ * @brief VNoteRecordWidget::onAudioLevelsProbed
+ * @param levels
+ */
+void VNoteRecordWidget::onAudioLevelsProbed(const VNoteAudioLevels &levels)
+{
+    qint64 msec = levels.position;
     if (msec != m_recordMsec) {
         onRecordDurationChange(msec);
     }
-    m_waveForm->onAudioBufferProbed(buffer);
+    m_waveForm->onAudioLevelsProbed(levels);
 }
 
 /**
@@ -170,6 +258,11 @@ void VNoteRecordWidget::onAudioBufferProbed(const QAudioBuffer &buffer)
  */
 void VNoteRecordWidget::onRecordDurationChange(qint64 duration)
 {
+    //每个分段时长记录一次，无法按码率估算时长的录音恢复时使用
+    qint64 checkpoint = VNoteRecordSession::SegmentDuration * 1000;
+    if (duration / checkpoint != m_recordMsec / checkpoint) {
+        VNoteRecordSession::setDuration(m_recordPath, duration);
+    }
     m_recordMsec = duration;
     QString strTime = Utils::formatMillisecond(duration, 0);
     m_timeLabel->setText(strTime);
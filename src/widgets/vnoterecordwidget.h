@@ -21,6 +21,10 @@ class VNoteRecordWidget : public DFloatingWidget
     Q_OBJECT
 public:
     explicit VNoteRecordWidget(QWidget *parent = nullptr);
+    //初始化录音流水线，不打开录音设备
+    bool warmUpRecord();
+    //预录，打开录音设备等待开始录音
+    bool prepareRecord();
     //开始录音
     bool startRecord();
     //结束录音
@@ -29,16 +33,24 @@ public:
     void setAudioDevice(QString device);
     //获取录音文件路径
     QString getRecordPath() const;
+    //获取上一次录音的语音段
+    VNOTE_SPEECH_SEGMENTS speechSegments() const;
 
 signals:
     void sigFinshRecord(const QString &voicePath, qint64 voiceSize);
+    /**
+     * @brief 录音分段合并失败
+     * @param voicePath 录音文件路径
+     * @param recoverable 会话已保留，下次启动时恢复
+     */
+    void sigRecordFailed(const QString &voicePath, bool recoverable);
 
 public slots:
     void onRecordBtnClicked();
     //录音时长改变
     void onRecordDurationChange(qint64 duration);
     //录音数据改变
-    void onAudioBufferProbed(const QAudioBuffer &buffer);
+    void onAudioLevelsProbed(const VNoteAudioLevels &levels);
     void onChangeTheme();
 
 private:
@@ -50,6 +62,10 @@ private:
     void initRecord();
     //连接槽函数
     void initConnection();
+    //录音数据写完，开始合并分段
+    void onRecordStopped();
+    //录音分段合并完成
+    void onRecordFinished(const QString &voicePath, qint64 voiceSize, bool success);
 
 private:
     VNote2SIconButton *m_recordBtn {nullptr};
@@ -60,6 +76,7 @@ private:
     QString m_recordDir {""};
     QString m_recordPath {""};
     qint64 m_recordMsec {0};
+    bool m_finishing {false}; //正在后台合并录音分段
 };
 
 #endif // VNOTERECORDWIDGET_H
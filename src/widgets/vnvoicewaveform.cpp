@@ -0,0 +1,115 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "vnvoicewaveform.h"
+
+#include <DApplicationHelper>
+
+#include <QPainter>
+#include <QResizeEvent>
+
+/**
+ * @brief VNVoiceWaveform::VNVoiceWaveform
+ * @param parent
+ */
+VNVoiceWaveform::VNVoiceWaveform(QWidget *parent)
+    : DFrame(parent)
+{
+}
+
+/**
+ * @brief VNVoiceWaveform::loadPeaks
+ * @param voicePath 录音文件路径
+ * @return 加载成功返回true
+ */
+bool VNVoiceWaveform::loadPeaks(const QString &voicePath)
+{
+    m_progress = 0;
+    if (!m_peakFile.load(VNotePeakFile::peakPath(voicePath))) {
+        clear();
+        return false;
+    }
+    updateBars();
+    update();
+    return true;
+}
+
+/**
+ * @brief VNVoiceWaveform::clear
+ */
+void VNVoiceWaveform::clear()
+{
+    m_peakFile = VNotePeakFile();
+    m_bars.clear();
+    update();
+}
+
+/**
+ * @brief VNVoiceWaveform::setProgress
+ * @param progress 播放进度
+ */
+void VNVoiceWaveform::setProgress(qreal progress)
+{
+    progress = qBound(qreal(0), progress, qreal(1));
+    if (!qFuzzyCompare(progress + 1, m_progress + 1)) {
+        m_progress = progress;
+        if (!m_bars.isEmpty()) {
+            update();
+        }
+    }
+}
+
+/**
+ * @brief VNVoiceWaveform::updateBars
+ */
+void VNVoiceWaveform::updateBars()
+{
+    int count = width() / (WAVE_WIDTH + WAVE_SPACE);
+    m_bars = m_peakFile.peaks(0, m_peakFile.duration(), count);
+}
+
+/**
+ * @brief VNVoiceWaveform::paintEvent
+ * @param event
+ */
+void VNVoiceWaveform::paintEvent(QPaintEvent *event)
+{
+    DFrame::paintEvent(event);
+    if (m_bars.isEmpty()) {
+        return;
+    }
+
+    QPainter painter(this);
+    DPalette pa = DApplicationHelper::instance()->palette(this);
+    QColor playedColor = pa.color(DPalette::Highlight);
+    QColor waveColor = pa.color(DPalette::TextTips);
+    playedColor.setAlphaF(0.5);
+    waveColor.setAlphaF(0.3);
+
+    const qreal center = height() / 2.0;
+    const qreal scale = center / 128;
+    const int playedBars = qRound(m_progress * m_bars.size());
+    for (int i = 0; i < m_bars.size(); i++) {
+        const VNotePeak &peak = m_bars.at(i);
+        qreal top = center - peak.max * scale;
+        qreal bottom = center - peak.min * scale;
+        //静音部分保留一条细线
+        qreal waveHeight = qMax(bottom - top, qreal(1));
+        QRectF waveRectF(i * (WAVE_WIDTH + WAVE_SPACE), qMin(top, center - waveHeight / 2), WAVE_WIDTH, waveHeight);
+        painter.fillRect(waveRectF, i < playedBars ? playedColor : waveColor);
+    }
+}
+
+/**
+ * @brief VNVoiceWaveform::resizeEvent
+ * @param event
+ */
+void VNVoiceWaveform::resizeEvent(QResizeEvent *event)
+{
+    DFrame::resizeEvent(event);
+    if (!m_peakFile.isEmpty()) {
+        updateBars();
+    }
+}
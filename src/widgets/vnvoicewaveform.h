@@ -0,0 +1,50 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef VNVOICEWAVEFORM_H
+#define VNVOICEWAVEFORM_H
+
+#include "common/vnotepeakfile.h"
+
+#include <DFrame>
+
+DWIDGET_USE_NAMESPACE
+
+/**
+ * @brief The VNVoiceWaveform class
+ * 播放窗口进度条背景，根据录音的峰值文件绘制整段波形，已播放部分高亮
+ */
+class VNVoiceWaveform : public DFrame
+{
+    Q_OBJECT
+public:
+    explicit VNVoiceWaveform(QWidget *parent = nullptr);
+
+    const int WAVE_WIDTH = 2;
+    const int WAVE_SPACE = 1;
+
+    //加载录音的峰值文件，没有峰值文件时不绘制波形
+    bool loadPeaks(const QString &voicePath);
+    //清空波形
+    void clear();
+    //设置播放进度，范围[0,1]
+    void setProgress(qreal progress);
+
+protected:
+    //绘制波形
+    void paintEvent(QPaintEvent *event) override;
+    //窗口大小改变
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    //按当前宽度重新计算每个波形条的峰值
+    void updateBars();
+
+    VNotePeakFile m_peakFile;
+    QVector<VNotePeak> m_bars; //每个波形条的峰值
+    qreal m_progress {0};
+};
+
+#endif // VNVOICEWAVEFORM_H
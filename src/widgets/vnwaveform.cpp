@@ -23,21 +23,33 @@ VNWaveform::VNWaveform(QWidget *parent)
 }
 
 /**
- * @brief VNWaveform::onAudioBufferProbed
- * @param buffer
+ * @brief VNWaveform::onAudioLevelsProbed
+ * 追加窗口峰值，波形从右向左滚动
+ * @param levels 录音电平
  */
-void VNWaveform::onAudioBufferProbed(const QAudioBuffer &buffer)
+void VNWaveform::onAudioLevelsProbed(const VNoteAudioLevels &levels)
 {
     static struct timeval curret = {0, 0};
     static struct timeval lastUpdate = {0, 0};
 
+    for (int i = 0; i < levels.count; i++) {
+        m_audioScaleSamples.append(qreal(levels.peak[i]) * SHRT_MAX);
+    }
+    int overflow = m_audioScaleSamples.size() - qMax(m_maxShowedSamples, 0);
+    if (overflow > 0) {
+        m_audioScaleSamples.remove(0, overflow);
+    }
+
     gettimeofday(&curret, nullptr);
 
     if (TM(lastUpdate, curret) > WAVE_REFRESH_FREQ) {
-        getBufferLevels(buffer, m_audioScaleSamples, m_frameGain);
+        qreal maxSample = 0;
+        for (qreal sample : m_audioScaleSamples) {
+            maxSample = qMax(maxSample, sample);
+        }
 
         //Max sampe value is sqrt(Max)
-        m_frameGain = qSqrt(m_frameGain);
+        m_frameGain = qSqrt(maxSample);
 
         //If the volume too low, use the
         //defaultGain * 2 as max sample value
@@ -115,117 +127,6 @@ void VNWaveform::resizeEvent(QResizeEvent *event)
     DFrame::resizeEvent(event);
 }
 
-/**
- * @brief VNWaveform::getBufferLevels
- * @param buffer
- * @param scaleSamples
- * @param frameGain
- */
-void VNWaveform::getBufferLevels(
-    const QAudioBuffer &buffer,
-    QVector<qreal> &scaleSamples,
-    qreal &frameGain)
-{
-    QVector<qreal> values;
-
-    if (!buffer.format().isValid() || buffer.format().byteOrder() != QAudioFormat::LittleEndian)
-        return;
-
-    if (buffer.format().codec() != "audio/pcm")
-        return;
-
-    int channelCount = buffer.format().channelCount();
-
-    scaleSamples.reserve(buffer.frameCount());
-    scaleSamples.fill(0, buffer.frameCount());
-
-    //TODO:
-    //   Use the max sample value instead of this value.
-    //So it's not necessory.
-    //qreal peak_value = VNWaveform::getPeakValue(buffer.format());
-    qreal peak_value = 0;
-
-    switch (buffer.format().sampleType()) {
-    case QAudioFormat::Unknown:
-    case QAudioFormat::UnSignedInt:
-        if (buffer.format().sampleSize() == 32)
-            VNWaveform::getBufferLevels(
-                buffer.constData<quint32>(),
-                buffer.frameCount(),
-                channelCount, peak_value, scaleSamples, frameGain);
-        if (buffer.format().sampleSize() == 16)
-            VNWaveform::getBufferLevels(
-                buffer.constData<quint16>(),
-                buffer.frameCount(),
-                channelCount, peak_value, scaleSamples, frameGain);
-        if (buffer.format().sampleSize() == 8)
-            VNWaveform::getBufferLevels(
-                buffer.constData<quint8>(),
-                buffer.frameCount(),
-                channelCount, peak_value, scaleSamples, frameGain);
-        break;
-    case QAudioFormat::Float:
-        if (buffer.format().sampleSize() == 32) {
-            VNWaveform::getBufferLevels(
-                buffer.constData<float>(),
-                buffer.frameCount(),
-                channelCount, peak_value, scaleSamples, frameGain);
-        }
-        break;
-    case QAudioFormat::SignedInt:
-        if (buffer.format().sampleSize() == 32)
-            VNWaveform::getBufferLevels(
-                buffer.constData<qint32>(),
-                buffer.frameCount(),
-                channelCount, peak_value, scaleSamples, frameGain);
-        if (buffer.format().sampleSize() == 16)
-            VNWaveform::getBufferLevels(
-                buffer.constData<qint16>(),
-                buffer.frameCount(),
-                channelCount, peak_value, scaleSamples, frameGain);
-        if (buffer.format().sampleSize() == 8)
-            VNWaveform::getBufferLevels(
-                buffer.constData<qint8>(),
-                buffer.frameCount(),
-                channelCount, peak_value, scaleSamples, frameGain);
-        break;
-    }
-}
-
-template<class T>
-/**
- * @brief VNWaveform::getBufferLevels
- * @param buffer
- * @param frames
- * @param channels
- * @param peakValue
- * @param samples
- * @param frameGain
- */
-void VNWaveform::getBufferLevels(
-    const T *buffer, int frames, int channels,
-    qreal peakValue, QVector<qreal> &samples, qreal &frameGain)
-{
-    Q_UNUSED(peakValue);
-
-    for (int i = 0; i < frames; ++i) {
-        qreal averageValue = 0;
-
-        for (int j = 0; j < channels; ++j) {
-            averageValue += qAbs(qreal(buffer[i * channels + j]));
-        }
-
-        averageValue = (averageValue) / channels;
-
-        //Get the max sample value
-        if (frameGain < averageValue) {
-            frameGain = averageValue;
-        }
-
-        samples[i] = averageValue;
-    }
-}
-
 /**
  * @brief VNWaveform::getPeakValue
  * @param format
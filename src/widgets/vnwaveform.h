@@ -6,9 +6,11 @@
 #ifndef VNWAVEFORM_H
 #define VNWAVEFORM_H
 
+#include "common/vnoteaudiolevel.h"
+
 #include <DFrame>
 
-#include <QAudioBuffer>
+#include <QAudioFormat>
 
 DWIDGET_USE_NAMESPACE
 
@@ -33,28 +35,19 @@ public:
 signals:
 
 public slots:
-    //数据更新
-    void onAudioBufferProbed(const QAudioBuffer &buffer);
+    //电平更新
+    void onAudioLevelsProbed(const VNoteAudioLevels &levels);
 
 protected:
     //波形数据转换
     static qreal getPeakValue(const QAudioFormat &format);
-    static void getBufferLevels(const QAudioBuffer &buffer, QVector<qreal> &scaleSamples, qreal &frameGain);
-
-    template<class T>
-    static void getBufferLevels(const T *buffer,
-                                int frames,
-                                int channels,
-                                qreal peakValue,
-                                QVector<qreal> &samples,
-                                qreal &frameGain);
     //绘制波形
     void paintEvent(QPaintEvent *event) override;
     //窗口大小改变
     void resizeEvent(QResizeEvent *event) override;
 
 protected:
-    QVector<qreal> m_audioScaleSamples;
+    QVector<qreal> m_audioScaleSamples; //最近的窗口峰值，最新的在末尾
 
     qreal m_frameGain {0};
     const qreal m_defaultGain = 3;
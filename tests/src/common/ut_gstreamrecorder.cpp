@@ -7,6 +7,8 @@
 #include "gstreamrecorder.h"
 #include "vnoterecordbar.h"
 
+#include <QSignalSpy>
+
 UT_GstreamRecorder::UT_GstreamRecorder()
 {
 }
@@ -61,3 +63,92 @@ TEST_F(UT_GstreamRecorder, UT_GstreamRecorder_initFormat)
     EXPECT_EQ(QAudioFormat::SignedInt, gstreamrecorder.m_format.sampleType()) << "sampleType";
     EXPECT_EQ(16, gstreamrecorder.m_format.sampleSize()) << "sampleSize";
 }
+
+TEST_F(UT_GstreamRecorder, UT_GstreamRecorder_setProfile_001)
+{
+    GstreamRecorder gstreamrecorder;
+    gstreamrecorder.createPipe();
+    VNoteRecordProfile profile = VNoteRecordProfile::fromCodec(VNoteRecordProfile::Flac);
+    VNoteRecordProfile used = gstreamrecorder.setProfile(profile);
+    if (GstreamRecorder::isProfileAvailable(profile)) {
+        EXPECT_EQ(VNoteRecordProfile::Flac, used.codec);
+        //编码改变后重新创建流水线
+        EXPECT_EQ(nullptr, gstreamrecorder.m_pipeline);
+    } else {
+        EXPECT_EQ(VNoteRecordProfile::Mp3, used.codec);
+    }
+    EXPECT_EQ(used.sampleRate, gstreamrecorder.m_format.sampleRate());
+    EXPECT_EQ(used.channels, gstreamrecorder.m_format.channelCount());
+}
+
+TEST_F(UT_GstreamRecorder, UT_GstreamRecorder_timeOffset_001)
+{
+    GstreamRecorder gstreamrecorder;
+    EXPECT_EQ(0, gstreamrecorder.timeOffset());
+    gstreamrecorder.m_baseTime = 5 * GST_SECOND;
+    EXPECT_EQ(static_cast<qint64>(5 * GST_SECOND), gstreamrecorder.timeOffset());
+}
+
+TEST_F(UT_GstreamRecorder, UT_GstreamRecorder_stopRecord_002)
+{
+    GstreamRecorder gstreamrecorder;
+    gstreamrecorder.createPipe();
+    gstreamrecorder.blockPreRoll();
+    EXPECT_NE(0u, gstreamrecorder.m_preRollProbe);
+    //预录状态下停止不等待结束事件，保留流水线
+    gstreamrecorder.stopRecord();
+    EXPECT_FALSE(gstreamrecorder.m_recording);
+    EXPECT_TRUE(gstreamrecorder.m_pipeline != nullptr);
+    gstreamrecorder.releasePreRoll();
+    EXPECT_EQ(0u, gstreamrecorder.m_preRollProbe);
+}
+
+TEST_F(UT_GstreamRecorder, UT_GstreamRecorder_startRecord_001)
+{
+    GstreamRecorder gstreamrecorder;
+    //上次录音未读取的电平
+    VNoteAudioLevels *levels = gstreamrecorder.m_levelRing.beginWrite();
+    ASSERT_TRUE(levels != nullptr);
+    gstreamrecorder.m_levelRing.endWrite();
+    if (gstreamrecorder.startRecord()) {
+        EXPECT_TRUE(nullptr == gstreamrecorder.m_levelRing.front());
+        gstreamrecorder.stopRecord();
+    }
+}
+
+TEST_F(UT_GstreamRecorder, UT_GstreamRecorder_doBusMessage_001)
+{
+    GstreamRecorder gstreamrecorder;
+    gstreamrecorder.createPipe();
+    QSignalSpy spy(&gstreamrecorder, &GstreamRecorder::recordStopped);
+    //未等待结束事件时忽略
+    GstMessage *message = gst_message_new_eos(nullptr);
+    gstreamrecorder.doBusMessage(message);
+    EXPECT_EQ(0, spy.count());
+
+    //结束事件到达后停止流水线并通知
+    gstreamrecorder.m_eosPending = true;
+    gstreamrecorder.m_eosTimer.start();
+    gstreamrecorder.doBusMessage(message);
+    gst_message_unref(message);
+    EXPECT_EQ(1, spy.count());
+    EXPECT_FALSE(gstreamrecorder.m_eosPending);
+    EXPECT_FALSE(gstreamrecorder.m_eosTimer.isActive());
+
+    //预录状态下停止时直接通知
+    gstreamrecorder.stopRecord();
+    EXPECT_EQ(2, spy.count());
+}
+
+TEST_F(UT_GstreamRecorder, UT_GstreamRecorder_warmUp_001)
+{
+    GstreamRecorder gstreamrecorder;
+    if (gstreamrecorder.warmUp()) {
+        //只初始化元素，不进入采集状态
+        int state = -1;
+        int pending = -1;
+        gstreamrecorder.GetGstState(&state, &pending);
+        EXPECT_NE(GST_STATE_PLAYING, state);
+        EXPECT_FALSE(gstreamrecorder.m_armTimer.isActive());
+    }
+}
@@ -6,6 +6,8 @@
 #include "ut_jscontent.h"
 #include "jscontent.h"
 
+#include <QTimer>
+
 UT_JsContent::UT_JsContent()
 {
 }
@@ -31,6 +33,21 @@ TEST_F(UT_JsContent, UT_JsContent_insertImages_002)
     EXPECT_FALSE(instance->insertImages(image));
 }
 
+TEST_F(UT_JsContent, UT_JsContent_waitForImages_001)
+{
+    JsContent *instance = JsContent::instance();
+    //没有处理中的图片时直接返回
+    EXPECT_FALSE(instance->waitForImages(10));
+
+    instance->m_pendingImages = 1;
+    QTimer::singleShot(0, instance, [instance] {
+        instance->m_pendingImages = 0;
+        emit instance->callJsReplaceImage("1", "", "");
+    });
+    EXPECT_TRUE(instance->waitForImages());
+    EXPECT_EQ(0, instance->m_pendingImages);
+}
+
 TEST_F(UT_JsContent, UT_JsContent_jsCallTxtChange_001)
 {
     JsContent::instance()->jsCallTxtChange();
@@ -61,6 +78,31 @@ TEST_F(UT_JsContent, UT_JsContent_callJsSynchronous_001)
     EXPECT_TRUE(JsContent::instance()->callJsSynchronous(nullptr, "").isNull());
 }
 
+TEST_F(UT_JsContent, UT_JsContent_callJsAsync_001)
+{
+    bool called = false;
+    QVariant ret("a");
+    EXPECT_EQ(-1, JsContent::instance()->callJsAsync(nullptr, "", [&](const QVariant &result) {
+        called = true;
+        ret = result;
+    }));
+    EXPECT_TRUE(called);
+    EXPECT_FALSE(ret.isValid());
+}
+
+TEST_F(UT_JsContent, UT_JsContent_finishJsCall_001)
+{
+    int count = 0;
+    JsContent *instance = JsContent::instance();
+    instance->m_jsCallbacks.insert(100, [&](const QVariant &) {
+        count++;
+    });
+    instance->finishJsCall(100, QVariant());
+    //重复结束不再回调
+    instance->finishJsCall(100, QVariant());
+    EXPECT_EQ(1, count);
+}
+
 TEST_F(UT_JsContent, UT_JsContent_jsCallSetDataFinsh_001)
 {
     JsContent::instance()->jsCallSetDataFinsh();
@@ -86,3 +86,27 @@ TEST_F(UT_MetaDataParser, UT_MetaDataParser_makeMetaData_001)
     metadataparser.makeMetaData(noteData, metadata);
     delete noteData;
 }
+
+TEST_F(UT_MetaDataParser, UT_MetaDataParser_makeMetaData_002)
+{
+    MetaDataParser metadataparser;
+    VNVoiceBlock voiceData;
+    voiceData.voicePath = "/tmp/20210916171920.mp3";
+    voiceData.voiceSize = 6000;
+    voiceData.createTime = QDateTime::fromString("2021-09-16 17:19:22.065", VNOTE_TIME_FMT);
+    voiceData.speechSegments.append(qMakePair(Q_INT64_C(1000), Q_INT64_C(2300)));
+    voiceData.speechSegments.append(qMakePair(Q_INT64_C(4000), Q_INT64_C(5800)));
+
+    QVariant metadata;
+    metadataparser.makeMetaData(&voiceData, metadata);
+    EXPECT_TRUE(metadata.toString().contains("\"speech\":[[1000,2300],[4000,5800]]"));
+
+    VNVoiceBlock parsed;
+    EXPECT_TRUE(metadataparser.parse(metadata, &parsed));
+    EXPECT_EQ(voiceData.speechSegments, parsed.speechSegments);
+
+    //没有语音段时不写入
+    voiceData.speechSegments.clear();
+    metadataparser.makeMetaData(&voiceData, metadata);
+    EXPECT_FALSE(metadata.toString().contains("speech"));
+}
@@ -38,3 +38,29 @@ TEST_F(UT_VlcPalyer, UT_VlcPalyer_getState_001)
     VlcPalyer player;
     player.getState();
 }
+
+TEST_F(UT_VlcPalyer, UT_VlcPalyer_instance_001)
+{
+    EXPECT_EQ(VlcPalyer::instance(), VlcPalyer::instance());
+}
+
+TEST_F(UT_VlcPalyer, UT_VlcPalyer_cachedDuration_001)
+{
+    VlcPalyer player;
+    EXPECT_EQ(0, player.cachedDuration("/tmp/not_exist.mp3"));
+    player.m_durations.insert("/tmp/test.mp3", 3);
+    EXPECT_EQ(3, player.cachedDuration("/tmp/test.mp3"));
+    player.prefetch(QStringList() << "/tmp/not_exist.mp3");
+}
+
+TEST_F(UT_VlcPalyer, UT_VlcPalyer_updatePosition_001)
+{
+    VlcPalyer player;
+    player.updatePosition(10);
+    player.updatePosition(20);
+    //界面线程处理前只投递一次，发送最新的位置
+    EXPECT_EQ(1, player.m_positionNotify.loadAcquire());
+    EXPECT_EQ(20, player.m_position.loadAcquire());
+    player.emitPosition();
+    EXPECT_EQ(0, player.m_positionNotify.loadAcquire());
+}
@@ -5,6 +5,9 @@
 
 #include "ut_vnotea2tmanager.h"
 #include "vnotea2tmanager.h"
+#include "stub.h"
+
+#include <QSignalSpy>
 
 UT_VNoteA2TManager::UT_VNoteA2TManager()
 {
@@ -77,3 +80,90 @@ TEST_F(UT_VNoteA2TManager, UT_VNoteA2TManager_getErrorCode_001)
     EXPECT_EQ(VNoteA2TManager::ErrorCode::DontCareError, vnotea2tmanager.getErrorCode(tmpstruct))
         << "CODE_SUCCESS, XF_finish";
 }
+
+static void stub_startAsr()
+{
+}
+
+TEST_F(UT_VNoteA2TManager, UT_VNoteA2TManager_chunkedAsr_001)
+{
+    VNoteA2TManager vnotea2tmanager;
+    QSignalSpy successSpy(&vnotea2tmanager, &VNoteA2TManager::asrSuccess);
+    //模拟分段线程已解码的状态
+    vnotea2tmanager.m_chunkCanceled.reset(new QAtomicInt(0));
+    vnotea2tmanager.m_chunkDecoding = true;
+
+    Stub stub;
+    stub.set(ADDR(VNoteA2TManager, startAsr), stub_startAsr);
+    vnotea2tmanager.onChunkReady(0, "/tmp/chunk_0000.wav", 0, 200000);
+    vnotea2tmanager.onChunkReady(1, "/tmp/chunk_0001.wav", 200000, 400000);
+    vnotea2tmanager.onChunkReady(2, "/tmp/chunk_0002.wav", 400000, 420000);
+    //同时转写的分段数受限
+    ASSERT_EQ(VNoteAsrChunker::MaxChannels, vnotea2tmanager.m_runningChunks.size());
+    EXPECT_EQ(1, vnotea2tmanager.m_readyChunks.size());
+
+    VNoteA2TManager *first = vnotea2tmanager.m_chunkChannels.at(0);
+    VNoteA2TManager *second = vnotea2tmanager.m_chunkChannels.at(1);
+    //后面的分段先完成，结果仍按顺序拼接
+    emit second->asrSuccess("world");
+    vnotea2tmanager.onChunkDecodeFinished(true);
+    emit first->asrSuccess("hello");
+    EXPECT_EQ(0, successSpy.count());
+
+    //静音分段没有文本
+    emit second->asrError(VNoteA2TManager::AudioMuteFile);
+    ASSERT_EQ(1, successSpy.count());
+    EXPECT_EQ("[00:00] hello\n[03:20] world", successSpy.at(0).at(0).toString());
+    EXPECT_FALSE(vnotea2tmanager.isChunking());
+}
+
+TEST_F(UT_VNoteA2TManager, UT_VNoteA2TManager_chunkedAsr_002)
+{
+    VNoteA2TManager vnotea2tmanager;
+    QSignalSpy errorSpy(&vnotea2tmanager, &VNoteA2TManager::asrError);
+    vnotea2tmanager.m_chunkCanceled.reset(new QAtomicInt(0));
+    vnotea2tmanager.m_chunkDecoding = true;
+
+    Stub stub;
+    stub.set(ADDR(VNoteA2TManager, startAsr), stub_startAsr);
+    vnotea2tmanager.onChunkReady(0, "/tmp/chunk_0000.wav", 0, 200000);
+    //分段失败时结束整个转写
+    emit vnotea2tmanager.m_chunkChannels.at(0)->asrError(VNoteA2TManager::NetworkError);
+    ASSERT_EQ(1, errorSpy.count());
+    EXPECT_FALSE(vnotea2tmanager.isChunking());
+    EXPECT_TRUE(vnotea2tmanager.m_chunks.isEmpty());
+}
+
+static VNoteA2TManager::ErrorCode stub_startSessionAsr()
+{
+    return VNoteA2TManager::Success;
+}
+
+TEST_F(UT_VNoteA2TManager, UT_VNoteA2TManager_chunkedAsr_003)
+{
+    VNoteA2TManager vnotea2tmanager;
+    vnotea2tmanager.setChunkInOwnSession(true);
+    QSignalSpy successSpy(&vnotea2tmanager, &VNoteA2TManager::asrSuccess);
+    vnotea2tmanager.m_chunkCanceled.reset(new QAtomicInt(0));
+    vnotea2tmanager.m_chunkDecoding = true;
+
+    Stub stub;
+    stub.set(ADDR(VNoteA2TManager, startSessionAsr), stub_startSessionAsr);
+    vnotea2tmanager.onChunkReady(0, "/tmp/chunk_0000.wav", 0, 200000);
+    vnotea2tmanager.onChunkReady(1, "/tmp/chunk_0001.wav", 200000, 400000);
+    //分段依次使用自己的会话转写，不创建转写通道
+    EXPECT_TRUE(vnotea2tmanager.m_chunkChannels.isEmpty());
+    ASSERT_EQ(1, vnotea2tmanager.m_runningChunks.size());
+    EXPECT_EQ(0, vnotea2tmanager.m_runningChunks.value(&vnotea2tmanager));
+
+    vnotea2tmanager.onNotify("{\"code\": \"000000\", \"failType\": 0, \"status\": 4, \"text\": \"hello\"}");
+    EXPECT_EQ(1, vnotea2tmanager.m_runningChunks.value(&vnotea2tmanager));
+    vnotea2tmanager.onChunkDecodeFinished(true);
+    EXPECT_EQ(0, successSpy.count());
+
+    //静音分段没有文本
+    vnotea2tmanager.onNotify("{\"code\": \"000000\", \"failType\": 6, \"status\": -1, \"text\": \"\"}");
+    ASSERT_EQ(1, successSpy.count());
+    EXPECT_EQ("[00:00] hello", successSpy.at(0).at(0).toString());
+    EXPECT_FALSE(vnotea2tmanager.isChunking());
+}
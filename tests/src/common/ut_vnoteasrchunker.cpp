@@ -0,0 +1,111 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnoteasrchunker.h"
+#include "vnoteasrchunker.h"
+#include "task/asrchunkworker.h"
+
+#include <QDataStream>
+
+static const int bufferFrames = VNoteAsrChunker::SampleRate / 10;
+
+UT_VNoteAsrChunker::UT_VNoteAsrChunker()
+{
+}
+
+//每段100毫秒，语音每秒有100毫秒停顿，不足以切分，返回第一次切分前处理的段数，未切分返回-1
+static int processSpeech(VNoteAsrChunker &chunker, int count)
+{
+    QVector<qint16> speech(bufferFrames);
+    for (int i = 0; i < bufferFrames; i++) {
+        speech[i] = i % 2 ? 10000 : -10000;
+    }
+    QVector<qint16> silence(bufferFrames, 0);
+
+    for (int i = 0; i < count; i++) {
+        const QVector<qint16> &data = 9 == i % 10 ? silence : speech;
+        if (chunker.process(data.constData(), bufferFrames)) {
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+TEST_F(UT_VNoteAsrChunker, UT_VNoteAsrChunker_process_001)
+{
+    VNoteAsrChunker chunker;
+    chunker.reset();
+    //不足最短时长时停顿不切分
+    EXPECT_EQ(-1, processSpeech(chunker, 1850));
+    EXPECT_EQ(185000, chunker.position());
+
+    //超过最短时长后在静音处切分
+    QVector<qint16> silence(bufferFrames, 0);
+    int count = 0;
+    while (!chunker.process(silence.constData(), bufferFrames) && count < 100) {
+        count++;
+    }
+    EXPECT_LT(count, 10);
+    EXPECT_GT(chunker.position(), 185000);
+}
+
+TEST_F(UT_VNoteAsrChunker, UT_VNoteAsrChunker_process_002)
+{
+    VNoteAsrChunker chunker;
+    chunker.reset();
+    //没有静音时在最长时长处切分
+    EXPECT_EQ(VNoteAsrChunker::MaxChunkMs / 100, processSpeech(chunker, 4000));
+    EXPECT_EQ(VNoteAsrChunker::MaxChunkMs, chunker.position());
+    EXPECT_FALSE(chunker.process(nullptr, bufferFrames));
+}
+
+TEST_F(UT_VNoteAsrChunker, UT_VNoteAsrChunker_needChunk_001)
+{
+    EXPECT_FALSE(VNoteAsrChunker::needChunk(VNoteAsrChunker::MaxChunkMs));
+    EXPECT_FALSE(VNoteAsrChunker::needChunk(VNoteAsrChunker::ChunkThresholdMs));
+    EXPECT_TRUE(VNoteAsrChunker::needChunk(60 * 60 * 1000));
+}
+
+TEST_F(UT_VNoteAsrChunker, UT_VNoteAsrChunker_stitch_001)
+{
+    EXPECT_EQ("00:05", VNoteAsrChunker::timestamp(5999));
+    EXPECT_EQ("59:59", VNoteAsrChunker::timestamp(3599000));
+    EXPECT_EQ("1:02:03", VNoteAsrChunker::timestamp(3723000));
+
+    QVector<VNoteAsrChunker::Chunk> chunks(3);
+    chunks[0].text = " hello ";
+    chunks[1].start = 200000;
+    chunks[2].start = 3723000;
+    chunks[2].text = "world";
+    //静音分段不输出
+    EXPECT_EQ("[00:00] hello\n[1:02:03] world", VNoteAsrChunker::stitch(chunks));
+
+    chunks.resize(1);
+    EXPECT_EQ("hello", VNoteAsrChunker::stitch(chunks));
+}
+
+TEST_F(UT_VNoteAsrChunker, UT_VNoteAsrChunker_wavHeader_001)
+{
+    QByteArray header = AsrChunkWorker::wavHeader(32000);
+    ASSERT_EQ(44, header.size());
+    EXPECT_TRUE(header.startsWith("RIFF"));
+    EXPECT_EQ("WAVE", header.mid(8, 4));
+    EXPECT_EQ("data", header.mid(36, 4));
+
+    QDataStream stream(header);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    quint32 riffSize = 0;
+    quint32 sampleRate = 0;
+    quint32 dataSize = 0;
+    stream.skipRawData(4);
+    stream >> riffSize;
+    stream.skipRawData(16);
+    stream >> sampleRate;
+    stream.skipRawData(12);
+    stream >> dataSize;
+    EXPECT_EQ(32036u, riffSize);
+    EXPECT_EQ(static_cast<quint32>(VNoteAsrChunker::SampleRate), sampleRate);
+    EXPECT_EQ(32000u, dataSize);
+}
@@ -0,0 +1,21 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef UT_VNOTEASRCHUNKER_H
+#define UT_VNOTEASRCHUNKER_H
+
+#include "gtest/gtest.h"
+#include <QTest>
+#include <QObject>
+
+class UT_VNoteAsrChunker : public QObject
+    , public ::testing::Test
+{
+    Q_OBJECT
+public:
+    UT_VNoteAsrChunker();
+};
+
+#endif // UT_VNOTEASRCHUNKER_H
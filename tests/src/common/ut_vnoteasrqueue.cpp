@@ -0,0 +1,174 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnoteasrqueue.h"
+#include "vnoteasrqueue.h"
+#include "vnotea2tmanager.h"
+#include "vnoteitem.h"
+#include "globaldef.h"
+#include "db/vnoteasrjoboper.h"
+#include "stub.h"
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+static bool stub_jobs(const VNoteAsrJobs &)
+{
+    return true;
+}
+
+static int removedJobs = 0;
+static bool stub_removeJobs(const VNoteAsrJobs &jobs)
+{
+    removedJobs += jobs.size();
+    return true;
+}
+
+//生成语音块html
+static QString voiceHtml(const QString &voicePath, const QString &text, qint64 voiceSize)
+{
+    return QString("<div class=\"li voiceBox\" jsonkey=\"{&quot;text&quot;:&quot;%1&quot;,&quot;type&quot;:2,"
+                   "&quot;voicePath&quot;:&quot;%2&quot;,&quot;voiceSize&quot;:%3}\"></div>")
+        .arg(text)
+        .arg(voicePath)
+        .arg(voiceSize);
+}
+
+static VNoteAsrJob makeJob(const QString &voicePath, qint32 noteId)
+{
+    VNoteAsrJob job;
+    job.voicePath = voicePath;
+    job.noteId = noteId;
+    job.duration = 1000;
+    return job;
+}
+
+UT_VNoteAsrQueue::UT_VNoteAsrQueue()
+{
+}
+
+TEST_F(UT_VNoteAsrQueue, UT_VNoteAsrQueue_jobsFromNote_001)
+{
+    QTemporaryDir dir;
+    QString voicePath = dir.path() + "/1.mp3";
+    QFile file(voicePath);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    VNoteItem note;
+    note.noteId = 3;
+    note.htmlCode = voiceHtml(voicePath, "", 1000)
+                    + voiceHtml(voicePath, "hello", 1000) //已有转写文本
+                    + voiceHtml(voicePath, "", MAX_A2T_AUDIO_LEN_MS + 1) //长录音分段转写
+                    + voiceHtml(dir.path() + "/2.mp3", "", 1000); //文件不存在
+
+    VNoteAsrJobs jobs = VNoteAsrQueue::jobsFromNote(&note);
+    ASSERT_EQ(2, jobs.size());
+    EXPECT_EQ(voicePath, jobs.at(0).voicePath);
+    EXPECT_EQ(3, jobs.at(0).noteId);
+    EXPECT_EQ(1000, jobs.at(0).duration);
+    EXPECT_EQ(MAX_A2T_AUDIO_LEN_MS + 1, jobs.at(1).duration);
+    EXPECT_TRUE(VNoteAsrQueue::jobsFromNote(nullptr).isEmpty());
+}
+
+TEST_F(UT_VNoteAsrQueue, UT_VNoteAsrQueue_enqueue_001)
+{
+    Stub stub;
+    stub.set(ADDR(VNoteAsrJobOper, addJobs), stub_jobs);
+    stub.set(ADDR(VNoteAsrJobOper, removeJobs), stub_jobs);
+
+    VNoteAsrQueue queue;
+    QSignalSpy progressSpy(&queue, &VNoteAsrQueue::progressChanged);
+    QSignalSpy finishedSpy(&queue, &VNoteAsrQueue::queueFinished);
+
+    //重复的语音只加入一次
+    EXPECT_EQ(2, queue.enqueue(VNoteAsrJobs() << makeJob("/tmp/1.mp3", 1) << makeJob("/tmp/2.mp3", 1) << makeJob("/tmp/1.mp3", 1)));
+    EXPECT_EQ(0, queue.enqueue(VNoteAsrJobs() << makeJob("/tmp/2.mp3", 1)));
+    EXPECT_TRUE(queue.contains("/tmp/1.mp3"));
+    EXPECT_EQ(2, queue.pendingCount());
+    ASSERT_EQ(1, progressSpy.count());
+    EXPECT_EQ(2, progressSpy.at(0).at(1).toInt());
+
+    queue.cancel();
+    EXPECT_EQ(0, queue.pendingCount());
+    EXPECT_FALSE(queue.contains("/tmp/1.mp3"));
+    EXPECT_EQ(1, finishedSpy.count());
+}
+
+TEST_F(UT_VNoteAsrQueue, UT_VNoteAsrQueue_cancel_001)
+{
+    Stub stub;
+    stub.set(ADDR(VNoteAsrJobOper, addJobs), stub_jobs);
+    stub.set(ADDR(VNoteAsrJobOper, removeJobs), stub_jobs);
+
+    VNoteAsrQueue queue;
+    queue.enqueue(VNoteAsrJobs() << makeJob("/tmp/1.mp3", 1) << makeJob("/tmp/2.mp3", 1));
+    QSignalSpy finishedSpy(&queue, &VNoteAsrQueue::queueFinished);
+
+    //正在转写的任务不能取消
+    queue.m_running.insert(nullptr, queue.m_pending.takeFirst());
+    EXPECT_FALSE(queue.cancel("/tmp/1.mp3"));
+    EXPECT_TRUE(queue.cancel("/tmp/2.mp3"));
+    EXPECT_TRUE(queue.cancel("/tmp/3.mp3"));
+    EXPECT_FALSE(queue.contains("/tmp/2.mp3"));
+    EXPECT_EQ(1, queue.pendingCount());
+    EXPECT_EQ(0, finishedSpy.count());
+}
+
+TEST_F(UT_VNoteAsrQueue, UT_VNoteAsrQueue_finishJob_001)
+{
+    Stub stub;
+    stub.set(ADDR(VNoteAsrJobOper, addJobs), stub_jobs);
+    stub.set(ADDR(VNoteAsrJobOper, removeJobs), stub_jobs);
+
+    VNoteAsrQueue queue;
+    queue.enqueue(VNoteAsrJobs() << makeJob("/tmp/1.mp3", 1) << makeJob("/tmp/2.mp3", 1));
+    QSignalSpy finishedSpy(&queue, &VNoteAsrQueue::queueFinished);
+
+    //模拟两个转写通道依次完成
+    queue.m_running.insert(nullptr, queue.m_pending.takeFirst());
+    queue.finishJob(nullptr, true);
+    EXPECT_EQ(0, finishedSpy.count());
+    queue.m_running.insert(nullptr, queue.m_pending.takeFirst());
+    queue.finishJob(nullptr, false);
+
+    ASSERT_EQ(1, finishedSpy.count());
+    EXPECT_EQ(1, finishedSpy.at(0).at(0).toInt());
+    EXPECT_EQ(1, finishedSpy.at(0).at(1).toInt());
+    EXPECT_EQ(0, queue.pendingCount());
+}
+
+TEST_F(UT_VNoteAsrQueue, UT_VNoteAsrQueue_onJobError_001)
+{
+    Stub stub;
+    stub.set(ADDR(VNoteAsrJobOper, addJobs), stub_jobs);
+    stub.set(ADDR(VNoteAsrJobOper, removeJobs), stub_removeJobs);
+    removedJobs = 0;
+
+    VNoteAsrQueue queue;
+    queue.enqueue(VNoteAsrJobs() << makeJob("/tmp/1.mp3", 1) << makeJob("/tmp/2.mp3", 1));
+    QSignalSpy finishedSpy(&queue, &VNoteAsrQueue::queueFinished);
+
+    //网络错误未达到上限时任务放回队首等待重试
+    for (int i = 1; i < VNoteAsrQueue::MaxNetworkRetries; i++) {
+        queue.m_running.insert(nullptr, queue.m_pending.takeFirst());
+        queue.onJobError(nullptr, VNoteA2TManager::NetworkError);
+        EXPECT_EQ("/tmp/1.mp3", queue.m_pending.first().voicePath);
+        EXPECT_TRUE(queue.m_retryTimer.isActive());
+    }
+    EXPECT_EQ(0, finishedSpy.count());
+
+    //达到上限后暂停队列，任务保留在数据库中
+    queue.m_running.insert(nullptr, queue.m_pending.takeFirst());
+    queue.onJobError(nullptr, VNoteA2TManager::NetworkError);
+    EXPECT_EQ(0, queue.pendingCount());
+    EXPECT_FALSE(queue.contains("/tmp/1.mp3"));
+    EXPECT_FALSE(queue.m_retryTimer.isActive());
+    EXPECT_EQ(0, removedJobs);
+    ASSERT_EQ(1, finishedSpy.count());
+    EXPECT_EQ(0, finishedSpy.at(0).at(1).toInt());
+    EXPECT_EQ(2, finishedSpy.at(0).at(2).toInt());
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnoteattachmentstore.h"
+#include "vnoteattachmentstore.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+static bool writeFile(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+UT_VNoteAttachmentStore::UT_VNoteAttachmentStore()
+{
+}
+
+TEST_F(UT_VNoteAttachmentStore, UT_VNoteAttachmentStore_importFile_001)
+{
+
+    QTemporaryDir srcDir;
+    QTemporaryDir storeDir;
+    ASSERT_TRUE(writeFile(srcDir.path() + "/1.png", QByteArray(1024 * 1024, 'x')));
+    ASSERT_TRUE(writeFile(srcDir.path() + "/2.png", QByteArray(1024 * 1024, 'x')));
+    ASSERT_TRUE(writeFile(srcDir.path() + "/3.png", QByteArray(16, 'y')));
+
+    //相同内容只保存一份
+    QString path1 = VNoteAttachmentStore::importFile(srcDir.path() + "/1.png", storeDir.path());
+    QString path2 = VNoteAttachmentStore::importFile(srcDir.path() + "/2.png", storeDir.path());
+    QString path3 = VNoteAttachmentStore::importFile(srcDir.path() + "/3.png", storeDir.path());
+    EXPECT_FALSE(path1.isEmpty());
+    EXPECT_EQ(path1, path2);
+    EXPECT_NE(path1, path3);
+    EXPECT_TRUE(VNoteAttachmentStore::isStoredFile(path1));
+    EXPECT_EQ(1024 * 1024, QFileInfo(path1).size());
+    EXPECT_EQ(2, QDir(storeDir.path()).entryList(QDir::Files).size());
+
+    EXPECT_TRUE(VNoteAttachmentStore::importFile(srcDir.path() + "/none.png", storeDir.path()).isEmpty());
+}
+
+TEST_F(UT_VNoteAttachmentStore, UT_VNoteAttachmentStore_importData_001)
+{
+    QTemporaryDir storeDir;
+    QString path1 = VNoteAttachmentStore::importData("data", storeDir.path(), "png");
+    QString path2 = VNoteAttachmentStore::importData("data", storeDir.path(), "png");
+    EXPECT_EQ(path1, path2);
+    EXPECT_TRUE(path1.endsWith(".png"));
+    EXPECT_EQ(1, QDir(storeDir.path()).entryList(QDir::Files).size());
+}
+
+TEST_F(UT_VNoteAttachmentStore, UT_VNoteAttachmentStore_findStored_001)
+{
+    QTemporaryDir dir;
+    QString hash(40, 'a');
+    //波形文件不是存储的附件
+    ASSERT_TRUE(writeFile(dir.path() + "/" + hash + ".mp3.peaks", "peaks"));
+    EXPECT_TRUE(VNoteAttachmentStore::findStored(dir.path(), hash).isEmpty());
+
+    ASSERT_TRUE(writeFile(dir.path() + "/" + hash + ".mp3", "voice"));
+    EXPECT_EQ(dir.path() + "/" + hash + ".mp3", VNoteAttachmentStore::findStored(dir.path(), hash));
+}
+
+TEST_F(UT_VNoteAttachmentStore, UT_VNoteAttachmentStore_adoptFile_001)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/20230101.mp3";
+    ASSERT_TRUE(writeFile(path, "voice"));
+    QString storedPath = VNoteAttachmentStore::adoptFile(path);
+    EXPECT_TRUE(VNoteAttachmentStore::isStoredFile(storedPath));
+    EXPECT_TRUE(QFile::exists(storedPath));
+    EXPECT_FALSE(QFile::exists(path));
+    EXPECT_EQ(storedPath, VNoteAttachmentStore::adoptFile(storedPath));
+}
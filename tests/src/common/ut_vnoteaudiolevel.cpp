@@ -0,0 +1,157 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnoteaudiolevel.h"
+#include "vnoteaudiolevel.h"
+#include "vnotespscring.h"
+
+#include <QAudioFormat>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QDebug>
+
+//生成可重复的伪随机采样
+template<typename T>
+static QVector<T> makeSamples(int count, qreal scale)
+{
+    QVector<T> data(count);
+    quint32 seed = 12345;
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = static_cast<T>((static_cast<qreal>(seed % 20001) / 10000 - 1) * scale);
+    }
+    return data;
+}
+
+//各实现与标量实现结果一致，并输出耗时对比
+template<typename T>
+static void benchmarkKernels(const QVector<T> &data, const char *name)
+{
+    const int rounds = 2000;
+    float scalarPeak = 0;
+    double scalarSum = 0;
+    VNoteAudioLevel::window(VNoteAudioLevel::Scalar, data.constData(), data.size(), scalarPeak, scalarSum);
+
+    for (VNoteAudioLevel::Kernel kernel : VNoteAudioLevel::availableKernels()) {
+        float peak = 0;
+        double sumSquares = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < rounds; i++) {
+            VNoteAudioLevel::window(kernel, data.constData(), data.size(), peak, sumSquares);
+        }
+        qInfo() << name << "kernel:" << kernel << "elapsed:" << timer.nsecsElapsed() / rounds << "ns";
+
+        EXPECT_FLOAT_EQ(scalarPeak, peak) << name << kernel;
+        EXPECT_NEAR(scalarSum, sumSquares, scalarSum * 1e-4) << name << kernel;
+    }
+}
+
+UT_VNoteAudioLevel::UT_VNoteAudioLevel()
+{
+}
+
+TEST_F(UT_VNoteAudioLevel, UT_VNoteAudioLevel_measure_001)
+{
+    VNoteAudioLevels levels;
+    VNoteAudioLevel::measure(static_cast<const qint16 *>(nullptr), 10, 2, levels);
+    EXPECT_EQ(0, levels.count);
+
+    //两个窗口，第一个静音，第二个满幅方波
+    QVector<qint16> data(VNoteAudioLevel::WindowFrames * 2 * 2, 0);
+    for (int i = VNoteAudioLevel::WindowFrames * 2; i < data.size(); i++) {
+        data[i] = (i % 2) ? -32768 : 32767;
+    }
+    VNoteAudioLevel::measure(data.constData(), VNoteAudioLevel::WindowFrames * 2, 2, levels);
+    ASSERT_EQ(2, levels.count);
+    EXPECT_FLOAT_EQ(0.0f, levels.peak[0]);
+    EXPECT_FLOAT_EQ(0.0f, levels.rms[0]);
+    EXPECT_NEAR(1.0, levels.peak[1], 0.001);
+    EXPECT_NEAR(1.0, levels.rms[1], 0.001);
+}
+
+TEST_F(UT_VNoteAudioLevel, UT_VNoteAudioLevel_measure_002)
+{
+    //数据过长时窗口加长，窗口数不超过上限
+    int frames = VNoteAudioLevel::WindowFrames * VNoteAudioLevels::MaxWindows * 3 + 5;
+    QVector<qint16> data(frames, 100);
+    VNoteAudioLevels levels;
+    VNoteAudioLevel::measure(data.constData(), frames, 1, levels);
+    EXPECT_LE(levels.count, static_cast<int>(VNoteAudioLevels::MaxWindows));
+    EXPECT_FLOAT_EQ(100 / 32768.0f, levels.peak[levels.count - 1]);
+}
+
+TEST_F(UT_VNoteAudioLevel, UT_VNoteAudioLevel_measure_003)
+{
+    QAudioFormat format;
+    format.setCodec("audio/pcm");
+    format.setChannelCount(2);
+    format.setSampleRate(44100);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setSampleType(QAudioFormat::Float);
+    format.setSampleSize(32);
+
+    QVector<float> data(512, -0.5f);
+    VNoteAudioLevels levels;
+    EXPECT_TRUE(VNoteAudioLevel::measure(format, data.constData(), data.size() * 4, levels));
+    ASSERT_EQ(1, levels.count);
+    EXPECT_FLOAT_EQ(0.5f, levels.peak[0]);
+    EXPECT_FLOAT_EQ(0.5f, levels.rms[0]);
+
+    //不支持的格式
+    format.setSampleType(QAudioFormat::UnSignedInt);
+    format.setSampleSize(8);
+    EXPECT_FALSE(VNoteAudioLevel::measure(format, data.constData(), data.size() * 4, levels));
+    EXPECT_EQ(0, levels.count);
+}
+
+TEST_F(UT_VNoteAudioLevel, UT_VNoteAudioLevel_window_001)
+{
+    //非对齐的尾部数据与向量部分结果一致
+    QVector<qint16> s16 = makeSamples<qint16>(37, 10000);
+    s16[35] = -20000;
+    QVector<qint32> s32 = makeSamples<qint32>(37, 1e9);
+    s32[36] = INT_MIN;
+    QVector<float> f32 = makeSamples<float>(37, 1.0);
+    for (VNoteAudioLevel::Kernel kernel : VNoteAudioLevel::availableKernels()) {
+        float peak = 0;
+        double sumSquares = 0;
+        VNoteAudioLevel::window(kernel, s16.constData(), s16.size(), peak, sumSquares);
+        EXPECT_FLOAT_EQ(20000 / 32768.0f, peak) << kernel;
+        VNoteAudioLevel::window(kernel, s32.constData(), s32.size(), peak, sumSquares);
+        EXPECT_FLOAT_EQ(1.0f, peak) << kernel;
+        VNoteAudioLevel::window(kernel, f32.constData(), f32.size(), peak, sumSquares);
+        EXPECT_LE(peak, 1.0f) << kernel;
+    }
+}
+
+TEST_F(UT_VNoteAudioLevel, UT_VNoteAudioLevel_benchmark_001)
+{
+    //约23ms的立体声数据
+    benchmarkKernels(makeSamples<qint16>(2048, 32767), "S16");
+    benchmarkKernels(makeSamples<qint32>(2048, 2147483647), "S32");
+    benchmarkKernels(makeSamples<float>(2048, 1.0), "F32");
+}
+
+TEST_F(UT_VNoteAudioLevel, UT_VNoteSpscRing_001)
+{
+    VNoteSpscRing<int, 4> ring;
+    EXPECT_EQ(nullptr, ring.front());
+    for (int i = 0; i < 4; i++) {
+        int *slot = ring.beginWrite();
+        ASSERT_NE(nullptr, slot);
+        *slot = i;
+        ring.endWrite();
+    }
+    //队列满时放弃写入
+    EXPECT_EQ(nullptr, ring.beginWrite());
+
+    ASSERT_NE(nullptr, ring.front());
+    EXPECT_EQ(0, *ring.front());
+    ring.pop();
+    EXPECT_NE(nullptr, ring.beginWrite());
+    ring.clear();
+    EXPECT_EQ(nullptr, ring.front());
+}
@@ -0,0 +1,45 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnoteautosavescheduler.h"
+#include "vnoteautosavescheduler.h"
+
+#include <QSignalSpy>
+
+UT_VNoteAutosaveScheduler::UT_VNoteAutosaveScheduler()
+{
+}
+
+TEST_F(UT_VNoteAutosaveScheduler, UT_VNoteAutosaveScheduler_markDirty_001)
+{
+    VNoteAutosaveScheduler scheduler;
+    QSignalSpy spy(&scheduler, &VNoteAutosaveScheduler::saveRequested);
+    scheduler.markDirty();
+    EXPECT_TRUE(scheduler.isDirty());
+    EXPECT_TRUE(spy.wait(VNoteAutosaveScheduler::MinIdleDelay * 2));
+    EXPECT_FALSE(scheduler.isDirty());
+}
+
+TEST_F(UT_VNoteAutosaveScheduler, UT_VNoteAutosaveScheduler_cancel_001)
+{
+    VNoteAutosaveScheduler scheduler;
+    QSignalSpy spy(&scheduler, &VNoteAutosaveScheduler::saveRequested);
+    scheduler.markDirty();
+    scheduler.cancel();
+    EXPECT_FALSE(scheduler.isDirty());
+    EXPECT_FALSE(spy.wait(VNoteAutosaveScheduler::MinIdleDelay * 2));
+}
+
+TEST_F(UT_VNoteAutosaveScheduler, UT_VNoteAutosaveScheduler_idleDelay_001)
+{
+    VNoteAutosaveScheduler scheduler;
+    EXPECT_EQ(VNoteAutosaveScheduler::MinIdleDelay, scheduler.idleDelay());
+
+    //保存耗时越长，等待时间越长，但不超过上限
+    scheduler.m_saveCost = 200;
+    EXPECT_EQ(VNoteAutosaveScheduler::MinIdleDelay + 200 * VNoteAutosaveScheduler::CostFactor, scheduler.idleDelay());
+    scheduler.m_saveCost = 5000;
+    EXPECT_EQ(VNoteAutosaveScheduler::MaxIdleDelay, scheduler.idleDelay());
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnoteimagecache.h"
+#include "vnoteimagecache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+UT_VNoteImageCache::UT_VNoteImageCache()
+{
+}
+
+TEST_F(UT_VNoteImageCache, UT_VNoteImageCache_loadScaled_001)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/test.png";
+    QImage image(800, 400, QImage::Format_RGB32);
+    image.fill(Qt::green);
+    ASSERT_TRUE(image.save(path));
+
+    //只缩小不放大
+    EXPECT_EQ(QSize(200, 100), VNoteImageCache::loadScaled(path, QSize(200, 200)).size());
+    EXPECT_EQ(QSize(400, 200), VNoteImageCache::loadScaled(path, QSize(1600, 200)).size());
+    EXPECT_EQ(QSize(800, 400), VNoteImageCache::loadScaled(path, QSize(1600, 1600)).size());
+    EXPECT_EQ(QSize(800, 400), VNoteImageCache::loadScaled(path, QSize()).size());
+    EXPECT_TRUE(VNoteImageCache::loadScaled(dir.path() + "/none.png", QSize(200, 200)).isNull());
+
+    //缩小后的图片写入磁盘缓存
+    QString cachePath = QString("%1/%2_200x100").arg(VNoteImageCache::diskCacheDir()).arg(QString(VNoteImageCache::contentKey(path)));
+    EXPECT_TRUE(QFile::exists(cachePath));
+    EXPECT_EQ(QSize(200, 100), VNoteImageCache::loadScaled(path, QSize(200, 200)).size());
+    QFile::remove(cachePath);
+}
+
+TEST_F(UT_VNoteImageCache, UT_VNoteImageCache_contentKey_001)
+{
+    QTemporaryDir dir;
+    QImage image(16, 16, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    ASSERT_TRUE(image.save(dir.path() + "/1.png"));
+    ASSERT_TRUE(QFile::copy(dir.path() + "/1.png", dir.path() + "/2.png"));
+
+    //相同内容的图片哈希相同
+    QByteArray key = VNoteImageCache::contentKey(dir.path() + "/1.png");
+    EXPECT_FALSE(key.isEmpty());
+    EXPECT_EQ(key, VNoteImageCache::contentKey(dir.path() + "/2.png"));
+    EXPECT_TRUE(VNoteImageCache::contentKey(dir.path() + "/none.png").isEmpty());
+}
+
+TEST_F(UT_VNoteImageCache, UT_VNoteImageCache_request_001)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/test.png";
+    QImage image(300, 300, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+    ASSERT_TRUE(image.save(path));
+
+    VNoteImageCache cache;
+    QSignalSpy spy(&cache, &VNoteImageCache::imageReady);
+    cache.request(path, QSize(100, 100));
+    ASSERT_TRUE(spy.wait(5000));
+    EXPECT_EQ(QSize(100, 100), spy.at(0).at(2).value<QPixmap>().size());
+
+    //再次请求命中内存缓存
+    QPixmap pixmap;
+    EXPECT_TRUE(cache.find(path, QSize(100, 100), &pixmap));
+    cache.request(path, QSize(100, 100));
+    EXPECT_EQ(2, spy.count());
+}
+
+TEST_F(UT_VNoteImageCache, UT_VNoteImageCache_trimDiskCache_001)
+{
+    QDir().mkpath(VNoteImageCache::diskCacheDir());
+    QString path = VNoteImageCache::diskCacheDir() + "/ut_trim";
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(1024, 'a'));
+    file.close();
+
+    VNoteImageCache::trimDiskCache(0);
+    EXPECT_FALSE(QFile::exists(path));
+}
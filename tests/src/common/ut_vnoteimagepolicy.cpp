@@ -0,0 +1,88 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnoteimagepolicy.h"
+#include "vnoteimagepolicy.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+//生成颜色丰富的类照片图片
+static QImage makePhoto(int width, int height)
+{
+    QImage image(width, height, QImage::Format_RGB32);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            image.setPixel(x, y, qRgb((x * 7 + y) % 256, (y * 5 + x * 3) % 256, (x * y) % 256));
+        }
+    }
+    return image;
+}
+
+UT_VNoteImagePolicy::UT_VNoteImagePolicy()
+{
+}
+
+TEST_F(UT_VNoteImagePolicy, UT_VNoteImagePolicy_countColors_001)
+{
+    QImage image(100, 100, QImage::Format_RGB32);
+    image.fill(Qt::white);
+    EXPECT_EQ(1, VNoteImagePolicy::countColors(image, 10));
+    EXPECT_EQ(10, VNoteImagePolicy::countColors(makePhoto(256, 256), 10));
+    EXPECT_EQ(0, VNoteImagePolicy::countColors(QImage(), 10));
+}
+
+TEST_F(UT_VNoteImagePolicy, UT_VNoteImagePolicy_chooseFormat_001)
+{
+    VNoteImagePolicy policy;
+    QImage screenshot(200, 200, QImage::Format_RGB32);
+    screenshot.fill(Qt::white);
+    EXPECT_EQ(VNoteImagePolicy::Png, policy.chooseFormat(screenshot));
+
+    VNoteImagePolicy::Format format = policy.chooseFormat(makePhoto(256, 256));
+    EXPECT_EQ(VNoteImagePolicy::isWebpSupported() ? VNoteImagePolicy::WebP : VNoteImagePolicy::Jpeg, format);
+
+    //关闭重新编码时使用png
+    policy.transcode = false;
+    EXPECT_EQ(VNoteImagePolicy::Png, policy.chooseFormat(makePhoto(256, 256)));
+}
+
+TEST_F(UT_VNoteImagePolicy, UT_VNoteImagePolicy_encode_001)
+{
+    VNoteImagePolicy policy;
+    QImage photo = makePhoto(512, 512);
+    VNoteImagePolicy::Format format = VNoteImagePolicy::Png;
+    QByteArray data = policy.encode(photo, format);
+    EXPECT_NE(VNoteImagePolicy::Png, format);
+    EXPECT_FALSE(QImage::fromData(data).isNull());
+
+    //超过大小预算时降低质量
+    policy.sizeBudget = data.size() / 2;
+    QByteArray smaller = policy.encode(photo, format);
+    EXPECT_LT(smaller.size(), data.size());
+}
+
+TEST_F(UT_VNoteImagePolicy, UT_VNoteImagePolicy_needTranscode_001)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/test.png";
+    QImage image(100, 100, QImage::Format_RGB32);
+    image.fill(Qt::white);
+    ASSERT_TRUE(image.save(path));
+
+    VNoteImagePolicy policy;
+    EXPECT_FALSE(policy.needTranscode(path, image.size()));
+    policy.maxSize = 50;
+    EXPECT_TRUE(policy.needTranscode(path, image.size()));
+    policy.maxSize = 0;
+    policy.sizeBudget = 1;
+    EXPECT_TRUE(policy.needTranscode(path, image.size()));
+    policy.transcode = false;
+    EXPECT_FALSE(policy.needTranscode(path, image.size()));
+
+    EXPECT_EQ(QSize(100, 100), policy.capSize(image).size());
+    policy.maxSize = 50;
+    EXPECT_EQ(QSize(50, 50), policy.capSize(image).size());
+}
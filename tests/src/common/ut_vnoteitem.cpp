@@ -155,6 +155,23 @@ TEST_F(UT_VnoteItem, UT_VnoteItem_getVoiceJsons_001)
     EXPECT_EQ(1, vnoteitem.getVoiceJsons().size()) << "has jsonkey";
 }
 
+TEST_F(UT_VnoteItem, UT_VnoteItem_setVoiceText_001)
+{
+    VNoteItem vnoteitem;
+    vnoteitem.htmlCode = "<div class=\"li voiceBox\" jsonkey=\"{&quot;voicePath&quot;:&quot;/tmp/1.mp3&quot;,&quot;text&quot;:&quot;&quot;}\">"
+                         "<div class=\"voice\"><div></div></div></div><p>after</p>";
+    EXPECT_FALSE(vnoteitem.setVoiceText("/tmp/2.mp3", "hello")) << "voice not found";
+    EXPECT_FALSE(vnoteitem.setVoiceText("/tmp/1.mp3", " ")) << "text is empty";
+
+    EXPECT_TRUE(vnoteitem.setVoiceText("/tmp/1.mp3", "a<b"));
+    //文本插入在语音块之后
+    EXPECT_TRUE(vnoteitem.htmlCode.endsWith("</div></div></div><p>a&lt;b</p><p>after</p>"));
+    EXPECT_TRUE(vnoteitem.htmlCode.contains("&quot;text&quot;:&quot;a&lt;b&quot;"));
+    EXPECT_EQ(1, vnoteitem.getVoiceJsons().size());
+
+    EXPECT_FALSE(vnoteitem.setVoiceText("/tmp/1.mp3", "again")) << "voice already has text";
+}
+
 TEST_F(UT_VnoteItem, UT_VnoteItem_getFullHtml_001)
 {
     VNoteItem vnoteitem;
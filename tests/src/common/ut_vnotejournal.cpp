@@ -0,0 +1,98 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnotejournal.h"
+#include "vnotejournal.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QTemporaryDir>
+
+UT_VNoteJournal::UT_VNoteJournal()
+{
+}
+
+static QJsonObject makeDelta(bool reset, int start, int remove, const QStringList &blocks)
+{
+    QJsonObject delta;
+    delta.insert("reset", reset);
+    delta.insert("start", start);
+    delta.insert("remove", remove);
+    delta.insert("blocks", QJsonArray::fromStringList(blocks));
+    return delta;
+}
+
+TEST_F(UT_VNoteJournal, UT_VNoteJournal_applyDelta_001)
+{
+    QStringList blocks;
+    EXPECT_TRUE(VNoteJournal::applyDelta(blocks, makeDelta(true, 0, 0, QStringList() << "a" << "b" << "c")));
+    EXPECT_EQ(QStringList() << "a" << "b" << "c", blocks);
+
+    //替换中间块
+    EXPECT_TRUE(VNoteJournal::applyDelta(blocks, makeDelta(false, 1, 1, QStringList() << "x" << "y")));
+    EXPECT_EQ(QStringList() << "a" << "x" << "y" << "c", blocks);
+
+    //删除末尾块
+    EXPECT_TRUE(VNoteJournal::applyDelta(blocks, makeDelta(false, 3, 1, QStringList())));
+    EXPECT_EQ(QStringList() << "a" << "x" << "y", blocks);
+
+    //范围越界
+    EXPECT_FALSE(VNoteJournal::applyDelta(blocks, makeDelta(false, 2, 2, QStringList())));
+    EXPECT_EQ(QStringList() << "a" << "x" << "y", blocks);
+}
+
+TEST_F(UT_VNoteJournal, UT_VNoteJournal_replay_001)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/1.journal";
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("{\"time\":100,\"reset\":true,\"blocks\":[\"a\",\"b\"]}\n");
+    file.write("{\"time\":200,\"start\":1,\"remove\":1,\"blocks\":[\"c\"]}\n");
+    //异常退出时最后一条记录不完整
+    file.write("{\"time\":300,\"sta");
+    file.close();
+
+    VNoteJournal journal;
+    QStringList blocks;
+    EXPECT_TRUE(journal.replay(path, 150, blocks));
+    EXPECT_EQ(QStringList() << "a" << "c", blocks);
+
+    //日志早于数据库中的修改时间，已合并过
+    blocks.clear();
+    EXPECT_FALSE(journal.replay(path, 200, blocks));
+}
+
+TEST_F(UT_VNoteJournal, UT_VNoteJournal_append_001)
+{
+    QTemporaryDir dir;
+    VNoteJournal journal;
+    journal.m_journalDir = dir.path();
+    journal.append(2, makeDelta(true, 0, 0, QStringList() << "a"));
+    journal.append(2, makeDelta(false, 1, 0, QStringList() << "b"));
+    journal.waitForDone();
+
+    QStringList blocks;
+    EXPECT_TRUE(journal.replay(journal.journalPath(2), 0, blocks));
+    EXPECT_EQ(QStringList() << "a" << "b", blocks);
+
+    journal.remove(2);
+    journal.waitForDone();
+    EXPECT_FALSE(QFile::exists(journal.journalPath(2)));
+}
+
+TEST_F(UT_VNoteJournal, UT_VNoteJournal_compact_001)
+{
+    VNoteJournal journal;
+    journal.compact(1);
+    journal.compact(2);
+    EXPECT_EQ(2, journal.m_compactNotes.size());
+    EXPECT_TRUE(journal.m_compactTimer.isActive());
+
+    //笔记不存在时直接清除
+    EXPECT_TRUE(journal.flushCompaction());
+    EXPECT_TRUE(journal.m_compactNotes.isEmpty());
+    EXPECT_FALSE(journal.m_compactTimer.isActive());
+}
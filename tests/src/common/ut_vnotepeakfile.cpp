@@ -0,0 +1,92 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnotepeakfile.h"
+#include "vnotepeakfile.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+//生成前一半静音、后一半满幅的立体声录音峰值
+static VNotePeakFile makePeakFile(int seconds)
+{
+    VNotePeakFile peakFile;
+    peakFile.reset(44100);
+    QVector<qint16> silence(441 * 2, 0);
+    QVector<qint16> loud(441 * 2);
+    for (int i = 0; i < loud.size(); i++) {
+        loud[i] = (i % 4 < 2) ? 32767 : -32768;
+    }
+    //每段10ms
+    for (int i = 0; i < seconds * 100; i++) {
+        const QVector<qint16> &data = (i < seconds * 50) ? silence : loud;
+        peakFile.appendS16(data.constData(), 441, 2);
+    }
+    return peakFile;
+}
+
+UT_VNotePeakFile::UT_VNotePeakFile()
+{
+}
+
+TEST_F(UT_VNotePeakFile, UT_VNotePeakFile_appendS16_001)
+{
+    VNotePeakFile peakFile = makePeakFile(10);
+    peakFile.finish();
+    EXPECT_EQ(10000, peakFile.duration());
+    //441000帧，每256帧一个峰值，末尾不足一块也保留
+    EXPECT_EQ(1723, peakFile.level(0).size());
+    EXPECT_GT(peakFile.levelCount(), 1);
+    EXPECT_EQ(0, peakFile.level(0).first().max);
+    EXPECT_EQ(127, peakFile.level(0).last().max);
+    EXPECT_EQ(-128, peakFile.level(0).last().min);
+    //上层峰值数为下层的1/8
+    EXPECT_EQ((peakFile.level(0).size() + 7) / 8, peakFile.level(1).size());
+}
+
+TEST_F(UT_VNotePeakFile, UT_VNotePeakFile_save_001)
+{
+    QTemporaryDir dir;
+    QString voicePath = dir.path() + "/test.mp3";
+    VNotePeakFile peakFile = makePeakFile(4);
+    EXPECT_TRUE(peakFile.save(VNotePeakFile::peakPath(voicePath)));
+
+    VNotePeakFile loaded;
+    EXPECT_TRUE(loaded.load(VNotePeakFile::peakPath(voicePath)));
+    EXPECT_EQ(peakFile.duration(), loaded.duration());
+    EXPECT_EQ(peakFile.levelCount(), loaded.levelCount());
+    EXPECT_EQ(peakFile.level(0).size(), loaded.level(0).size());
+
+    //改名后峰值文件随之改名
+    QString newPath = dir.path() + "/hash.mp3";
+    VNotePeakFile::movePeakFile(voicePath, newPath);
+    EXPECT_FALSE(QFile::exists(VNotePeakFile::peakPath(voicePath)));
+    EXPECT_TRUE(QFile::exists(VNotePeakFile::peakPath(newPath)));
+
+    //损坏的文件
+    QFile file(VNotePeakFile::peakPath(newPath));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("broken");
+    file.close();
+    EXPECT_FALSE(loaded.load(VNotePeakFile::peakPath(newPath)));
+    EXPECT_FALSE(VNotePeakFile().save(VNotePeakFile::peakPath(newPath)));
+}
+
+TEST_F(UT_VNotePeakFile, UT_VNotePeakFile_peaks_001)
+{
+    VNotePeakFile peakFile = makePeakFile(60);
+    peakFile.finish();
+
+    QVector<VNotePeak> peaks = peakFile.peaks(0, peakFile.duration(), 100);
+    ASSERT_EQ(100, peaks.size());
+    EXPECT_EQ(0, peaks.at(10).max);
+    EXPECT_EQ(127, peaks.at(90).max);
+    EXPECT_EQ(-128, peaks.at(90).min);
+
+    //超出录音的部分为0
+    peaks = peakFile.peaks(peakFile.duration(), peakFile.duration() * 2, 10);
+    EXPECT_EQ(0, peaks.last().max);
+    EXPECT_TRUE(VNotePeakFile().peaks(0, 1000, 10).size() == 10);
+}
@@ -0,0 +1,46 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnoterecordprofile.h"
+#include "vnoterecordprofile.h"
+
+UT_VNoteRecordProfile::UT_VNoteRecordProfile()
+{
+}
+
+TEST_F(UT_VNoteRecordProfile, UT_VNoteRecordProfile_fromCodec_001)
+{
+    VNoteRecordProfile mp3 = VNoteRecordProfile::fromCodec(VNoteRecordProfile::Mp3);
+    EXPECT_EQ("mp3", mp3.suffix);
+    EXPECT_EQ(192, mp3.bitrate);
+    EXPECT_TRUE(mp3.streamable);
+
+    VNoteRecordProfile opus = VNoteRecordProfile::fromCodec(VNoteRecordProfile::Opus);
+    EXPECT_EQ("ogg", opus.suffix);
+    EXPECT_EQ(48000, opus.sampleRate);
+    EXPECT_EQ(1, opus.channels);
+    EXPECT_FALSE(opus.streamable);
+
+    VNoteRecordProfile flac = VNoteRecordProfile::fromCodec(VNoteRecordProfile::Flac);
+    EXPECT_EQ(0, flac.bitrate);
+
+    //无效设置使用mp3
+    EXPECT_EQ(VNoteRecordProfile::Mp3, VNoteRecordProfile::fromCodec(-1).codec);
+    EXPECT_EQ(VNoteRecordProfile::Mp3, VNoteRecordProfile::fromCodec(VNoteRecordProfile::CodecCount).codec);
+}
+
+TEST_F(UT_VNoteRecordProfile, UT_VNoteRecordProfile_voiceFilters_001)
+{
+    QStringList filters = VNoteRecordProfile::voiceFilters();
+    EXPECT_EQ(static_cast<int>(VNoteRecordProfile::CodecCount), filters.size());
+    EXPECT_TRUE(filters.contains("*.mp3"));
+    EXPECT_TRUE(filters.contains("*.flac"));
+}
+
+TEST_F(UT_VNoteRecordProfile, UT_VNoteRecordProfile_pipeline_001)
+{
+    VNoteRecordProfile opus = VNoteRecordProfile::fromCodec(VNoteRecordProfile::Opus);
+    EXPECT_TRUE(opus.pipeline().startsWith("capsfilter caps=audio/x-raw,format=S16LE,rate=48000,channels=1 ! opusenc"));
+}
@@ -0,0 +1,160 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnoterecordsession.h"
+#include "vnoterecordsession.h"
+#include "vnotedatamanager.h"
+#include "vnoteitem.h"
+#include "stub.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+static VNoteItem g_sessionNote;
+
+static VNoteItem *stub_findNote()
+{
+    return &g_sessionNote;
+}
+
+//按分段文件名模板写入分段
+static void writeSegment(const QString &location, int index, const QByteArray &data)
+{
+    QFile file(QString::asprintf(location.toLatin1().constData(), index));
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(data);
+    }
+}
+
+UT_VNoteRecordSession::UT_VNoteRecordSession()
+{
+}
+
+TEST_F(UT_VNoteRecordSession, UT_VNoteRecordSession_finish_001)
+{
+    QTemporaryDir dir;
+    QString outputPath = dir.path() + "/20000101000001.mp3";
+    QString location = VNoteRecordSession::begin(outputPath, 192);
+    ASSERT_FALSE(location.isEmpty());
+    EXPECT_TRUE(QDir(VNoteRecordSession::sessionDir(outputPath)).exists());
+
+    //序号超过9时仍按录制顺序合并
+    for (int i = 0; i < 12; i++) {
+        writeSegment(location, i, QByteArray(1, static_cast<char>('a' + i)));
+    }
+    EXPECT_EQ(12, VNoteRecordSession::segments(VNoteRecordSession::sessionDir(outputPath)).size());
+    EXPECT_TRUE(VNoteRecordSession::finish(outputPath));
+
+    QFile output(outputPath);
+    ASSERT_TRUE(output.open(QIODevice::ReadOnly));
+    EXPECT_EQ(QByteArray("abcdefghijkl"), output.readAll());
+    EXPECT_FALSE(QDir(VNoteRecordSession::sessionDir(outputPath)).exists());
+}
+
+TEST_F(UT_VNoteRecordSession, UT_VNoteRecordSession_finish_002)
+{
+    QTemporaryDir dir;
+    QString outputPath = dir.path() + "/20000101000002.mp3";
+    ASSERT_FALSE(VNoteRecordSession::begin(outputPath, 192).isEmpty());
+    //没有录到数据时不生成录音文件
+    EXPECT_FALSE(VNoteRecordSession::finish(outputPath));
+    EXPECT_FALSE(QFile::exists(outputPath));
+    EXPECT_FALSE(QDir(VNoteRecordSession::sessionDir(outputPath)).exists());
+}
+
+TEST_F(UT_VNoteRecordSession, UT_VNoteRecordSession_finish_003)
+{
+    QTemporaryDir dir;
+    QString outputPath = dir.path() + "/20000101000003.ogg";
+    QString location = VNoteRecordSession::begin(outputPath, 0);
+    ASSERT_FALSE(location.isEmpty());
+    //只有一个分段时直接移动，不在同一文件系统时复制
+    writeSegment(location, 0, QByteArray("ogg"));
+    EXPECT_TRUE(VNoteRecordSession::finish(outputPath));
+
+    QFile output(outputPath);
+    ASSERT_TRUE(output.open(QIODevice::ReadOnly));
+    EXPECT_EQ(QByteArray("ogg"), output.readAll());
+    EXPECT_FALSE(QDir(VNoteRecordSession::sessionDir(outputPath)).exists());
+}
+
+TEST_F(UT_VNoteRecordSession, UT_VNoteRecordSession_estimateDuration_001)
+{
+    //192kbps每秒24000字节
+    EXPECT_EQ(1000, VNoteRecordSession::estimateDuration(24000, 192));
+    EXPECT_EQ(0, VNoteRecordSession::estimateDuration(0, 192));
+    //无损编码无法估算
+    EXPECT_EQ(0, VNoteRecordSession::estimateDuration(24000, 0));
+}
+
+TEST_F(UT_VNoteRecordSession, UT_VNoteRecordSession_recover_001)
+{
+    QTemporaryDir dir;
+    QString outputPath = dir.path() + "/20000101000003.mp3";
+    QString location = VNoteRecordSession::begin(outputPath, 192);
+    ASSERT_FALSE(location.isEmpty());
+    writeSegment(location, 0, QByteArray(24000, 'a'));
+    writeSegment(location, 1, QByteArray(24000, 'b'));
+    g_sessionNote.noteId = 1000;
+    EXPECT_TRUE(VNoteRecordSession::setNoteId(outputPath, g_sessionNote.noteId));
+
+    Stub stub;
+    stub.set(ADDR(VNoteDataManager, findNote), stub_findNote);
+    EXPECT_GE(VNoteRecordSession::recover(), 1);
+    //其他笔记不插入
+    EXPECT_FALSE(VNoteRecordSession::hasRecovered(g_sessionNote.noteId + 1));
+    EXPECT_TRUE(VNoteRecordSession::finishRecovered(g_sessionNote.noteId + 1).isEmpty());
+    EXPECT_TRUE(VNoteRecordSession::hasRecovered(g_sessionNote.noteId));
+
+    QList<VNoteRecordSession::Recovered> recovered = VNoteRecordSession::finishRecovered(g_sessionNote.noteId);
+    ASSERT_EQ(1, recovered.size());
+    EXPECT_EQ(outputPath, recovered.first().path);
+    EXPECT_EQ(2000, recovered.first().duration);
+    EXPECT_EQ(48000, QFileInfo(outputPath).size());
+    //插入笔记前会话保留，可以再次合并
+    EXPECT_TRUE(QDir(VNoteRecordSession::sessionDir(outputPath)).exists());
+    EXPECT_EQ(1, VNoteRecordSession::finishRecovered(g_sessionNote.noteId).size());
+
+    VNoteRecordSession::discard(outputPath);
+    EXPECT_FALSE(QDir(VNoteRecordSession::sessionDir(outputPath)).exists());
+    EXPECT_FALSE(VNoteRecordSession::hasRecovered(g_sessionNote.noteId));
+}
+
+TEST_F(UT_VNoteRecordSession, UT_VNoteRecordSession_recover_002)
+{
+    QTemporaryDir dir;
+    QString outputPath = dir.path() + "/20000101000004.mp3";
+    QString location = VNoteRecordSession::begin(outputPath, 192);
+    ASSERT_FALSE(location.isEmpty());
+    writeSegment(location, 0, QByteArray(100, 'a'));
+
+    //录音过短时直接删除
+    Stub stub;
+    stub.set(ADDR(VNoteDataManager, findNote), stub_findNote);
+    VNoteRecordSession::recover();
+    EXPECT_FALSE(QDir(VNoteRecordSession::sessionDir(outputPath)).exists());
+}
+
+TEST_F(UT_VNoteRecordSession, UT_VNoteRecordSession_recover_003)
+{
+    QTemporaryDir dir;
+    QString outputPath = dir.path() + "/20000101000005.flac";
+    QString location = VNoteRecordSession::begin(outputPath, 0);
+    ASSERT_TRUE(location.endsWith(".flac"));
+    writeSegment(location, 0, QByteArray(100, 'a'));
+    g_sessionNote.noteId = 1001;
+    VNoteRecordSession::setNoteId(outputPath, g_sessionNote.noteId);
+    //无损编码按最后记录的时长恢复
+    VNoteRecordSession::setDuration(outputPath, 30000);
+
+    Stub stub;
+    stub.set(ADDR(VNoteDataManager, findNote), stub_findNote);
+    VNoteRecordSession::recover();
+    QList<VNoteRecordSession::Recovered> recovered = VNoteRecordSession::finishRecovered(g_sessionNote.noteId);
+    ASSERT_EQ(1, recovered.size());
+    EXPECT_EQ(30000, recovered.first().duration);
+    VNoteRecordSession::discard(outputPath);
+}
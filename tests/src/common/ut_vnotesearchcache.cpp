@@ -0,0 +1,52 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnotesearchcache.h"
+#include "vnotesearchcache.h"
+#include "vnotedatamanager.h"
+
+UT_VNoteSearchCache::UT_VNoteSearchCache()
+{
+}
+
+TEST_F(UT_VNoteSearchCache, UT_VNoteSearchCache_find_001)
+{
+    VNoteSearchCache cache;
+    QVector<qint32> ids;
+    EXPECT_FALSE(cache.find("key", 1, ids));
+
+    cache.insert("key", 1, QVector<qint32>() << 1 << 3);
+    EXPECT_TRUE(cache.find("key", 1, ids));
+    EXPECT_EQ(QVector<qint32>() << 1 << 3, ids);
+
+    //数据版本变化后缓存失效
+    EXPECT_FALSE(cache.find("key", 2, ids));
+    EXPECT_FALSE(cache.find("key", 1, ids));
+}
+
+TEST_F(UT_VNoteSearchCache, UT_VNoteSearchCache_insert_001)
+{
+    VNoteSearchCache cache(2);
+    QVector<qint32> ids;
+    cache.insert("a", 1, QVector<qint32>() << 1);
+    cache.insert("b", 1, QVector<qint32>() << 2);
+    //访问a后，b为最近最少使用
+    EXPECT_TRUE(cache.find("a", 1, ids));
+    cache.insert("c", 1, QVector<qint32>() << 3);
+    EXPECT_TRUE(cache.find("a", 1, ids));
+    EXPECT_FALSE(cache.find("b", 1, ids));
+    EXPECT_TRUE(cache.find("c", 1, ids));
+
+    cache.clear();
+    EXPECT_FALSE(cache.find("a", 1, ids));
+}
+
+TEST_F(UT_VNoteSearchCache, UT_VNoteSearchCache_dataVersion_001)
+{
+    VNoteDataManager dataManager;
+    int version = dataManager.dataVersion();
+    dataManager.increaseDataVersion();
+    EXPECT_EQ(version + 1, dataManager.dataVersion());
+}
@@ -0,0 +1,100 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnotesearchindex.h"
+#include "vnotesearchindex.h"
+#include "vnotetextextractor.h"
+#include "vnoteitem.h"
+
+static const QString voiceHtml =
+    "<p>text</p><div class=\"li voiceBox\" contenteditable=\"false\" jsonkey=\"{&quot;createTime&quot;:&quot;2021-01-01 10:00:00.000&quot;,"
+    "&quot;state&quot;:true,&quot;text&quot;:&quot;Hello Deepin&quot;,&quot;title&quot;:&quot;voice&quot;,&quot;type&quot;:2,"
+    "&quot;voicePath&quot;:&quot;/tmp/voicenote/1.mp3&quot;,&quot;voiceSize&quot;:1000}\"></div>"
+    "<p><img src=\"/tmp/images/1.png\"></p>";
+
+UT_VNoteSearchIndex::UT_VNoteSearchIndex()
+{
+}
+
+TEST_F(UT_VNoteSearchIndex, UT_VNoteSearchIndex_collectItems_001)
+{
+    VNoteItem note;
+    note.htmlCode = voiceHtml;
+    QList<VNoteExtractItem> items = VNoteSearchIndex::collectItems(&note);
+    ASSERT_EQ(2, items.size());
+    EXPECT_EQ(VNoteExtractItem::Voice, items.at(0).type);
+    EXPECT_EQ("/tmp/voicenote/1.mp3", items.at(0).path);
+    EXPECT_EQ("Hello Deepin", items.at(0).hint);
+    EXPECT_EQ(VNoteExtractItem::Image, items.at(1).type);
+    EXPECT_EQ("/tmp/images/1.png", items.at(1).path);
+    EXPECT_TRUE(VNoteSearchIndex::collectItems(nullptr).isEmpty());
+}
+
+TEST_F(UT_VNoteSearchIndex, UT_VNoteSearchIndex_search_001)
+{
+    VNoteSearchIndex index;
+    index.registerExtractor(new VNoteVoiceTextExtractor);
+    VNoteItem note;
+    note.noteId = 1;
+    note.htmlCode = voiceHtml;
+    index.scheduleNote(&note, VNoteSearchIndex::High);
+    index.waitForDone();
+    EXPECT_TRUE(index.search(&note, "deepin"));
+    EXPECT_FALSE(index.search(&note, "uos"));
+    EXPECT_EQ("Hello Deepin", index.extractedText("/tmp/voicenote/1.mp3"));
+
+    index.removeNote(note.noteId);
+    EXPECT_FALSE(index.search(&note, "deepin"));
+}
+
+TEST_F(UT_VNoteSearchIndex, UT_VNoteSearchIndex_removeNote_001)
+{
+    VNoteSearchIndex index;
+    index.registerExtractor(new VNoteVoiceTextExtractor);
+    VNoteItem note;
+    note.noteId = 1;
+    note.htmlCode = voiceHtml;
+    VNoteItem copyNote;
+    copyNote.noteId = 2;
+    copyNote.htmlCode = voiceHtml;
+    index.scheduleNote(&note, VNoteSearchIndex::High);
+    index.scheduleNote(&copyNote, VNoteSearchIndex::High);
+    index.waitForDone();
+
+    //其他笔记仍引用同一附件时保留文本
+    index.removeNote(note.noteId);
+    EXPECT_TRUE(index.search(&copyNote, "deepin"));
+    index.removeNote(copyNote.noteId);
+    EXPECT_TRUE(index.extractedText("/tmp/voicenote/1.mp3").isEmpty());
+}
+
+TEST_F(UT_VNoteSearchIndex, UT_VNoteSearchIndex_takeBatch_001)
+{
+    VNoteSearchIndex index;
+    VNoteItem note;
+    note.noteId = 2;
+    note.htmlCode = voiceHtml;
+    //不启动后台任务，直接检查队列优先级
+    index.enqueue(note.noteId, VNoteSearchIndex::collectItems(&note), VNoteSearchIndex::Low);
+    note.htmlCode = "<p><img src=\"/tmp/images/2.png\"></p>";
+    index.enqueue(note.noteId, VNoteSearchIndex::collectItems(&note), VNoteSearchIndex::High);
+    QList<VNoteExtractItem> batch = index.takeBatch(1);
+    ASSERT_EQ(1, batch.size());
+    EXPECT_EQ("/tmp/images/2.png", batch.at(0).path);
+    EXPECT_EQ(2, index.takeBatch(8).size());
+    EXPECT_TRUE(index.takeBatch(8).isEmpty());
+    EXPECT_FALSE(index.m_workerRunning);
+}
+
+TEST_F(UT_VNoteSearchIndex, UT_VNoteSearchIndex_ocrExtract_001)
+{
+    VNoteOcrTextExtractor extractor("deepin-voice-note-no-such-ocr");
+    VNoteExtractItem item;
+    item.type = VNoteExtractItem::Image;
+    item.path = "/tmp/images/1.png";
+    EXPECT_FALSE(extractor.isAvailable());
+    EXPECT_FALSE(extractor.canExtract(item));
+    EXPECT_TRUE(extractor.extract(item).isEmpty());
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnotevoiceactivity.h"
+#include "vnotevoiceactivity.h"
+
+UT_VNoteVoiceActivity::UT_VNoteVoiceActivity()
+{
+}
+
+//每段100毫秒，返回写入录音的段数
+static int processLevels(VNoteVoiceActivity &activity, float rms, int count)
+{
+    VNoteAudioLevels levels;
+    levels.count = 1;
+    levels.peak[0] = rms;
+    levels.rms[0] = rms;
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (activity.process(levels, 4410, 44100)) {
+            kept++;
+        }
+    }
+    return kept;
+}
+
+TEST_F(UT_VNoteVoiceActivity, UT_VNoteVoiceActivity_process_001)
+{
+    VNoteVoiceActivity activity;
+    activity.reset(VNoteVoiceActivity::KeepSilence);
+    EXPECT_EQ(10, processLevels(activity, 0.001f, 10));
+    EXPECT_EQ(10, processLevels(activity, 0.3f, 10));
+    EXPECT_EQ(20, processLevels(activity, 0.001f, 20));
+    EXPECT_EQ(0, activity.removedDuration());
+
+    VNOTE_SPEECH_SEGMENTS segments = activity.speechSegments();
+    ASSERT_EQ(1, segments.size());
+    EXPECT_EQ(1000, segments.at(0).first);
+    EXPECT_EQ(2300, segments.at(0).second);
+}
+
+TEST_F(UT_VNoteVoiceActivity, UT_VNoteVoiceActivity_process_002)
+{
+    VNoteVoiceActivity activity;
+    activity.reset(VNoteVoiceActivity::RemoveSilence);
+    //开头和语音后各保留1秒静音
+    EXPECT_EQ(10, processLevels(activity, 0.001f, 30));
+    EXPECT_EQ(10, processLevels(activity, 0.3f, 10));
+    EXPECT_EQ(10, processLevels(activity, 0.001f, 20));
+    EXPECT_EQ(Q_INT64_C(3000) * 1000 * 1000, activity.removedDuration());
+
+    //语音段为去除静音后的时间
+    VNOTE_SPEECH_SEGMENTS segments = activity.speechSegments();
+    ASSERT_EQ(1, segments.size());
+    EXPECT_EQ(1000, segments.at(0).first);
+    EXPECT_EQ(2300, segments.at(0).second);
+
+    activity.reset(VNoteVoiceActivity::RemoveSilence);
+    EXPECT_EQ(0, activity.removedDuration());
+    EXPECT_TRUE(activity.speechSegments().isEmpty());
+}
+
+TEST_F(UT_VNoteVoiceActivity, UT_VNoteVoiceActivity_skipSilence_001)
+{
+    VNOTE_SPEECH_SEGMENTS segments;
+    segments.append(qMakePair(Q_INT64_C(1000), Q_INT64_C(2000)));
+    segments.append(qMakePair(Q_INT64_C(5000), Q_INT64_C(6000)));
+    EXPECT_EQ(800, VNoteVoiceActivity::skipSilence(segments, 0));
+    //距离语音段太近时不跳转
+    EXPECT_EQ(-1, VNoteVoiceActivity::skipSilence(segments, 700));
+    EXPECT_EQ(-1, VNoteVoiceActivity::skipSilence(segments, 1500));
+    EXPECT_EQ(4800, VNoteVoiceActivity::skipSilence(segments, 2500));
+    EXPECT_EQ(-1, VNoteVoiceActivity::skipSilence(segments, 7000));
+    EXPECT_EQ(-1, VNoteVoiceActivity::skipSilence(VNOTE_SPEECH_SEGMENTS(), 0));
+}
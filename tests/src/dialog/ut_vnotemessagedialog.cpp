@@ -47,13 +47,6 @@ TEST_F(UT_VNoteMessageDialog, UT_VNoteMessageDialog_initMessage_001)
               vnotemessagedialog.m_pMessage->text())
         << "m_msgType is AbortRecord, m_pMessage->text";
 
-    vnotemessagedialog.m_msgType = vnotemessagedialog.AsrTimeLimit;
-    vnotemessagedialog.initMessage();
-    EXPECT_EQ(DApplication::translate("VNoteMessageDialog",
-                                      "Cannot convert this voice note, as notes over 20 minutes are not supported at present."),
-              vnotemessagedialog.m_pMessage->text())
-        << "m_msgType is AsrTimeLimit, m_pMessage->text";
-
     vnotemessagedialog.m_msgType = vnotemessagedialog.AborteAsr;
     vnotemessagedialog.initMessage();
     EXPECT_EQ(DApplication::translate("VNoteMessageDialog", "Converting a voice note now. Do you want to stop it?"),
@@ -0,0 +1,80 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_imageinsertworker.h"
+#include "imageinsertworker.h"
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+UT_ImageInsertWorker::UT_ImageInsertWorker()
+{
+}
+
+TEST_F(UT_ImageInsertWorker, UT_ImageInsertWorker_run_001)
+{
+    QTemporaryDir dir;
+    QString srcPath = dir.path() + "/test.png";
+    QImage image(800, 400, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    ASSERT_TRUE(image.save(srcPath));
+
+    //超过最大尺寸时缩小
+    ImageInsertWorker worker("1", srcPath);
+    VNoteImagePolicy policy;
+    policy.maxSize = 200;
+    worker.setPolicy(policy);
+    QSignalSpy spy(&worker, &ImageInsertWorker::imageInserted);
+    worker.run();
+    ASSERT_EQ(1, spy.count());
+    EXPECT_EQ(QString("1"), spy.at(0).at(0).toString());
+    QString path = spy.at(0).at(1).toString();
+    EXPECT_EQ(QSize(200, 100), QImage(path).size());
+    EXPECT_TRUE(spy.at(0).at(2).toString().isEmpty());
+    QFile::remove(path);
+}
+
+TEST_F(UT_ImageInsertWorker, UT_ImageInsertWorker_run_002)
+{
+    QImage image(100, 50, QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+    ImageInsertWorker worker("2", image);
+    QSignalSpy spy(&worker, &ImageInsertWorker::imageInserted);
+    worker.run();
+    ASSERT_EQ(1, spy.count());
+    QString path = spy.at(0).at(1).toString();
+    EXPECT_TRUE(path.endsWith(".png"));
+    EXPECT_EQ(QSize(100, 50), QImage(path).size());
+    QFile::remove(path);
+
+    //无效文件返回空路径
+    ImageInsertWorker invalidWorker("3", QString("/tmp/none.png"));
+    QSignalSpy invalidSpy(&invalidWorker, &ImageInsertWorker::imageInserted);
+    invalidWorker.run();
+    ASSERT_EQ(1, invalidSpy.count());
+    EXPECT_TRUE(invalidSpy.at(0).at(1).toString().isEmpty());
+}
+
+TEST_F(UT_ImageInsertWorker, UT_ImageInsertWorker_run_003)
+{
+    //重新编码时保存原图
+    QImage image(64, 64, QImage::Format_RGB32);
+    image.fill(Qt::green);
+    ImageInsertWorker worker("4", image);
+    VNoteImagePolicy policy;
+    policy.maxSize = 32;
+    policy.keepOriginal = true;
+    worker.setPolicy(policy);
+    QSignalSpy spy(&worker, &ImageInsertWorker::imageInserted);
+    worker.run();
+    ASSERT_EQ(1, spy.count());
+    QString path = spy.at(0).at(1).toString();
+    QString originalPath = spy.at(0).at(2).toString();
+    EXPECT_EQ(QSize(32, 32), QImage(path).size());
+    EXPECT_EQ(QSize(64, 64), QImage(originalPath).size());
+    QFile::remove(path);
+    QFile::remove(originalPath);
+}
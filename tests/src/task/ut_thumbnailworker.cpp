@@ -0,0 +1,54 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_thumbnailworker.h"
+#include "thumbnailworker.h"
+#include "common/vnotethumbnailhandler.h"
+
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+UT_ThumbnailWorker::UT_ThumbnailWorker()
+{
+}
+
+TEST_F(UT_ThumbnailWorker, UT_ThumbnailWorker_loadScaled_001)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/test.png";
+    QImage image(800, 400, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    ASSERT_TRUE(image.save(path));
+
+    //只缩小不放大
+    EXPECT_EQ(QSize(200, 100), ThumbnailWorker::loadScaled(path, 200).size());
+    EXPECT_EQ(QSize(800, 400), ThumbnailWorker::loadScaled(path, 1600).size());
+    EXPECT_TRUE(ThumbnailWorker::loadScaled(dir.path() + "/none.png", 200).isNull());
+}
+
+TEST_F(UT_ThumbnailWorker, UT_ThumbnailWorker_run_001)
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/test.png";
+    QImage image(800, 400, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+    ASSERT_TRUE(image.save(path));
+
+    ThumbnailWorker worker(1, path, 256);
+    QSignalSpy spy(&worker, &ThumbnailWorker::thumbnailReady);
+    worker.run();
+    ASSERT_EQ(1, spy.count());
+    EXPECT_EQ(QByteArray("image/jpeg"), spy.at(0).at(2).toByteArray());
+    EXPECT_EQ(QSize(256, 128), QImage::fromData(spy.at(0).at(1).toByteArray()).size());
+}
+
+TEST_F(UT_ThumbnailWorker, UT_ThumbnailWorker_isAllowedPath_001)
+{
+    VNoteThumbnailHandler handler;
+    QString imageDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/images";
+    EXPECT_FALSE(handler.isAllowedPath("/etc/passwd"));
+    EXPECT_FALSE(handler.isAllowedPath(imageDir + "/../../../etc/passwd"));
+}
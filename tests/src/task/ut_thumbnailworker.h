@@ -0,0 +1,21 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef UT_THUMBNAILWORKER_H
+#define UT_THUMBNAILWORKER_H
+
+#include "gtest/gtest.h"
+#include <QTest>
+#include <QObject>
+
+class UT_ThumbnailWorker : public QObject
+    , public ::testing::Test
+{
+    Q_OBJECT
+public:
+    UT_ThumbnailWorker();
+};
+
+#endif // UT_THUMBNAILWORKER_H
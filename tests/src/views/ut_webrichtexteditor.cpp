@@ -9,11 +9,18 @@
 #include "dialog/vnotemessagedialog.h"
 #include "common/actionmanager.h"
 #include "common/vtextspeechandtrmanager.h"
+#include "db/vnoteitemoper.h"
+#include "common/vnotedatamanager.h"
+#include "common/vnotejournal.h"
+#include "common/vnoterecordsession.h"
 
 #include <DFileDialog>
 
 #include <QClipboard>
+#include <QDir>
 #include <QMimeData>
+#include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QWebEngineContextMenuData>
 
 static QWebChannel *webchannel;
@@ -32,6 +39,31 @@ static QVariant stub_callJsSynchronous()
     return QVariant("");
 }
 
+static int stub_callJsAsync(void *obj, QWebEnginePage *page, const QString &funtion, const JsContent::JsCallback &callback, int timeout)
+{
+    Q_UNUSED(obj)
+    Q_UNUSED(page)
+    Q_UNUSED(funtion)
+    Q_UNUSED(timeout)
+    callback(QVariant(""));
+    return 1;
+}
+
+static int g_asyncCount = 0;
+
+static int stub_callJsAsyncCount(void *obj, QWebEnginePage *page, const QString &funtion, const JsContent::JsCallback &callback, int timeout)
+{
+    g_asyncCount++;
+    return stub_callJsAsync(obj, page, funtion, callback, timeout);
+}
+
+static VNoteItem g_deltaNote;
+
+static VNoteItem *stub_findNote()
+{
+    return &g_deltaNote;
+}
+
 static QVariant stub_imageVariant()
 {
     return QVariant(QImage());
@@ -62,16 +94,6 @@ void stub_WebRichTextEditor_setWebChannel(QWebChannel *channel)
     webchannel = channel;
 }
 
-bool stub_isVoicePaste()
-{
-    return false;
-}
-
-static void stub_findText(const QString &subString, QWebEnginePage::FindFlags options, const QWebEngineCallback<bool> &resultCallback) {
-    Q_UNUSED(subString)
-        Q_UNUSED(options)
-            Q_UNUSED(resultCallback)}
-
 QWebEnginePage *UT_WebRichTextEditor::stub_page()
 {
     return (QWebEnginePage *)this;
@@ -156,23 +178,144 @@ TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_insertVoiceItem_001)
 }
 
 TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_updateNote_001)
+{
+    Stub stub;
+    stub.set(ADDR(QWebEngineView, page), stub_WebRichTextEditor_page);
+    stub.set(ADDR(JsContent, callJsAsync), stub_callJsAsync);
+
+    VNoteItem *note = new VNoteItem();
+    m_web->m_textChange = true;
+    m_web->m_noteData = note;
+    bool finished = false;
+    m_web->updateNote([&finished] {
+        finished = true;
+    });
+    EXPECT_TRUE(finished);
+    //返回内容无效，下次定时更新时重试
+    EXPECT_TRUE(m_web->m_textChange);
+    EXPECT_TRUE(m_web->m_autosave->isDirty());
+    EXPECT_FALSE(m_web->m_updatePending);
+
+    //有未完成的请求时，回调在请求完成后执行
+    finished = false;
+    m_web->m_updatePending = true;
+    m_web->updateNote([&finished] {
+        finished = true;
+    });
+    EXPECT_FALSE(finished);
+    m_web->m_updatePending = false;
+    m_web->runUpdateCallbacks();
+    EXPECT_TRUE(finished);
+
+    m_web->m_noteData = nullptr;
+    delete note;
+}
+
+TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_applyNoteDelta_001)
+{
+    Stub stub;
+    stub.set(ADDR(VNoteDataManager, findNote), stub_findNote);
+    stub.set(ADDR(VNoteJournal, append), stub_WebRichTextEditor);
+    stub.set(ADDR(VNoteJournal, remove), stub_WebRichTextEditor);
+    stub.set(ADDR(VNoteJournal, compact), stub_WebRichTextEditor);
+
+    m_web->resetBlocks(g_deltaNote.noteId);
+    EXPECT_TRUE(m_web->applyNoteDelta(g_deltaNote.noteId, QVariant("{\"version\":1,\"reset\":true,\"blocks\":[\"<p>a</p>\",\"<p>b</p>\"]}")));
+    EXPECT_EQ(1, m_web->m_blockVersion);
+    EXPECT_EQ(QString("<p>a</p><p>b</p>"), g_deltaNote.htmlCode);
+    EXPECT_EQ(1, m_web->m_journalCount);
+
+    EXPECT_TRUE(m_web->applyNoteDelta(g_deltaNote.noteId, QVariant("{\"version\":2,\"start\":1,\"remove\":1,\"blocks\":[\"<p>c</p>\"]}")));
+    EXPECT_EQ(QString("<p>a</p><p>c</p>"), g_deltaNote.htmlCode);
+    EXPECT_EQ(2, m_web->m_journalCount);
+
+    //版本不连续时下次获取全量
+    EXPECT_FALSE(m_web->applyNoteDelta(g_deltaNote.noteId, QVariant("{\"version\":5,\"start\":0,\"remove\":0,\"blocks\":[]}")));
+    EXPECT_EQ(-1, m_web->m_blockVersion);
+
+    //合并后日志清空
+    m_web->compactNote();
+    EXPECT_EQ(0, m_web->m_journalCount);
+    m_web->resetBlocks(-1);
+}
+
+TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_sendPreloadNotes_001)
+{
+    Stub stub;
+    stub.set(ADDR(VNoteDataManager, findNote), stub_findNote);
+    QSignalSpy spy(JsContent::instance(), &JsContent::callJsPreloadNote);
+
+    g_deltaNote.htmlCode = "<p>preload</p>";
+    m_web->m_loadFinshSign = true;
+    m_web->setPreloadNotes(QList<qint32>() << g_deltaNote.noteId);
+    m_web->sendPreloadNotes();
+    EXPECT_EQ(1, spy.count());
+    EXPECT_EQ(WebRichTextEditor::pageRevision(&g_deltaNote), m_web->m_preloadRevs.value(g_deltaNote.noteId));
+
+    //内容未变化时不重复发送
+    m_web->sendPreloadNotes();
+    EXPECT_EQ(1, spy.count());
+
+    //内容变化后重新发送
+    g_deltaNote.htmlCode = "<p>changed</p>";
+    m_web->sendPreloadNotes();
+    EXPECT_EQ(2, spy.count());
+
+    m_web->setPreloadNotes(QList<qint32>());
+    m_web->m_preloadRevs.clear();
+}
+
+TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_flushNote_001)
 {
     Stub stub;
     stub.set(ADDR(QWebEngineView, page), stub_WebRichTextEditor_page);
     stub.set(ADDR(JsContent, callJsSynchronous), stub_callJsSynchronous);
+    stub.set(ADDR(VNoteItemOper, updateNote), stub_int);
 
     VNoteItem *note = new VNoteItem();
     m_web->m_textChange = true;
     m_web->m_noteData = note;
-    m_web->updateNote();
+    m_web->flushNote();
+    EXPECT_FALSE(m_web->m_textChange);
+    m_web->m_noteData = nullptr;
     delete note;
 }
 
 TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_searchText_001)
 {
-    Stub stub;
-    stub.set(ADDR(QWebEngineView, findText), stub_findText);
+    QSignalSpy spy(m_web, &WebRichTextEditor::currentSearchEmpty);
+    m_web->m_noteData = nullptr;
+    m_web->searchText("a");
+    EXPECT_EQ(1, spy.count());
+
+    VNoteItem *note = new VNoteItem();
+    note->noteTitle = "abc";
+    m_web->m_noteData = note;
+    m_web->m_textChange = false;
     m_web->searchText("a");
+    EXPECT_EQ(1, spy.count());
+    EXPECT_EQ("a", m_web->m_highlightKey);
+
+    //相同关键字只定位下一个
+    QSignalSpy nextSpy(JsContent::instance(), &JsContent::callJsSearchNext);
+    m_web->onSearchFinish(2);
+    m_web->searchText("a");
+    EXPECT_EQ(1, nextSpy.count());
+
+    m_web->m_noteData = nullptr;
+    delete note;
+}
+
+TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_highlightSearchText_001)
+{
+    QSignalSpy searchSpy(JsContent::instance(), &JsContent::callJsSearchText);
+    QSignalSpy clearSpy(JsContent::instance(), &JsContent::callJsClearSearch);
+    m_web->highlightSearchText("a");
+    EXPECT_EQ(1, searchSpy.count());
+    EXPECT_EQ(0, m_web->m_searchHitCount);
+    m_web->highlightSearchText("");
+    EXPECT_EQ(1, clearSpy.count());
+    EXPECT_TRUE(m_web->m_highlightKey.isEmpty());
 }
 
 TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_unboundCurrentNoteData_001)
@@ -282,7 +425,7 @@ TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_onMenuActionClicked_001)
     stub.set(ADDR(QWidget, focusProxy), ADDR(UT_WebRichTextEditor, stub_focusProxy));
     stub.set(ADDR(QFileDialog, getSaveFileName), stub_emptyString);
     stub.set(ADDR(WebRichTextEditor, onPaste), stub_WebRichTextEditor);
-    stub.set(ADDR(WebRichTextEditor, isVoicePaste), stub_isVoicePaste);
+    stub.set(ADDR(JsContent, callJsAsync), stub_callJsAsync);
 
     ActionManager actionManager;
     QAction *pAction = actionManager.getActionById(ActionManager::VoiceAsSave);
@@ -560,7 +703,6 @@ TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_setData_001)
     typedef int (*fptr)();
     fptr A_foo = (fptr)(&QWidget::setVisible);
     stub.set(A_foo, stub_WebRichTextEditor);
-    stub.set(ADDR(QWebEngineView, findText), stub_findText);
 
     VNoteItem *data = new VNoteItem();
 
@@ -585,6 +727,62 @@ TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_setData_001)
     delete data;
 }
 
+TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_switchNote_001)
+{
+    Stub stub;
+    stub.set(ADDR(QWebEngineView, page), stub_WebRichTextEditor_page);
+    stub.set(ADDR(JsContent, callJsAsync), stub_callJsAsyncCount);
+    stub.set(ADDR(VNoteJournal, compact), stub_WebRichTextEditor);
+    stub.set(ADDR(VNoteJournal, flushCompaction), stub_int);
+
+    VNoteItem *oldNote = new VNoteItem();
+    VNoteItem *newNote = new VNoteItem();
+    m_web->m_noteData = oldNote;
+    m_web->m_textChange = true;
+    g_asyncCount = 0;
+    //获取之前笔记内容失败时先重试，重试用完后再切换
+    m_web->switchNote(newNote, 2);
+    EXPECT_EQ(3, g_asyncCount);
+    EXPECT_EQ(newNote, m_web->m_noteData);
+    EXPECT_EQ(nullptr, m_web->m_switchNote);
+
+    //解绑后不再切换
+    m_web->m_noteData = oldNote;
+    m_web->m_updatePending = true;
+    m_web->switchNote(newNote, 2);
+    m_web->unboundCurrentNoteData();
+    m_web->m_noteData = oldNote;
+    m_web->m_updatePending = false;
+    m_web->runUpdateCallbacks();
+    EXPECT_EQ(oldNote, m_web->m_noteData);
+
+    m_web->m_noteData = nullptr;
+    m_web->m_textChange = false;
+    delete oldNote;
+    delete newNote;
+}
+
+TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_onVoiceRecovered_001)
+{
+    QTemporaryDir dir;
+    QString outputPath = dir.path() + "/20000101000010.mp3";
+    ASSERT_FALSE(VNoteRecordSession::begin(outputPath, 192).isEmpty());
+    QSignalSpy appendSpy(JsContent::instance(), &JsContent::callJsAppendVoice);
+
+    VNoteItem note;
+    note.noteId = 1;
+    m_web->m_noteData = &note;
+    //合并期间切换了笔记时保留会话
+    m_web->onVoiceRecovered(2, outputPath, outputPath, 2000, QDateTime::currentDateTime());
+    EXPECT_EQ(0, appendSpy.count());
+    EXPECT_TRUE(QDir(VNoteRecordSession::sessionDir(outputPath)).exists());
+
+    m_web->onVoiceRecovered(1, outputPath, outputPath, 2000, QDateTime::currentDateTime());
+    EXPECT_EQ(1, appendSpy.count());
+    EXPECT_FALSE(QDir(VNoteRecordSession::sessionDir(outputPath)).exists());
+    m_web->m_noteData = nullptr;
+}
+
 TEST_F(UT_WebRichTextEditor, UT_WebRichTextEditor_eventFilter_001)
 {
     QMouseEvent *event = new QMouseEvent(QEvent::MouseButtonRelease, QPoint(0, 0), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
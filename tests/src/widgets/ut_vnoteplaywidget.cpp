@@ -8,6 +8,7 @@
 #include "vnoteitem.h"
 #include "vnote2siconbutton.h"
 #include "utils.h"
+#include "setting.h"
 
 #include <stub.h>
 
@@ -201,3 +202,52 @@ TEST_F(UT_VNotePlayWidget, UT_VNotePlayWidget_playVoice_004)
 {
     m_vnoteplaywidget->playVoice(nullptr, false);
 }
+
+TEST_F(UT_VNotePlayWidget, UT_VNotePlayWidget_playVoices_001)
+{
+    Stub stub;
+    stub.set(ADDR(VlcPalyer, play), stub_void);
+    stub.set(ADDR(VlcPalyer, setFilePath), stub_void);
+    stub.set(ADDR(VlcPalyer, prefetch), stub_void);
+    QList<QSharedPointer<VNVoiceBlock>> voices;
+    for (int i = 0; i < 3; i++) {
+        QSharedPointer<VNVoiceBlock> voice(new VNVoiceBlock);
+        voice->voicePath = QString("/tmp/test%1").arg(i);
+        voice->voiceSize = 2000;
+        voices.append(voice);
+    }
+    m_vnoteplaywidget->playVoices(voices, 1);
+    EXPECT_EQ(1, m_vnoteplaywidget->m_queueIndex);
+    EXPECT_EQ(voices.at(1).get(), m_vnoteplaywidget->m_voiceBlock);
+    EXPECT_EQ(QVector<qint64>({0, 2000, 4000, 6000}), m_vnoteplaywidget->m_queueOffsets);
+
+    m_vnoteplaywidget->onPlayEnd();
+    EXPECT_EQ(2, m_vnoteplaywidget->m_queueIndex);
+    EXPECT_EQ(voices.at(2).get(), m_vnoteplaywidget->m_voiceBlock);
+
+    m_vnoteplaywidget->seekTo(m_vnoteplaywidget->m_slider->maximum() / 6);
+    EXPECT_EQ(0, m_vnoteplaywidget->m_queueIndex);
+    EXPECT_LT(0, m_vnoteplaywidget->m_pendingSeek);
+
+    stub.set(ADDR(VlcPalyer, stop), stub_void);
+    m_vnoteplaywidget->onCloseBtnClicked();
+    EXPECT_TRUE(m_vnoteplaywidget->m_queue.isEmpty());
+    EXPECT_EQ(nullptr, m_vnoteplaywidget->m_voiceBlock);
+}
+
+TEST_F(UT_VNotePlayWidget, UT_VNotePlayWidget_playVoices_002)
+{
+    m_vnoteplaywidget->playVoices(QList<QSharedPointer<VNVoiceBlock>>(), 0);
+    EXPECT_TRUE(m_vnoteplaywidget->m_queue.isEmpty());
+}
+
+TEST_F(UT_VNotePlayWidget, UT_VNotePlayWidget_onSpeedChanged_001)
+{
+    Stub stub;
+    stub.set(ADDR(VlcPalyer, setRate), stub_void);
+    stub.set(ADDR(setting, setOption), stub_void);
+    QAction *action = m_vnoteplaywidget->m_speedMenu->actions().last();
+    m_vnoteplaywidget->onSpeedChanged(action);
+    EXPECT_EQ(action->text(), m_vnoteplaywidget->m_speedBtn->text());
+    EXPECT_EQ(6, m_vnoteplaywidget->m_speedMenu->actions().size());
+}
@@ -8,6 +8,8 @@
 #include "utils.h"
 #include "stub.h"
 
+#include <QSignalSpy>
+
 static bool stub_startRecord()
 {
     return true;
@@ -29,20 +31,10 @@ void UT_VNoteRecordWidget::TearDown()
 
 TEST_F(UT_VNoteRecordWidget, UT_VNoteRecordWidget_startRecord_001)
 {
-    QAudioFormat audioformat;
-    const QByteArray data;
-    audioformat.setCodec("audio/pcm");
-    //通道，采样率
-    audioformat.setChannelCount(2);
-    audioformat.setSampleRate(44100);
-    //lamemp3enc 编码器插件格式为S16LE
-    audioformat.setByteOrder(QAudioFormat::LittleEndian);
-    audioformat.setSampleType(QAudioFormat::UnSignedInt);
-    audioformat.setSampleSize(16);
-    QAudioBuffer buffer(data, audioformat);
+    VNoteAudioLevels levels;
     Stub stub;
     stub.set(ADDR(GstreamRecorder, startRecord), stub_startRecord);
-    m_vnoterecordwidget->onAudioBufferProbed(buffer);
+    m_vnoterecordwidget->onAudioLevelsProbed(levels);
     EXPECT_EQ(m_vnoterecordwidget->m_recordMsec, -1);
     m_vnoterecordwidget->startRecord();
     EXPECT_FALSE(m_vnoterecordwidget->getRecordPath().isEmpty());
@@ -73,3 +65,19 @@ TEST_F(UT_VNoteRecordWidget, UT_VNoteRecordWidget_setAudioDevice_001)
     m_vnoterecordwidget->setAudioDevice("test");
     EXPECT_EQ(m_vnoterecordwidget->m_audioRecoder->m_currentDevice, "test");
 }
+
+TEST_F(UT_VNoteRecordWidget, UT_VNoteRecordWidget_onRecordFinished_001)
+{
+    QSignalSpy finishSpy(m_vnoterecordwidget, &VNoteRecordWidget::sigFinshRecord);
+    QSignalSpy failSpy(m_vnoterecordwidget, &VNoteRecordWidget::sigRecordFailed);
+    m_vnoterecordwidget->m_finishing = true;
+    m_vnoterecordwidget->onRecordFinished("/tmp/20000101000000.mp3", 2000, true);
+    EXPECT_FALSE(m_vnoterecordwidget->m_finishing);
+    EXPECT_EQ(1, finishSpy.count());
+
+    //合并失败时不通知录音完成，没有遗留的会话时不需要恢复
+    m_vnoterecordwidget->onRecordFinished("/tmp/20000101000000.mp3", 2000, false);
+    EXPECT_EQ(1, finishSpy.count());
+    ASSERT_EQ(1, failSpy.count());
+    EXPECT_FALSE(failSpy.first().at(1).toBool());
+}
@@ -0,0 +1,35 @@
+// Copyright (C) 2019 ~ 2020 Uniontech Software Technology Co.,Ltd.
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ut_vnvoicewaveform.h"
+#include "vnvoicewaveform.h"
+
+#include <QTemporaryDir>
+
+UT_VNVoiceWaveform::UT_VNVoiceWaveform()
+{
+}
+
+TEST_F(UT_VNVoiceWaveform, UT_VNVoiceWaveform_loadPeaks_001)
+{
+    QTemporaryDir dir;
+    QString voicePath = dir.path() + "/test.mp3";
+    VNVoiceWaveform waveform;
+    waveform.resize(300, 36);
+    EXPECT_FALSE(waveform.loadPeaks(voicePath));
+    EXPECT_TRUE(waveform.m_bars.isEmpty());
+
+    VNotePeakFile peakFile;
+    peakFile.reset(44100);
+    QVector<qint16> data(44100, 1000);
+    peakFile.appendS16(data.constData(), data.size(), 1);
+    ASSERT_TRUE(peakFile.save(VNotePeakFile::peakPath(voicePath)));
+
+    EXPECT_TRUE(waveform.loadPeaks(voicePath));
+    EXPECT_EQ(300 / (waveform.WAVE_WIDTH + waveform.WAVE_SPACE), waveform.m_bars.size());
+    waveform.setProgress(2);
+    EXPECT_DOUBLE_EQ(1.0, waveform.m_progress);
+    EXPECT_FALSE(waveform.grab().isNull());
+}
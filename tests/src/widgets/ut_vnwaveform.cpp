@@ -10,13 +10,24 @@ UT_VNWaveform::UT_VNWaveform()
 {
 }
 
-TEST_F(UT_VNWaveform, UT_VNWaveform_onAudioBufferProbed_001)
+TEST_F(UT_VNWaveform, UT_VNWaveform_onAudioLevelsProbed_001)
 {
     VNWaveform vnwaveform;
-    QAudioBuffer buffer;
-    buffer.format().setSampleSize(16);
-    vnwaveform.onAudioBufferProbed(buffer);
+    VNoteAudioLevels levels;
+    vnwaveform.onAudioLevelsProbed(levels);
     EXPECT_TRUE(vnwaveform.m_audioScaleSamples.isEmpty());
+
+    levels.count = 3;
+    levels.peak[0] = 0.5f;
+    levels.peak[1] = 1.0f;
+    levels.peak[2] = 0.25f;
+    vnwaveform.m_maxShowedSamples = 4;
+    vnwaveform.onAudioLevelsProbed(levels);
+    vnwaveform.onAudioLevelsProbed(levels);
+    //只保留可以显示的最新峰值
+    ASSERT_EQ(4, vnwaveform.m_audioScaleSamples.size());
+    EXPECT_DOUBLE_EQ(qreal(SHRT_MAX), vnwaveform.m_audioScaleSamples.at(2));
+    EXPECT_DOUBLE_EQ(qreal(SHRT_MAX) / 4, vnwaveform.m_audioScaleSamples.last());
 }
 
 TEST_F(UT_VNWaveform, UT_VNWaveform_paintEvent_001)
@@ -43,51 +54,6 @@ TEST_F(UT_VNWaveform, UT_VNWaveform_resizeEvent_001)
     delete event;
 }
 
-TEST_F(UT_VNWaveform, UT_VNWaveform_getBufferLevels_001)
-{
-    VNWaveform vnwaveform;
-    QAudioFormat audioformat;
-    QVector<qreal> scaleSamples;
-    const QByteArray data;
-    qreal frameGain = 0;
-    audioformat.setCodec("audio/pcm");
-    //通道，采样率
-    audioformat.setChannelCount(2);
-    audioformat.setSampleRate(44100);
-    //lamemp3enc 编码器插件格式为S16LE
-    audioformat.setByteOrder(QAudioFormat::LittleEndian);
-    audioformat.setSampleType(QAudioFormat::UnSignedInt);
-    audioformat.setSampleSize(16);
-    QAudioBuffer buffer(data, audioformat);
-    vnwaveform.getBufferLevels(buffer, scaleSamples, frameGain);
-
-    audioformat.setSampleSize(32);
-    QAudioBuffer buffer1(6, audioformat);
-    vnwaveform.getBufferLevels(buffer1, scaleSamples, frameGain);
-
-    audioformat.setSampleSize(8);
-    QAudioBuffer buffer2(6, audioformat);
-    vnwaveform.getBufferLevels(buffer2, scaleSamples, frameGain);
-
-    audioformat.setSampleType(QAudioFormat::Float);
-    audioformat.setSampleSize(32);
-    QAudioBuffer buffer3(6, audioformat);
-    vnwaveform.getBufferLevels(buffer3, scaleSamples, frameGain);
-
-    audioformat.setSampleType(QAudioFormat::SignedInt);
-    audioformat.setSampleSize(32);
-    QAudioBuffer buffer4(6, audioformat);
-    vnwaveform.getBufferLevels(buffer4, scaleSamples, frameGain);
-
-    audioformat.setSampleSize(16);
-    QAudioBuffer buffer5(6, audioformat);
-    vnwaveform.getBufferLevels(buffer5, scaleSamples, frameGain);
-
-    audioformat.setSampleSize(8);
-    QAudioBuffer buffer6(6, audioformat);
-    vnwaveform.getBufferLevels(buffer6, scaleSamples, frameGain);
-}
-
 TEST_F(UT_VNWaveform, UT_VNWaveform_getPeakValue_001)
 {
     VNWaveform vnwaveform;